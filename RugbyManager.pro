@@ -1,5 +1,5 @@
 
-QT += core gui sql
+QT += core gui sql concurrent
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++11
@@ -14,13 +14,22 @@ HEADERS += aboutwindow.h \
            db/table.h \
            fixtureswidget.h \
            mainwindow.h \
+           match/condition_batch.h \
+           match/engine_counters.h \
            match/gameplay.h \
+           match/gameplay_observer.h \
            match/match.h \
+           match/match_branching.h \
+           match/match_events.h \
            match/matchperiod.h \
            match/matchscore.h \
            match/matchtime.h \
            match/playoff_rules.h \
            match/playoffs.h \
+           match/probability_table.h \
+           match/quick_sim.h \
+           match/quick_sim_calibration.h \
+           match/season_forecast.h \
            match/sinbin.h \
            match/substitution.h \
            matchwidget.h \
@@ -42,14 +51,18 @@ HEADERS += aboutwindow.h \
            settings/config.h \
            settings/matchsettings.h \
            settings/playersettings.h \
+           shared/alias_table.h \
            shared/constants.h \
            shared/datetime.h \
            shared/error.h \
            shared/file.h \
            shared/handle.h \
            shared/html.h \
+           shared/message_template.h \
            shared/messages.h \
            shared/random.h \
+           shared/random_stream.h \
+           shared/refresh_coordinator.h \
            shared/score.h \
            shared/shared_types.h \
            shared/sort.h \
@@ -81,17 +94,22 @@ HEADERS += aboutwindow.h \
            ui/windows/ui_squadswindow.h
 
 SOURCES += aboutwindow.cpp \
+           condition_batch.cpp \
            config.cpp \
            database.cpp \
+           engine_counters.cpp \
            fixtureswidget.cpp \
            gameplay.cpp \
            main.cpp \
            mainwindow.cpp \
            match.cpp \
+           match_branching.cpp \
+           match_events.cpp \
            matchperiod.cpp \
            matchscore.cpp \
            matchtime.cpp \
            matchwidget.cpp \
+           message_template.cpp \
            player.cpp \
            player_attributes.cpp \
            player_condition.cpp \
@@ -104,6 +122,10 @@ SOURCES += aboutwindow.cpp \
            playoffs.cpp \
            position_types.cpp \
            processwindow.cpp \
+           quick_sim.cpp \
+           quick_sim_calibration.cpp \
+           refresh_coordinator.cpp \
+           season_forecast.cpp \
            session.cpp \
            session_save.cpp \
            squadwidget.cpp \
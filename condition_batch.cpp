@@ -0,0 +1,84 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include "match/condition_batch.h"
+#include "player/player_condition.h"
+
+// players beyond capacity are ignored (there are never more than 2 x 15 players on pitch)
+void ConditionBatch::add(Player * const player, const MatchType::Location team) {
+
+    if (this->_size == maxPlayers)
+        return;
+
+    this->_players[this->_size] = player;
+    this->_team[this->_size] = team;
+    ++this->_size;
+
+    return;
+}
+
+void ConditionBatch::decide() {
+
+    for (uint8_t i = 0; i < this->_size; ++i)
+        this->_change[i] = static_cast<uint8_t>(this->_draw[i] <= this->_probability[i]);
+
+    return;
+}
+
+// the better endurance the lower probability of decrease in fatigue
+void ConditionBatch::changeFatigue(RandomStream & random, QVector<Event> & events) {
+
+    for (uint8_t i = 0; i < this->_size; ++i)
+        this->_probability[i] = 72 - this->_players[i]->attribute(player::Attributes::ENDURANCE) * 2;
+
+    random.generateRandomPercentages(this->_draw.data(), this->_size);
+    this->decide();
+
+    for (uint8_t i = 0; i < this->_size; ++i) {
+
+        if (this->_change[i] == 0)
+            continue;
+
+        Player * const player = this->_players[i];
+
+        // if fatigue is at minimum level already, its value isn't decreased; player is declared injured instead
+        if (player->condition(player::Conditions::FATIGUE) == PlayerCondition::minValue) {
+
+            events.append({ player, this->_team[i], Crossing::EXHAUSTED, PlayerCondition::minValue });
+            continue;
+        }
+
+        player->condition()->decreaseCondition(player::Conditions::FATIGUE, 1);
+
+        ConditionThresholds::ConditionValue severity = ConditionThresholds::ConditionValue::NORMAL;
+        const uint8_t fatigueNewValue = player->condition(player::Conditions::FATIGUE, severity);
+
+        if (severity == ConditionThresholds::ConditionValue::CRITICAL)
+            events.append({ player, this->_team[i], Crossing::CRITICAL, fatigueNewValue });
+    }
+
+    return;
+}
+
+void ConditionBatch::changeMorale(RandomStream & random, const bool increase, const uint8_t number) {
+
+    this->_probability.fill(25);
+
+    random.generateRandomPercentages(this->_draw.data(), this->_size);
+    this->decide();
+
+    for (uint8_t i = 0; i < this->_size; ++i) {
+
+        if (this->_change[i] == 0)
+            continue;
+
+        PlayerCondition * const pc = this->_players[i]->condition();
+        pc->changeCondition = (increase) ? &PlayerCondition::increaseCondition : &PlayerCondition::decreaseCondition;
+
+        (pc->*(pc->changeCondition))(player::Conditions::MORALE, number);
+    }
+
+    return;
+}
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QMap>
+#include <QStringBuilder>
+#include "match/engine_counters.h"
+#include "settings/matchsettings.h"
+
+// counters keep running while values are copied => values are consistent only approximately (which is sufficient)
+EngineCounters::Values EngineCounters::values() const {
+
+    Values values;
+
+    for (uint8_t i = 0; i < NO_OF_COUNTERS; ++i)
+        values.counters[i] = _counters[i].load(std::memory_order_relaxed);
+    for (uint16_t i = 0; i < numberOfTypes; ++i) {
+
+        values.actions[i] = _actions[i].load(std::memory_order_relaxed);
+        values.outcomes[i] = _outcomes[i].load(std::memory_order_relaxed);
+    }
+    for (uint8_t i = 0; i < numberOfTimeBuckets; ++i)
+        values.stepTimes[i] = _stepTimes[i].load(std::memory_order_relaxed);
+    values.stepTimeTotal = _stepTimeTotal.load(std::memory_order_relaxed);
+
+    return values;
+}
+
+void EngineCounters::reset() {
+
+    for (auto & counter: _counters)
+        counter.store(0, std::memory_order_relaxed);
+    for (uint16_t i = 0; i < numberOfTypes; ++i) {
+
+        _actions[i].store(0, std::memory_order_relaxed);
+        _outcomes[i].store(0, std::memory_order_relaxed);
+    }
+    for (auto & stepTime: _stepTimes)
+        stepTime.store(0, std::memory_order_relaxed);
+    _stepTimeTotal.store(0, std::memory_order_relaxed);
+
+    return;
+}
+
+QString EngineCounters::asHtml(const Values & values) {
+
+    const QMap<uint8_t, QString> counterNames {
+
+        { MATCHES, QStringLiteral("matches") },
+        { STEPS, QStringLiteral("steps") },
+        { RECEIVER_DRAWS, QStringLiteral("draws of player who takes over ball") },
+        { RECEIVER_NOT_FOUND, QStringLiteral("draws without result (ball stays)") },
+        { SPECIALIST_SELECTIONS, QStringLiteral("selections of specialist") },
+        { SUBSTITUTIONS, QStringLiteral("substitutions") },
+        { INJURY_SUBSTITUTIONS, QStringLiteral("substitutions (injury)") },
+        { PENALTIES, QStringLiteral("penalties") }
+    };
+
+    const QMap<uint8_t, QString> actionNames {
+
+        { static_cast<uint8_t>(MatchActionType::RUNNING), QStringLiteral("running") },
+        { static_cast<uint8_t>(MatchActionType::TACKLING), QStringLiteral("tackling") },
+        { static_cast<uint8_t>(MatchActionType::RUCK), QStringLiteral("ruck") },
+        { static_cast<uint8_t>(MatchActionType::PASSING), QStringLiteral("passing") },
+        { static_cast<uint8_t>(MatchActionType::KICKING), QStringLiteral("kicking") },
+        { static_cast<uint8_t>(MatchActionType::MatchActivityBaseType::SCRUM), QStringLiteral("scrum") },
+        { static_cast<uint8_t>(MatchActionType::MatchActivityBaseType::FOUL_PLAY), QStringLiteral("foul play") }
+    };
+
+    auto row = [](const QString & name, const QString & value) -> QString
+        { return (QStringLiteral("<tr><td>") % name % QStringLiteral("</td><td align=\"right\">") % value % QStringLiteral("</td></tr>")); };
+
+    QString html = QStringLiteral("<table cellspacing=\"0\" cellpadding=\"2\">");
+
+    for (auto it = counterNames.cbegin(); it != counterNames.cend(); ++it)
+        html += row(it.value(), QString::number(values.counters.at(it.key())));
+
+    const uint64_t steps = values.counters.at(STEPS);
+    html += row(QStringLiteral("average time of step"), (steps == 0) ? QStringLiteral("-") :
+                QString(QString::number(values.stepTimeTotal / 1000.0 / steps, 'f', 2) % QStringLiteral(" µs")));
+
+    html += QStringLiteral("<tr><th align=\"left\" colspan=\"2\">Time of step</th></tr>");
+    for (uint8_t i = 0; i < numberOfTimeBuckets; ++i)
+        if (values.stepTimes.at(i) != 0)
+            html += row(((i < numberOfTimeBuckets-1) ? QStringLiteral("&lt; ") : QStringLiteral("&ge; ")) %
+                        QString::number(1ULL << ((i < numberOfTimeBuckets-1) ? i : i-1)) % QStringLiteral(" µs"),
+                        QString::number(values.stepTimes.at(i)));
+
+    html += QStringLiteral("<tr><th align=\"left\" colspan=\"2\">Actions</th></tr>");
+    for (uint16_t i = 0; i < numberOfTypes; ++i)
+        if (values.actions.at(i) != 0)
+            html += row(actionNames.value(i, QStringLiteral("action ") % QString::number(i)), QString::number(values.actions.at(i)));
+
+    // outcomes are listed by their codes (see MatchActionSubtype)
+    html += QStringLiteral("<tr><th align=\"left\" colspan=\"2\">Outcomes</th></tr>");
+    for (uint16_t i = 0; i < numberOfTypes; ++i)
+        if (values.outcomes.at(i) != 0)
+            html += row(QStringLiteral("outcome ") % QString::number(i), QString::number(values.outcomes.at(i)));
+
+    return (html + QStringLiteral("</table>"));
+}
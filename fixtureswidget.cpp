@@ -6,11 +6,14 @@
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QRegularExpression>
+#include <QtConcurrent>
 #include "fixtureswidget.h"
 #include "match/gameplay.h"
 #include "match/playoffs.h"
+#include "match/quick_sim.h"
 #include "shared/handle.h"
 #include "shared/messages.h"
+#include "shared/random_stream.h"
 
 // called from NextMatch mode <=> without ui (when we want to play matches of other teams in the background)
 FixturesWidget::FixturesWidget(DateTime & datetime, Match * nextMatch, MatchType::Type * seasonMatchType,
@@ -18,7 +21,8 @@ FixturesWidget::FixturesWidget(DateTime & datetime, Match * nextMatch, MatchType
                                const QVector<Referee *> & referees):
     ui(nullptr), _myTeam(team), _dateTime(datetime), _fixtures(fixtures), _referees(referees), _nextMatch(nextMatch),
     _settings(settings), _allMatchesMode(false), _matchTypeModeForDisplay(MatchType::Type::UNDEFINED), _competition(nullptr),
-    _seasonMatchType(seasonMatchType), _playUntilAtLeastPeriod(MatchPeriod::TimePeriod::UNDETERMINED) {
+    _seasonMatchType(seasonMatchType), _playUntilAtLeastPeriod(MatchPeriod::TimePeriod::UNDETERMINED), _refresh(nullptr),
+    _matchInPlay(nullptr), _matchdayComplete(false), _matchdayWatcher(new QFutureWatcher<void>(this)) {
 
     this->setObjectName(on::widgets["fixtures_no_ui"]);
 
@@ -35,7 +39,8 @@ FixturesWidget::FixturesWidget(QWidget * parent, const Competition & competition
     QWidget(parent), ui(new Ui_FixturesWidget), _myTeam(team), _dateTime(datetime), _fixtures(fixtures), _teams(teams),
     _referees(referees), _nextMatch(nextMatch), _settings(settings), _allMatchesMode(false),
     _matchTypeModeForDisplay(competition.period()), _competition(&competition), _seasonMatchType(seasonMatchType),
-    _playUntilAtLeastPeriod(MatchPeriod::TimePeriod::UNDETERMINED) {
+    _playUntilAtLeastPeriod(MatchPeriod::TimePeriod::UNDETERMINED), _refresh(new RefreshCoordinator(this)),
+    _matchInPlay(nullptr), _matchdayComplete(false), _matchdayWatcher(new QFutureWatcher<void>(this)) {
 
     this->setObjectName(on::widgets["fixtures"]);
 
@@ -46,6 +51,10 @@ FixturesWidget::FixturesWidget(QWidget * parent, const Competition & competition
     connect(ui->playAllMatchesButton, &QPushButton::clicked, this, &FixturesWidget::playNextMatches);
     connect(ui->playUntilAtLeastShortCut, &QShortcut::activated, this, &FixturesWidget::setPlayUntilAtLeastPeriod);
 
+    // matches of matchday are played on thread pool => their results are passed to ui thread by queued signals
+    connect(this, &FixturesWidget::matchdayMatchPlayed, this, &FixturesWidget::displayResult, Qt::QueuedConnection);
+    connect(this->_matchdayWatcher, &QFutureWatcher<void>::finished, this, &FixturesWidget::matchdayFinished);
+
     connect(this, SIGNAL(timeShift(const bool)), Handle::getMainWindowHandle(),
                   SLOT(progress(const bool)), Qt::ConnectionType::DirectConnection);
     connect(this, SIGNAL(timeChanged()), Handle::getMainWindowHandle(), SLOT(updateDateAndTimeLabel()));
@@ -62,6 +71,18 @@ FixturesWidget::FixturesWidget(QWidget * parent, const Competition & competition
 
 FixturesWidget::~FixturesWidget() {
 
+    // widget is closed while match is in play (main window's buttons are disabled meanwhile) => match stops where it is;
+    // matches of matchday can't be stopped (they use session's teams) => they are waited for and merged without ui
+    // (play-offs are drawn/updated after the next match played)
+    delete this->_matchInPlay;
+
+    if (!this->_matchday.isEmpty()) {
+
+        this->_matchdayWatcher->disconnect(this);
+        this->_matchdayWatcher->waitForFinished();
+        this->mergeMatchday();
+    }
+
     if (ui != nullptr)  { // == not in non-interactive mode
 
         this->updateTime_Rewind();
@@ -69,12 +90,76 @@ FixturesWidget::~FixturesWidget() {
     }
 }
 
+void FixturesWidget::matchStarted() {
+
+    ui->currentMatchProgress->setVisible(true);
+
+    ClickableLabel * label = this->findWidgetByCode<ClickableLabel *>(this->_nextMatch->code(), on::fixtureswidget.scoreSeparator);
+    label->setText(QStringLiteral(" : "));
+    label->repaint();
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        QLabel * label = this->findWidgetByCode<QLabel *>(this->_nextMatch->code(), on::fixtureswidget.teamScore[i]);
+        label->setText(QString::number(0));
+        label->repaint();
+    }
+
+    return;
+}
+
+void FixturesWidget::matchFinished() {
+
+    // final score must be displayed even if the last frame hasn't been applied yet
+    this->_refresh->flush();
+
+    ui->currentMatchProgress->setVisible(false);
+    ui->currentMatchProgress->repaint();
+
+    QLabel * const resultTypeLabel = this->findWidgetByCode<QLabel *>(this->_nextMatch->code(), on::fixtureswidget.resultType);
+    ui->displayResultTypeSuffix(this->_nextMatch, resultTypeLabel);
+    resultTypeLabel->repaint();
+
+    if (this->_nextMatch->type() == MatchType::Type::REGULAR) {
+
+        QLabel * const teamsPointsLabel =
+            this->findWidgetByCode<QLabel *>(this->_nextMatch->code(), on::fixtureswidget.pointsFromGame);
+        ui->displayTeamsPoints(this->_nextMatch, teamsPointsLabel);
+        teamsPointsLabel->repaint();
+    }
+
+    return;
+}
+
+void FixturesWidget::timeRefreshed(const QString &, const uint16_t secondsPlayed, const bool) {
+
+    QProgressBar * const progress = ui->currentMatchProgress;
+    this->_refresh->schedule(progress, [progress, secondsPlayed]() { progress->setValue(secondsPlayed); });
+
+    return;
+}
+
+void FixturesWidget::resetMatchProgress(const MatchPeriods * const periods, const MatchPeriod::TimePeriod period, const bool) {
+
+    QProgressBar * const progress = ui->currentMatchProgress;
+    if (progress->maximum() != periods->maximumValue(period)) {
+
+        // reset progress bar (pending change of value belongs to previous period)
+        this->_refresh->schedule(progress, [progress]() { progress->setValue(0); });
+        progress->setMaximum(periods->maximumValue(period));
+        progress->setStyleSheet(ss::shared.style(periods->style(period)));
+    }
+
+    return;
+}
+
 void FixturesWidget::updateScore(const MatchType::Location team) {
 
     const QString score = on::fixtureswidget.teamScore[static_cast<uint8_t>(team)];
-    QLabel * scoreLabel = this->findWidgetByCode<QLabel *>(this->_nextMatch->code(), score);
-    scoreLabel->setText(QString::number(this->_nextMatch->score(team)->points()));
-    scoreLabel->repaint();
+    QLabel * const scoreLabel = this->findWidgetByCode<QLabel *>(this->_nextMatch->code(), score);
+    const QString points = QString::number(this->_nextMatch->score(team)->points());
+
+    this->_refresh->schedule(scoreLabel, [scoreLabel, points]() { scoreLabel->setText(points); });
 
     return;
 }
@@ -113,11 +198,17 @@ bool FixturesWidget::hasPartOfSeasonFinished(const MatchType::Type period) const
 }
 
 // [slot]
-// can be called either from signal (QPushButton::clicked) or from this->playNextMatches() function
+// can be called either from signal (QPushButton::clicked) or from this->playNextMatchday() function
 // or from MainWindow (when playing other teams' matches in the background) <=> in nonInteractiveMode
-// return value: true if match was played and next match was found; false otherwise
+// return value (nonInteractiveMode): true if match was played and next match was found; false otherwise
+// return value (interactive mode): true if match was started (it's played step by step, matchInPlayStopped() takes over
+// when it's over); false otherwise
 bool FixturesWidget::playNextMatch(const bool nonInteractiveMode) {
 
+    // another match is still in play (buttons are disabled meanwhile)
+    if (this->matchesInPlay())
+        return false;
+
     // if no matches remaining
     // note: skipped for nonInteractive (nonInt) mode; if last match involves my team it wouldn't be played in nonInt
     // mode ever; if last match doesn't involve my team it wouldn't be played in nonInt mode in case there's no match
@@ -147,29 +238,116 @@ bool FixturesWidget::playNextMatch(const bool nonInteractiveMode) {
             return false;
     }
 
+    // referee and squads of both teams
+    if (!this->prepareMatch(this->_nextMatch, nonInteractiveMode))
+        return false;
+
+    // update system date/time
+    this->_dateTime.refreshSystemDateAndTime(this->_nextMatch->date(), this->_nextMatch->time());
+    emit timeChanged();
+
+    // play match (in non-interactive mode without any observer <=> headless); full engine (GamePlay) is created only
+    // if it's going to be used; in interactive mode match runs step by step (one step per timer tick) => control returns
+    // to event loop right away and ui stays responsive; fixture flow continues when match stops (see matchInPlayStopped)
+    if (!nonInteractiveMode) {
+
+        this->_matchInPlay = new GamePlay(_settings, _dateTime, this->_nextMatch, nullptr, this);
+        ui->currentMatchProgress = this->findWidgetByCode<QProgressBar *>(this->_nextMatch->code(), on::fixtureswidget.matchProgress);
+        connect(this->_matchInPlay, &GamePlay::stopped, this, &FixturesWidget::matchInPlayStopped);
+
+        if (!this->_matchInPlay->start()) {
+
+            delete this->_matchInPlay;
+            this->_matchInPlay = nullptr;
+            return false;
+        }
+
+        this->setPlayInProgress(true);
+        return true;
+    }
+    else if (QuickSim::engine(this->_nextMatch, this->_myTeam) == QuickSim::Engine::QUICK_SIM) {
+
+        QuickSim quickSim(_dateTime, this->_nextMatch, QuickSim::backgroundModel());
+        quickSim.playMatch();
+    }
+    else {
+
+        GamePlay play(_settings, _dateTime, this->_nextMatch, nullptr, nullptr);
+        play.playMatch();
+    }
+
+    emit timeChanged();
+
+    return this->matchPlayed(nonInteractiveMode);
+}
+
+// what follows a match (played either at once or step by step): winner of play-offs' match, next match and play-offs
+// return value: true if next match was found
+bool FixturesWidget::matchPlayed(const bool nonInteractiveMode) {
+
+    if (!nonInteractiveMode)
+        this->displayPlayoffsWinner(this->_nextMatch);
+
+    // find (new) next match
+    const bool next = this->findNextMatch();
+
+    // draw/update play-offs
+    this->updatePlayoffs(nonInteractiveMode);
+
+    return next;
+}
+
+void FixturesWidget::displayPlayoffsWinner(Match * const match) {
+
+    if (match->type() == MatchType::Type::PLAYOFFS && match->winner() != nullptr) {
+
+        const bool hostsWon = (match->winner() == match->team(MatchType::Location::HOSTS));
+        const QString objectNamePrefix = on::fixtureswidget.teamName[static_cast<uint8_t>(!hostsWon)];
+        QLabel * const teamNameLabel = this->findWidgetByCode<QLabel *>(match->code(), objectNamePrefix);
+        teamNameLabel->setStyleSheet(teamNameLabel->styleSheet() + cc::shared.colour(ss::fixtureswidget.winningTeamColour, cc::colourArea::FONT));
+
+        if (!match->shootOutResult().isNull()) {
+
+            ClickableLabel * const scoreSeparator =
+                this->findWidgetByCode<ClickableLabel *>(match->code(), on::fixtureswidget.scoreSeparator);
+            if (scoreSeparator != nullptr)
+                scoreSeparator->setToolTip(match->shootOutResult());
+        }
+    }
+
+    return;
+}
+
+// draws referee (if not assigned yet) and selects squads of both teams; both are drawn from match's own preparation stream
+// (derived from master seed and match's code) => the same save and seed give the same squads and referee
+// return value: false if squad selection for one or the other team failed (match can't be played)
+bool FixturesWidget::prepareMatch(Match * const match, const bool nonInteractiveMode) {
+
+    RandomStream preparation = RandomStream::forPreparationOf(match->code());
+
     // if referee is not assigned draw someone from pool of referees
-    if (_nextMatch->refereeNotAssigned()) {
+    if (match->refereeNotAssigned()) {
 
         QVector<Referee *> excludedReferees;
         for (auto fixture: *_fixtures)
-            if (fixture->date() == _nextMatch->date() && !fixture->refereeNotAssigned())
+            if (fixture->date() == match->date() && !fixture->refereeNotAssigned())
                 excludedReferees.push_back(fixture->referee());
-        _nextMatch->assignReferee(_nextMatch->drawReferee(_referees, excludedReferees));
+        match->assignReferee(match->drawReferee(_referees, excludedReferees, preparation));
 
-        if (!nonInteractiveMode && !_nextMatch->refereeNotAssigned()) {
+        if (!nonInteractiveMode && !match->refereeNotAssigned()) {
 
-            QLabel * const refereeLabel = this->findWidgetByCode<QLabel *>(this->_nextMatch->code(), on::fixtureswidget.referee);
-            refereeLabel->setText(_nextMatch->referee()->referee());
+            QLabel * const refereeLabel = this->findWidgetByCode<QLabel *>(match->code(), on::fixtureswidget.referee);
+            refereeLabel->setText(match->referee()->referee());
             refereeLabel->repaint();
         }
     }
 
     // select squads of both teams
     // if my team is involved than force automatic selection only if current selection isn't complete
-    Team * const hosts = this->_nextMatch->team(MatchType::Location::HOSTS);
+    Team * const hosts = match->team(MatchType::Location::HOSTS);
     if ((hosts == this->_myTeam && !hosts->areAllPlayersSelected()) || hosts != this->_myTeam) {
 
-        const bool selectionComplete = hosts->selectPlayersForNextMatch(this->_settings->playerConditions());
+        const bool selectionComplete = hosts->selectPlayersForNextMatch(this->_settings->playerConditions(), &preparation);
         if (!selectionComplete) {
 
             QMessageBox::information(this, hosts->name() + QStringLiteral(" (hosts)"),
@@ -178,10 +356,10 @@ bool FixturesWidget::playNextMatch(const bool nonInteractiveMode) {
         }
         hosts->selectSubstitutes(this->_settings->playerConditions());
     }
-    Team * const visitors = _nextMatch->team(MatchType::Location::VISITORS);
+    Team * const visitors = match->team(MatchType::Location::VISITORS);
     if ((visitors == this->_myTeam && !visitors->areAllPlayersSelected()) || visitors != this->_myTeam) {
 
-        const bool selectionComplete = visitors->selectPlayersForNextMatch(this->_settings->playerConditions());
+        const bool selectionComplete = visitors->selectPlayersForNextMatch(this->_settings->playerConditions(), &preparation);
         if (!selectionComplete) {
 
             QMessageBox::information(this, visitors->name() + QStringLiteral(" (visitors)"),
@@ -191,35 +369,12 @@ bool FixturesWidget::playNextMatch(const bool nonInteractiveMode) {
         visitors->selectSubstitutes(this->_settings->playerConditions());
     }
 
-    // update system date/time
-    this->_dateTime.refreshSystemDateAndTime(this->_nextMatch->date(), this->_nextMatch->time());
-    emit timeChanged();
-
-    // play match
-    FixturesWidget * thisWidget = (nonInteractiveMode) ? nullptr : this;
-    GamePlay * play = new GamePlay(thisWidget, _settings, _dateTime, this->_nextMatch);
-    if (!nonInteractiveMode)
-        ui->currentMatchProgress = this->findWidgetByCode<QProgressBar *>(this->_nextMatch->code(), on::fixtureswidget.matchProgress);
-    play->playMatch();
-
-    if (!nonInteractiveMode && this->_nextMatch->type() == MatchType::Type::PLAYOFFS && this->_nextMatch->winner() != nullptr) {
-
-        const bool hostsWon = (this->_nextMatch->winner() == this->_nextMatch->team(MatchType::Location::HOSTS));
-        const QString objectNamePrefix = on::fixtureswidget.teamName[static_cast<uint8_t>(!hostsWon)];
-        QLabel * const teamNameLabel = this->findWidgetByCode<QLabel *>(this->_nextMatch->code(), objectNamePrefix);
-        teamNameLabel->setStyleSheet(teamNameLabel->styleSheet() + cc::shared.colour(ss::fixtureswidget.winningTeamColour, cc::colourArea::FONT));
+    return true;
+}
 
-        if (!this->_nextMatch->shootOutResult().isNull()) {
+// return value: true if next match was found
+bool FixturesWidget::findNextMatch() {
 
-            ClickableLabel * const scoreSeparator =
-                this->findWidgetByCode<ClickableLabel *>(this->_nextMatch->code(), on::fixtureswidget.scoreSeparator);
-            if (scoreSeparator != nullptr)
-                scoreSeparator->setToolTip(this->_nextMatch->shootOutResult());
-        }
-    }
-    delete play;
-
-    // find (new) next match
     bool next = false;
     for (const auto & match: *this->_fixtures) {
 
@@ -230,7 +385,12 @@ bool FixturesWidget::playNextMatch(const bool nonInteractiveMode) {
         }
     }
 
-    // draw/update play-offs
+    return next;
+}
+
+// draw/update play-offs (after match(es) played)
+void FixturesWidget::updatePlayoffs(const bool nonInteractiveMode) {
+
     const bool playOffsInProgress = *(this->_seasonMatchType) == MatchType::Type::PLAYOFFS;
     if (playOffsInProgress || (!nonInteractiveMode && this->_competition->hasPlayoffs())) {
 
@@ -261,7 +421,139 @@ bool FixturesWidget::playNextMatch(const bool nonInteractiveMode) {
         delete playoffs;
     }
 
-    return next;
+    return;
+}
+
+// next match and fixtures right after it which kick off on the same day, are of the same type and don't share any team
+// (nor involve my team) => results of such matches don't depend on one another so they can be played simultaneously
+QVector<Match *> FixturesWidget::matchesToBePlayedConcurrently() const {
+
+    QVector<Match *> matches;
+    QVector<Team *> teamsInPlay;
+
+    for (auto it = std::find(_fixtures->cbegin(), _fixtures->cend(), this->_nextMatch); it != _fixtures->cend(); ++it) {
+
+        Match * const match = (*it);
+        Team * const hosts = match->team(MatchType::Location::HOSTS);
+        Team * const visitors = match->team(MatchType::Location::VISITORS);
+
+        // note: teams of next play-offs' rounds are not known until current round is finished (== nullptr)
+        if (match->date() != this->_nextMatch->date() || match->type() != this->_nextMatch->type() ||
+            hosts == nullptr || visitors == nullptr || match->isTeamInPlay(this->_myTeam) ||
+            teamsInPlay.contains(hosts) || teamsInPlay.contains(visitors))
+            break;
+
+        matches.push_back(match);
+        teamsInPlay << hosts << visitors;
+    }
+    return matches;
+}
+
+// called from MainWindow (when playing other teams' matches in the background) instead of playNextMatch(true) and from
+// this->playNextMatchesStep() ("play all matches" mode) instead of playNextMatch()
+// all matches of next matchday which can be played simultaneously (see matchesToBePlayedConcurrently) are played
+// headless on a thread pool; everything else (referees, squads, date/time, play-offs) is done on the calling thread
+// in order of fixtures => results are merged the same way regardless of which match finishes first
+// return value (nonInteractiveMode): same as playNextMatch(true)
+// return value (interactive mode): same as playNextMatch() <=> true if match(es) were started (matchdayFinished() takes
+// over when all matches of matchday are over; the calling thread doesn't wait for them)
+bool FixturesWidget::playNextMatchday(const bool nonInteractiveMode) {
+
+    // another match (or matchday) is still in play (buttons are disabled meanwhile)
+    if (this->matchesInPlay())
+        return false;
+
+    if (nonInteractiveMode && _nextMatch == nullptr)
+        return false;
+
+    const bool nextMatchCanBePlayed =
+        (_nextMatch != nullptr && (nonInteractiveMode || _nextMatch->type() == this->_matchTypeModeForDisplay));
+    const QVector<Match *> matchday = (nextMatchCanBePlayed) ? this->matchesToBePlayedConcurrently() : QVector<Match *>();
+
+    // nothing to be played simultaneously (or next match involves my team)
+    if (matchday.size() < 2)
+        return this->playNextMatch(nonInteractiveMode);
+
+    // update players' feature values which can change over time
+    this->updateTime_Rewind();
+    emit timeShift(_allMatchesMode);
+
+    // every match is played with its own copy of system date/time (starting at match's kick-off)
+    for (auto match: matchday) {
+
+        // squad selection failed => matches prepared so far are played, next match stays unplayed (as in playNextMatch)
+        if (!this->prepareMatch(match, nonInteractiveMode))
+            break;
+
+        MatchdayMatch matchdayMatch { match, this->_dateTime };
+        matchdayMatch.dateTime.refreshSystemDateAndTime(match->date(), match->time());
+        this->_matchday.push_back(matchdayMatch);
+    }
+    if (this->_matchday.isEmpty())
+        return false;
+
+    this->_matchdayComplete = (this->_matchday.size() == matchday.size());
+
+    // every match reports its result by a signal as soon as it's over (queued to ui thread, see displayResult)
+    this->_matchdayWatcher->setFuture(QtConcurrent::map(this->_matchday, [this](MatchdayMatch & matchdayMatch) {
+
+        if (QuickSim::engine(matchdayMatch.match, this->_myTeam) == QuickSim::Engine::QUICK_SIM) {
+
+            QuickSim quickSim(matchdayMatch.dateTime, matchdayMatch.match, QuickSim::backgroundModel());
+            quickSim.playMatch();
+        }
+        else {
+
+            GamePlay play(this->_settings, matchdayMatch.dateTime, matchdayMatch.match, nullptr, nullptr);
+            play.playMatch();
+        }
+
+        emit matchdayMatchPlayed(matchdayMatch.match->code());
+    }));
+
+    if (!nonInteractiveMode) {
+
+        this->setPlayInProgress(true);
+        return true;
+    }
+
+    this->_matchdayWatcher->waitForFinished();
+    return this->matchdayPlayed(true);
+}
+
+// what follows matches of matchday (after all of them are over): date/time, next match and play-offs
+// return value: same as playNextMatch(true)
+bool FixturesWidget::matchdayPlayed(const bool nonInteractiveMode) {
+
+    const bool complete = this->_matchdayComplete;
+
+    // find (new) next match
+    const bool next = this->mergeMatchday();
+    emit timeChanged();
+
+    // draw/update play-offs
+    this->updatePlayoffs(nonInteractiveMode);
+
+    return (next && complete);
+}
+
+// system date/time (= end of match which finished last) and (new) next match; matchday is over afterwards
+// return value: true if next match was found
+bool FixturesWidget::mergeMatchday() {
+
+    QDateTime endOfMatchday;
+    for (const auto & matchdayMatch: this->_matchday) {
+
+        const QDateTime endOfMatch(matchdayMatch.dateTime.systemDate(), matchdayMatch.dateTime.systemTime());
+        if (!endOfMatchday.isValid() || endOfMatch > endOfMatchday)
+            endOfMatchday = endOfMatch;
+    }
+    this->_dateTime.refreshSystemDateAndTime(endOfMatchday.date(), endOfMatchday.time());
+
+    this->_nextMatch = this->_matchday.last().match;
+    this->_matchday.clear();
+
+    return this->findNextMatch();
 }
 
 // [slot]
@@ -289,9 +581,101 @@ void FixturesWidget::switchFixtureTypeMode() {
 // [slot]
 void FixturesWidget::playNextMatches() {
 
+    if (this->matchesInPlay())
+        return;
+
     _allMatchesMode = true;
-    while (this->playNextMatch());
+    this->playNextMatchesStep();
+
+    return;
+}
+
+// [slot] next matchday of "play all matches" mode (matches which can be played simultaneously are played on thread
+// pool, any other match on its own step by step); the next one is started from continuePlay() after this one is over
+void FixturesWidget::playNextMatchesStep() {
+
+    if (!this->playNextMatchday(false))
+        this->continuePlay(false);
+
+    return;
+}
+
+// [slot]
+void FixturesWidget::matchInPlayStopped() {
+
+    // slot is called from the match's own signal => match is deleted once control returns to event loop
+    this->_matchInPlay->deleteLater();
+    this->_matchInPlay = nullptr;
+
+    this->continuePlay(this->matchPlayed(false));
+
+    return;
+}
+
+// [slot] all matches of matchday are over (watcher's signal is delivered in ui thread)
+void FixturesWidget::matchdayFinished() {
+
+    this->continuePlay(this->matchdayPlayed(false));
+
+    return;
+}
+
+// [slot] match of matchday played on thread pool (headless) is over => its row is filled in with final result
+void FixturesWidget::displayResult(const uint16_t code) {
+
+    typedef Match * const cpMatch;
+    cpMatch * const match = std::find_if(_fixtures->cbegin(), _fixtures->cend(),
+                                         [& code](Match * const m) -> bool { return m->code() == code; });
+
+    this->findWidgetByCode<ClickableLabel *>(code, on::fixtureswidget.scoreSeparator)->setText(QStringLiteral(" : "));
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location team = static_cast<MatchType::Location>(i);
+        QLabel * const scoreLabel = this->findWidgetByCode<QLabel *>(code, on::fixtureswidget.teamScore[i]);
+        scoreLabel->setText(QString::number((*match)->score(team)->points()));
+    }
+
+    QLabel * const resultTypeLabel = this->findWidgetByCode<QLabel *>(code, on::fixtureswidget.resultType);
+    ui->displayResultTypeSuffix(*match, resultTypeLabel);
+
+    if ((*match)->type() == MatchType::Type::REGULAR) {
+
+        QLabel * const teamsPointsLabel = this->findWidgetByCode<QLabel *>(code, on::fixtureswidget.pointsFromGame);
+        ui->displayTeamsPoints(*match, teamsPointsLabel);
+    }
+
+    this->displayPlayoffsWinner(*match);
+
+    return;
+}
+
+// in "play all matches" mode next match is started by a queued call => control returns to event loop first (nothing
+// is nested and nothing waits); otherwise (or if there's no next match) play is over and buttons are enabled again
+void FixturesWidget::continuePlay(const bool next) {
+
+    if (_allMatchesMode && next) {
+
+        QMetaObject::invokeMethod(this, "playNextMatchesStep", Qt::QueuedConnection);
+        return;
+    }
+
     _allMatchesMode = false;
+    this->setPlayInProgress(false);
+
+    return;
+}
+
+// buttons of this widget (and of main window, see MainWindow::fixtures) are disabled while matches are in play
+// => widget can't be replaced (deleted) and another match can't be started meanwhile; play can only be started with
+// these buttons enabled => they are simply enabled again afterwards
+void FixturesWidget::setPlayInProgress(const bool inProgress) {
+
+    ui->playNextMatchButton->setEnabled(!inProgress);
+    ui->playAllMatchesButton->setEnabled(!inProgress);
+    ui->switchFixtureTypeButton->setEnabled(!inProgress);
+
+    emit playInProgress(inProgress);
 
     return;
 }
@@ -6,16 +6,21 @@ This program is distributed under the terms of the GNU General Public License.
 #ifndef FIXTURESWIDGET_H
 #define FIXTURESWIDGET_H
 
+#include <QFutureWatcher>
 #include <QString>
 #include <QVector>
 #include <QWidget>
 #include "competition.h"
+#include "match/gameplay_observer.h"
 #include "match/match.h"
 #include "settings/config.h"
 #include "shared/datetime.h"
+#include "shared/refresh_coordinator.h"
 #include "ui/widgets/ui_fixtureswidget.h"
 
-class FixturesWidget: public QWidget {
+class GamePlay;
+
+class FixturesWidget: public QWidget, public GamePlayObserver {
 
     Q_OBJECT
 
@@ -53,8 +58,18 @@ class FixturesWidget: public QWidget {
             return widget;
         };
 
-        inline MatchPeriod::TimePeriod playUntilAtLeastPeriod() const { return _playUntilAtLeastPeriod; }
-        void updateScore(const MatchType::Location);
+        // GamePlayObserver
+        inline MatchDisplay::Type display() const override { return MatchDisplay::PROGRESS; }
+        inline void dateTimeChanged() override { emit timeChanged(); return; }
+        inline MatchPeriod::TimePeriod playUntilAtLeastPeriod() const override { return _playUntilAtLeastPeriod; }
+
+        void matchStarted() override;
+        void matchFinished() override;
+        void timeRefreshed(const QString &, const uint16_t, const bool = true) override;
+        void resetMatchProgress(const MatchPeriods * const, const MatchPeriod::TimePeriod, const bool = true) override;
+        void updateScore(const MatchType::Location) override;
+
+        bool playNextMatchday(const bool = true);
 
         Ui_FixturesWidget * ui;
 
@@ -62,8 +77,28 @@ class FixturesWidget: public QWidget {
         void updateTime_Rewind();
         void updateTeamNames(QVector<Match *>::iterator);
 
+        bool prepareMatch(Match * const, const bool);
+        bool matchPlayed(const bool);
+        bool matchdayPlayed(const bool);
+        bool mergeMatchday();
+        bool findNextMatch();
+        void updatePlayoffs(const bool);
+        void displayPlayoffsWinner(Match * const);
+        QVector<Match *> matchesToBePlayedConcurrently() const;
+
         bool hasPartOfSeasonFinished(const MatchType::Type = MatchType::Type::REGULAR) const;
 
+        inline bool matchesInPlay() const { return (_matchInPlay != nullptr || !_matchday.isEmpty()); }
+        void setPlayInProgress(const bool);
+        void continuePlay(const bool);
+
+        // match of matchday played simultaneously with others (with its own copy of system date/time)
+        struct MatchdayMatch {
+
+            Match * match;
+            DateTime dateTime;
+        };
+
         Team * _myTeam;
         DateTime & _dateTime;
 
@@ -82,9 +117,18 @@ class FixturesWidget: public QWidget {
 
         MatchPeriod::TimePeriod _playUntilAtLeastPeriod; // used for testing extra-time (and beyond) periods' progress
 
+        RefreshCoordinator * _refresh;                   // nullptr in non-interactive mode
+        GamePlay * _matchInPlay;                         // match played step by step (interactive mode only)
+
+        QVector<MatchdayMatch> _matchday;                // matches of matchday in play (on thread pool)
+        bool _matchdayComplete;                          // all matches of matchday were prepared (squads selected)
+        QFutureWatcher<void> * _matchdayWatcher;
+
     signals:
         void timeShift(const bool = false);
         void timeChanged();
+        void playInProgress(const bool);
+        void matchdayMatchPlayed(const uint16_t);
 
     public slots:
         bool playNextMatch(const bool = false);
@@ -92,6 +136,10 @@ class FixturesWidget: public QWidget {
     private slots:
         void switchFixtureTypeMode();
         void playNextMatches();
+        void playNextMatchesStep();
+        void matchInPlayStopped();
+        void matchdayFinished();
+        void displayResult(const uint16_t);
         void setPlayUntilAtLeastPeriod();
         void displayPeriodDurations();
 };
@@ -3,24 +3,29 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
-#include <QInputDialog>
-#include <QMessageBox>
+#include <QDataStream>
+#include <QFile>
 #include <QStringBuilder>
-#include <QThread>
+#include <QTimer>
 #include <array>
-#include "fixtureswidget.h"
-#include "matchwidget.h"
+#include "match/condition_batch.h"
+#include "match/engine_counters.h"
 #include "match/gameplay.h"
 #include "match/match.h"
+#include "match/match_events.h"
+#include "match/probability_table.h"
 #include "player/position_types.h"
 #include "settings/matchsettings.h"
 #include "shared/constants.h"
-#include "shared/handle.h"
 #include "shared/html.h"
+#include "shared/message_template.h"
 #include "shared/messages.h"
-#include "shared/random.h"
+#include "shared/random_stream.h"
 #include "shared/texts.h"
-#include "ui/custom/ui_inputdialog.h"
+
+const QString GamePlay::snapshotFileName = QStringLiteral("match_snapshot.dat");
+// identifier of current game (see Session::bindMatchSnapshotToGame) => snapshot left over from another game isn't restored
+uint64_t GamePlay::sessionId = 0;
 
 const QString GamePlay::_penaltyInfringement = QStringLiteral("/penaltyInfringement");
 const QString GamePlay::_penaltySelectedType = QStringLiteral("/penaltySelectedType");
@@ -36,28 +41,73 @@ const QMap<GamePlay::PenaltyAction, QString> GamePlay::actionAfterPenaltyInfring
     { GamePlay::PenaltyAction::TAP_PENALTY, QStringLiteral("tap penalty") }
 };
 
-template <typename T>
-GamePlay::GamePlay(T * widget, Settings * const settings , DateTime & dateTime, Match * const match, Team * const myTeam):
-    _periods(new MatchPeriods()), _settings(settings), _dateTime(dateTime), _automaticSelection(false),
-    _hostsFirstKickOff(false), _restartPlay(false), _incrementCarries(true), _distanceFromHalfwayLine(0),
-    _noOfPhases(0), _match(match), _myTeam(myTeam), _teamInPossession(nullptr), _playerInPossession(nullptr) {
+// observer == nullptr => match is played headless (non-interactive mode)
+GamePlay::GamePlay(Settings * const settings, DateTime & dateTime, Match * const match, Team * const myTeam,
+                   GamePlayObserver * const observer):
+    _periods(new MatchPeriods()), _settings(settings), _dateTime(dateTime), _observer(observer), _display(MatchDisplay::NONE),
+    _automaticSelection(false), _hostsFirstKickOff(false), _restartPlay(false), _incrementCarries(true), _distanceFromHalfwayLine(0),
+    _noOfPhases(0), _match(match), _myTeam(myTeam), _teamInPossession(nullptr), _playerInPossession(nullptr),
+    _random(RandomStream::forCode(match->code())), _timer(new QTimer(this)), _isOffload(false) {
 
     this->setObjectName("GamePlayObject");
+    this->attachObserver(observer);
 
-    // if called in non-interactive mode, both are assigned nullptr
-    _mw = dynamic_cast<MatchWidget *>(widget);
-    _fw = dynamic_cast<FixturesWidget *>(widget);
-
-    if (this->displayOn(FW))
-        _periods->changeDoNotStopAtPeriodTo(_fw->playUntilAtLeastPeriod());
+    this->_timer->setSingleShot(true);
+    connect(this->_timer, &QTimer::timeout, this, &GamePlay::nextStep);
 
-    connect(this, SIGNAL(timeChanged()), Handle::getMainWindowHandle(), SLOT(updateDateAndTimeLabel()));
+    if (this->displayOn(MatchDisplay::PROGRESS))
+        _periods->changeDoNotStopAtPeriodTo(_observer->playUntilAtLeastPeriod());
 
     html_functions.dummyCallToSuppressCompilerWarning();
 }
 
+// display target is resolved once (when observer is attached) => every check is a comparison of one member
+// (no virtual call to observer and no test of observer itself: display other than NONE implies an observer)
+// note: this is a runtime check, not a compile-time display policy: display target of one match changes while it's
+// in play (finish() detaches observer and plays the rest headless, then attaches it back) and GamePlay is a QObject
+// (moc can't process class templates) => policy as template parameter would mean two engines and a switch between
+// them in the middle of a match
+bool GamePlay::displayOn(const MatchDisplay::Type display) const {
+
+    return (this->_display == display);
+}
+
+void GamePlay::attachObserver(GamePlayObserver * const observer) {
+
+    this->_observer = observer;
+    this->_display = (observer != nullptr) ? observer->display() : MatchDisplay::NONE;
+
+    return;
+}
+
+// headless match or logging switched off => nothing is formatted
+bool GamePlay::logOn() const {
+
+    return (this->displayOn(MatchDisplay::DETAIL) && this->_settings->logging() != LogLevel::NONE);
+}
+
+// log row is formatted into the same buffer every time (its capacity is kept between calls)
+void GamePlay::logMessage(const QString & group, const QString & key, const QStringList & insertedTexts) const {
+
+    this->_logBuffer.resize(0);
+    MessageTemplate::find(group, key).appendTo(this->_logBuffer, insertedTexts);
+    _observer->logRecord(this->_logBuffer);
+
+    return;
+}
+
+void GamePlay::dateTimeChanged() const {
+
+    if (this->_observer != nullptr)
+        this->_observer->dateTimeChanged();
+
+    return;
+}
+
 void GamePlay::startOfMatch() {
 
+    EngineCounters::instance().increment(EngineCounters::MATCHES);
+
     // set players No. 1-15 of both teams as being on pitch
     for (uint8_t i = 0; i < 2; ++i) {
 
@@ -71,17 +121,33 @@ void GamePlay::startOfMatch() {
                 this->updateStatistics(loc, StatsType::NumberOf::GAMES_PLAYED, player);
             }
         }
+        this->_match->team(loc)->lineupChanged();
+        this->buildBench(loc);
     }
 
-    if (this->displayOn(MW))
-        _mw->updatePackWeight();
-    }
+    this->_probabilities.build(this->_match->team(MatchType::Location::HOSTS)->ranking(),
+                               this->_match->team(MatchType::Location::VISITORS)->ranking());
+
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updatePackWeight();
+
+    return;
+}
 
 void GamePlay::endOfMatch() {
 
     for (uint8_t i = 0; i < 2; ++i) {
 
         const MatchType::Location loc = static_cast<MatchType::Location>(i);
+
+        // values accumulated during whole match are recorded only once (as totals)
+        for (auto player: this->_match->team(loc)->squad())
+            if (this->_match->playerStats(loc, player) != nullptr)
+                this->recordEvent(MatchEvent::Type::MINUTES_PLAYED, loc, player,
+                                  this->_match->playerStats(loc, player)->getStatsValue(StatsType::NumberOf::MINS_PLAYED));
+        this->recordEvent(MatchEvent::Type::POSSESSION, loc, nullptr, this->_match->score(loc)->possession());
+        this->recordEvent(MatchEvent::Type::TERRITORY, loc, nullptr, this->_match->score(loc)->territory());
+
         this->_match->team(loc)->cleanPitch();
 
         if (this->_match->type() == MatchType::Type::REGULAR) {
@@ -115,8 +181,12 @@ bool GamePlay::refreshTime(const uint8_t seconds, const bool changeTimePeriod, c
         (_distanceFromHalfwayLine < 0) ? MatchType::Location::VISITORS : MatchType::Location::HOSTS;
     const bool teamInPossesionInOwnHalf = (this->_match->team(teamInTerritory) != _teamInPossession);
 
-    const double teamInPossessionRatio_orig = this->_match->calculatePossessionTimeRatio(this->whoIsInPossession().first, 0);
-    const double teamInTerritoryRatio_orig = std::abs(100 * static_cast<uint8_t>(teamInPossesionInOwnHalf)
+    // ratios before time is added are needed only for extended log (ratios after time is added must be calculated always
+    // because the same calls add the time to possession and territory of teams)
+    const bool extendedLog = this->displayOn(MatchDisplay::DETAIL) && _observer->extendedLog();
+    const double teamInPossessionRatio_orig = (!extendedLog) ? 0.0 :
+        this->_match->calculatePossessionTimeRatio(this->whoIsInPossession().first, 0);
+    const double teamInTerritoryRatio_orig = (!extendedLog) ? 0.0 : std::abs(100 * static_cast<uint8_t>(teamInPossesionInOwnHalf)
                                            - this->_match->calculateTerritoryTimeRatio(teamInTerritory, 0));
 
     this->_match->timePlayed().addTime(seconds);
@@ -125,43 +195,31 @@ bool GamePlay::refreshTime(const uint8_t seconds, const bool changeTimePeriod, c
     const double teamInTerritoryRatio = std::abs(100 * static_cast<uint8_t>(teamInPossesionInOwnHalf)
                                       - this->_match->calculateTerritoryTimeRatio(teamInTerritory, seconds));
 
-    if (this->displayOn(MW)) {
+    if (this->_observer != nullptr)
+        _observer->timeRefreshed(this->_match->timePlayed().timePlayed(),
+                                 this->_match->timePlayed().timePlayedInSecondsInPeriod(), immediateRepaint);
 
-        _mw->ui->timePlayedLabel->setText(this->_match->timePlayed().timePlayed());
-        _mw->ui->matchProgressProgressBar->setValue(this->_match->timePlayed().timePlayedInSecondsInPeriod());
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updateStatisticsUI(this->whoIsInPossession().first, "PossessionLabel",
-                                string_functions.formatNumber<double>(teamInPossessionRatio));
-        _mw->updateStatisticsUI(this->whoIsInPossession().second, "PossessionLabel",
-                                string_functions.formatNumber<double>(100 - teamInPossessionRatio));
+        _observer->updateStatisticsUI(this->whoIsInPossession().first, "PossessionLabel",
+                                      string_functions.formatNumber<double>(teamInPossessionRatio));
+        _observer->updateStatisticsUI(this->whoIsInPossession().second, "PossessionLabel",
+                                      string_functions.formatNumber<double>(100 - teamInPossessionRatio));
 
-        _mw->updateStatisticsUI(this->whoIsInPossession().first, "TerritoryLabel",
-                                string_functions.formatNumber<double>(teamInTerritoryRatio));
-        _mw->updateStatisticsUI(this->whoIsInPossession().second, "TerritoryLabel",
-                                string_functions.formatNumber<double>(100 - teamInTerritoryRatio));
+        _observer->updateStatisticsUI(this->whoIsInPossession().first, "TerritoryLabel",
+                                      string_functions.formatNumber<double>(teamInTerritoryRatio));
+        _observer->updateStatisticsUI(this->whoIsInPossession().second, "TerritoryLabel",
+                                      string_functions.formatNumber<double>(100 - teamInTerritoryRatio));
 
-        if (_mw->extendedLog()) {
+        if (extendedLog && this->logOn()) {
 
             if (std::round(teamInPossessionRatio * 100) != std::round(teamInPossessionRatio_orig * 100))
-                _mw->logRecord(_mw->dominationStatsForLog(teamInPossessionRatio, 0,
-                               this->whoIsInPossession().first == MatchType::Location::VISITORS));
+                _observer->logRecord(_observer->dominationStatsForLog(teamInPossessionRatio, 0,
+                                     this->whoIsInPossession().first == MatchType::Location::VISITORS));
             if (std::round(teamInTerritoryRatio * 100) != std::round(teamInTerritoryRatio_orig * 100))
-                _mw->logRecord(_mw->dominationStatsForLog(teamInTerritoryRatio, 1,
-                               this->whoIsInPossession().first == MatchType::Location::VISITORS));
+                _observer->logRecord(_observer->dominationStatsForLog(teamInTerritoryRatio, 1,
+                                     this->whoIsInPossession().first == MatchType::Location::VISITORS));
         }
-
-        if (immediateRepaint) {
-
-            _mw->ui->timePlayedLabel->repaint();
-            _mw->ui->matchProgressProgressBar->repaint();
-        }
-    }
-
-    if (this->displayOn(FW)) {
-
-        _fw->ui->currentMatchProgress->setValue(this->_match->timePlayed().timePlayedInSecondsInPeriod());
-        if (immediateRepaint)
-            _fw->ui->currentMatchProgress->repaint();
     }
 
     // sudden-death time ends with score change
@@ -178,7 +236,7 @@ bool GamePlay::refreshTime(const uint8_t seconds, const bool changeTimePeriod, c
 
             // refresh system time
             this->_dateTime.refreshSystemDateAndTime(this->_match->timePlayed().timePlayedInPeriod(this->_match->currentPeriod()));
-            emit timeChanged();
+            this->dateTimeChanged();
 
             this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::FULL_TIME);
 
@@ -193,42 +251,19 @@ bool GamePlay::refreshTime(const uint8_t seconds, const bool changeTimePeriod, c
 
             // refresh system time
             this->_dateTime.refreshSystemDateAndTime(this->_match->timePlayed().timePlayedInPeriod(this->_match->currentPeriod()));
-            emit timeChanged();
+            this->dateTimeChanged();
 
             this->_match->timePlayed().switchTimePeriodTo(/*Next*/);
             const MatchPeriod::TimePeriod currentPeriod = this->_match->currentPeriod();
 
-            if (this->displayOn(FW)) {
-
-                QProgressBar * const progress = _fw->ui->currentMatchProgress;
-                if (progress->maximum() != this->_periods->maximumValue(currentPeriod)) {
-
-                    // reset progress bar
-                    progress->setValue(0);
-                    progress->setMaximum(this->_periods->maximumValue(currentPeriod));
-                    progress->setStyleSheet(ss::shared.style(this->_periods->style(currentPeriod)));
+            if (this->_observer != nullptr)
+                _observer->resetMatchProgress(this->_periods, currentPeriod, immediateRepaint);
 
-                    if (immediateRepaint)
-                        progress->repaint();
-                }
-            }
-
-            if (this->displayOn(MW)) {
-
-                QProgressBar * const progress = _mw->ui->matchProgressProgressBar;
-                if (progress->maximum() != this->_periods->maximumValue(currentPeriod)) {
+            if (this->displayOn(MatchDisplay::DETAIL)) {
 
-                    // reset progress bar
-                    progress->setValue(0);
-                    progress->setMaximum(this->_periods->maximumValue(currentPeriod));
-
-                    if (immediateRepaint)
-                        progress->repaint();
-                }
-
-                _mw->ui->updatePeriod(this->_periods->description(currentPeriod));
-                _mw->logRecord(this->_periods->description(currentPeriod));
-                _mw->timeStoppedMessageBox(this->_periods->messageBoxDefinition(currentPeriod));
+                _observer->updatePeriod(this->_periods->description(currentPeriod));
+                _observer->logRecord(this->_periods->description(currentPeriod));
+                _observer->timeStoppedMessageBox(this->_periods->messageBoxDefinition(currentPeriod));
 
                 // in case of my team's match (MatchWidget) stop at half-time; otherwise continue to play
                 return true;
@@ -244,7 +279,7 @@ void GamePlay::celebrationsTime() {
     this->_match->timePlayed().setTimeForInterval(celebrationsLength);
 
     this->_dateTime.refreshSystemDateAndTime(celebrationsLength);
-    emit timeChanged();
+    this->dateTimeChanged();
 
     return;
 }
@@ -253,19 +288,8 @@ void GamePlay::resetPhases() {
 
     _noOfPhases = 0;
 
-    if (this->displayOn(MW)) {
-
-        if (this->_mw->ui->hostsNoOfPhasesLabel->isVisible()) {
-
-            this->_mw->ui->hostsNoOfPhasesLabel->setVisible(false);
-            this->_mw->ui->hostsNoOfPhasesLabel->repaint();
-        }
-        else {
-
-            this->_mw->ui->visitorsNoOfPhasesLabel->setVisible(false);
-            this->_mw->ui->hostsNoOfPhasesLabel->repaint();
-        }
-    }
+    if (this->displayOn(MatchDisplay::DETAIL))
+        this->_observer->phasesChanged(this->whoIsInPossession().first, _noOfPhases);
 
     return;
 }
@@ -274,21 +298,27 @@ void GamePlay::resetPhases() {
 // e.g. RUN_OVER_GOAL_LINE_TRY_SCORED increases from 95 to 98 (higher probability of scoring)
 // opponent = true => increase probability for team-not-in-possession
 // e.g. RUN_TACKLE_COMPLETED increases from 90 to 95 (higher probability of successful tackle)
+// (adjusted values are calculated only once per match, see ProbabilityTable)
 uint8_t GamePlay::probability(const MatchActionSubtype::MatchActivityType type, const bool opponent) const {
 
-    const uint8_t baseProbability = this->_settings->matchActivities().probability(type);
+    const uint8_t teamInPossession = static_cast<uint8_t>(this->whoIsInPossession().first);
+    uint8_t & adjustedProbability = this->_probabilities.at(teamInPossession, opponent, static_cast<uint8_t>(type));
 
-    int8_t teamRankingDiff = static_cast<int8_t>(this->_match->team(this->whoIsInPossession().second)->ranking())
-                           - static_cast<int8_t>(this->_match->team(this->whoIsInPossession().first)->ranking());
+    if (adjustedProbability == 0)
+        adjustedProbability = this->_probabilities.adjust(this->_settings->matchActivities().probability(type),
+                                                          teamInPossession, opponent);
 
-    const uint8_t teamRankingMaxDiff = std::min(std::abs(teamRankingDiff), 20);
+    return adjustedProbability;
+}
 
-    teamRankingDiff = teamRankingMaxDiff * (teamRankingDiff/std::abs(teamRankingDiff)) *
-                      std::pow(-1, static_cast<uint8_t>(opponent));
+// outcome of a match activity (drawn value => type of outcome as defined in settings); every outcome is counted
+MatchActionSubtype::MatchActivityType GamePlay::activityOutcome(const uint16_t value,
+                                                                const MatchActionType::MatchActivityBaseType action) const {
 
-    const uint8_t adjustedProbability = std::min(std::max(baseProbability + teamRankingDiff, 1), 99);
+    const MatchActionSubtype::MatchActivityType outcome = _settings->matchActivities().action(value, action);
+    EngineCounters::instance().outcome(static_cast<uint8_t>(outcome));
 
-    return adjustedProbability;
+    return outcome;
 }
 
 void GamePlay::changeBallPossession(Team * & team) {
@@ -298,24 +328,18 @@ void GamePlay::changeBallPossession(Team * & team) {
     if (team == this->_match->team(MatchType::Location::HOSTS)) {
 
         team = this->_match->team(MatchType::Location::VISITORS);
-        if (this->displayOn(MW)) {
-
-            _mw->ui->visitorsInPossessionLabel->setEnabled(true);
-            _mw->ui->hostsInPossessionLabel->setEnabled(false);
-        }
+        if (this->displayOn(MatchDisplay::DETAIL))
+            _observer->possessionChanged(MatchType::Location::VISITORS);
     }
     else {
 
         team = this->_match->team(MatchType::Location::HOSTS);
-        if (this->displayOn(MW)) {
-
-            _mw->ui->hostsInPossessionLabel->setEnabled(true);
-            _mw->ui->visitorsInPossessionLabel->setEnabled(false);
-        }
+        if (this->displayOn(MatchDisplay::DETAIL))
+            _observer->possessionChanged(MatchType::Location::HOSTS);
     }
 
-    if (this->displayOn(MW))
-        _mw->logRecord(team->name() + QStringLiteral(" team is now in possession of the ball."));
+    if (this->logOn())
+        _observer->logRecord(team->name() % QStringLiteral(" team is now in possession of the ball."));
 
     return;
 }
@@ -341,64 +365,19 @@ uint32_t GamePlay::playerSuitabilityAssessment(const player::PreferredForAction
 
 Player * GamePlay::searchForPlayerWhoTakesOverBall() const {
 
-    // current player's position type (e.g. second row)
-    const PlayerPosition_index_item::PositionType currentPlayerPositionType =
-        this->_playerInPossession->position()->positionType();
-
-    // every position type has certain probability of taking over the ball
-    // note: these probabilities depend on current player's position type
-    uint8_t sumOfProbabilities = 0;
-    QMap<uint8_t, PlayerPosition_index_item::PositionType> probabilitiesForPositionTypes;
-    for (uint8_t i = 0; i <= static_cast<uint8_t>(PlayerPosition_index_item::PositionType::FULLBACK); ++i) {
-
-        probabilitiesForPositionTypes.insert(
-            sumOfProbabilities += (7 - std::abs(i - static_cast<uint8_t>(currentPlayerPositionType))),
-            static_cast<PlayerPosition_index_item::PositionType>(i));
-    }
-
-    uint8_t noOfPlayersWhoCanTakeOverBall = 0;
-    Player * playerWhoTakesOverTheBall = nullptr;
-
-    do {
-
-        // which position type takes over the ball
-        PlayerPosition_index_item::PositionType futurePlayerPositionType = currentPlayerPositionType;
-        const uint8_t probability = RandomValue::generateRandomInt<uint8_t>(1, sumOfProbabilities);
-
-        QMap<uint8_t, PlayerPosition_index_item::PositionType>::key_iterator key_it = probabilitiesForPositionTypes.keyBegin();
-        for (; key_it != probabilitiesForPositionTypes.keyEnd(); ++key_it)
-
-            // QMap's keys contain cummulated probabilities (upper bounds) for different position types
-            if (probability <= (*key_it)) {
-
-                // if generated probability falls within certain upper bound (key)
-                // then this key is used for retrieving associated position type
-                // if position type can't be retrieved then currentPlayerPositionType is used (this shouldn't happen)
-                futurePlayerPositionType = static_cast<PlayerPosition_index_item::PositionType>
-                                           (probabilitiesForPositionTypes.value((*key_it), currentPlayerPositionType));
-                break;
-            }
-
-        // search for players (with given position type) who are eligible for taking over the ball
-        // we search always among players of team-in-possession because in case that possession changes (e.g. when
-        // losing the ball to an opponent), function changePlayerInPossession is called only after changeBallPossession
-        QVector<Player *> availablePlayers;
-        noOfPlayersWhoCanTakeOverBall = _match->team(this->whoIsInPossession().first)->
-            availablePlayers(futurePlayerPositionType, _playerInPossession, availablePlayers);
-
-        // which (particular) player takes over the ball
-        if (noOfPlayersWhoCanTakeOverBall == 1) // there's only one eligible player
-            playerWhoTakesOverTheBall = availablePlayers.at(0);
+    // we search always among players of team-in-possession because in case that possession changes (e.g. when
+    // losing the ball to an opponent), function changePlayerInPossession is called only after changeBallPossession
+    // note: position type (of player who takes over the ball) is drawn by probabilities depending on current player's
+    // position type and then one of eligible players of this type is drawn (see Team::buildReceiverTables)
+    Player * const playerWhoTakesOverTheBall =
+        _match->team(this->whoIsInPossession().first)->drawReceiver(_playerInPossession, this->_random);
 
-        if (noOfPlayersWhoCanTakeOverBall > 1) { // there are more eligible players
-
-            const uint8_t playerToPick = RandomValue::generateRandomInt<uint8_t>(1, noOfPlayersWhoCanTakeOverBall);
-            playerWhoTakesOverTheBall = availablePlayers.at(playerToPick-1);
-        }
-    }
-    while (noOfPlayersWhoCanTakeOverBall == 0); // if none player is found => repeat process
+    EngineCounters::instance().increment(EngineCounters::RECEIVER_DRAWS);
+    if (playerWhoTakesOverTheBall == nullptr)
+        EngineCounters::instance().increment(EngineCounters::RECEIVER_NOT_FOUND);
 
-    return playerWhoTakesOverTheBall;
+    // nobody else is on pitch (this shouldn't happen) => ball stays with current player
+    return ((playerWhoTakesOverTheBall != nullptr) ? playerWhoTakesOverTheBall : _playerInPossession);
 }
 
 Player * GamePlay::searchForOpponentsPlayer() {
@@ -449,6 +428,12 @@ void GamePlay::displayDiagnosticDataExtended(QStringList & diagnosticDataItems)
                                QString::number(this->_match->team(MatchType::Location::HOSTS)->numberOfPlayersOnPitch()) %
                                string_functions.wrapInBrackets(PitchLocation[MatchType::Location::VISITORS]) %
                                QString::number(this->_match->team(MatchType::Location::VISITORS)->numberOfPlayersOnPitch()));
+
+    const EngineCounters::Values counters = EngineCounters::instance().values();
+    const uint64_t steps = std::max<uint64_t>(counters.counters.at(EngineCounters::STEPS), 1);
+    diagnosticDataItems.append(html_functions.buildBoldText(QStringLiteral("Engine:")) % QStringLiteral(" steps: ") %
+                               QString::number(counters.counters.at(EngineCounters::STEPS)) % QStringLiteral(", step: ") %
+                               QString::number(counters.stepTimeTotal / 1000.0 / steps, 'f', 2) % QStringLiteral(" µs"));
     return;
 }
 
@@ -482,10 +467,8 @@ void GamePlay::displayDiagnosticData(const player::PreferredForAction lastAction
     this->displayDiagnosticDataExtended(diagnosticDataItems);
 
     const QString diagnosticData = diagnosticDataItems.join(html_tags.lineBreak);
-    const QMessageBox::StandardButton result =
-        QMessageBox::warning(nullptr, QStringLiteral("Diagnostic data"), diagnosticData, QMessageBox::Ok | QMessageBox::Cancel);
 
-    if (result == QMessageBox::Cancel)
+    if (!this->_observer->diagnosticData(diagnosticData))
         this->_settings->toggleDiagnosticMode(false);
 
     return;
@@ -527,8 +510,17 @@ void GamePlay::refreshPointsList(const MatchType::Location loc) const {
         }
     }
 
-    _mw->displayPoints(pointsAndPlayers, loc);
+    _observer->displayPoints(pointsAndPlayers, loc);
+
+    return;
+}
+
+// every change of match score or of players' match statistics is recorded in match's event log (see MatchReplay)
+void GamePlay::recordEvent(const MatchEvent::Type type, const MatchType::Location team, Player * const player,
+                           const uint16_t value, const uint8_t outcome) const {
 
+    this->_match->events().record(this->_match->timePlayedInSeconds(), type, static_cast<uint8_t>(team),
+                                  (player != nullptr) ? player->code() : 0, value, outcome);
     return;
 }
 
@@ -538,6 +530,7 @@ void GamePlay::updateStatistics(const MatchType::Location loc, const StatsType::
     player->stats()->incrementStatsValue(stats);
     // current game (stored "under" match/player_score)
     this->_match->playerStats(loc, player)->incrementStatsValue(stats);
+    this->recordEvent(MatchEvent::Type::PLAYER_STATS, loc, player, 0, static_cast<uint8_t>(stats));
 
     // note: Ʃ(games-stats) = total-stats
     return;
@@ -550,9 +543,9 @@ void GamePlay::changePlayerInPossession() {
     // no position for a specialist = passing to team-mate or losing ball to opponent
     _playerInPossession = this->searchForPlayerWhoTakesOverBall();
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+        _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
         if (this->_settings->diagnosticMode())
             this->displayDiagnosticData();
     }
@@ -568,10 +561,11 @@ void GamePlay::changePlayerInPossessionToSpecialist(const player::PreferredForAc
         { _playerInPossession = this->searchForPlayerWhoTakesOverBall(); return; }
 
     const MatchType::Location teamInPossession = this->whoIsInPossession().first;
+    EngineCounters::instance().increment(EngineCounters::SPECIALIST_SELECTIONS);
 
     QMap<uint32_t, Player *> playersPreferredForAction;
     Player * randomPlayerIfNoPreferredPlayer;
-    uint8_t randomPlayerNo = RandomValue::generateRandomInt(static_cast<uint8_t>(1),
+    uint8_t randomPlayerNo = this->_random.generateRandomInt(static_cast<uint8_t>(1),
                              this->_match->team(teamInPossession)->numberOfPlayersOnPitch());
 
     for (auto player: this->_match->team(teamInPossession)->squad()) {
@@ -587,26 +581,16 @@ void GamePlay::changePlayerInPossessionToSpecialist(const player::PreferredForAc
     }
 
     bool selectedInDialog = false;
-    if (this->displayOn(MW) && playersPreferredForAction.size() > 1 && !_automaticSelection &&
+    if (this->displayOn(MatchDisplay::DETAIL) && playersPreferredForAction.size() > 1 && !_automaticSelection &&
         (action == player::PreferredForAction::PENALTY || action == player::PreferredForAction::CONVERSION)) {
 
-        QStringList playersForSelection;
-        for (auto player: playersPreferredForAction) {
-
-            const QString playerDescription =
-                player->fullName() % string_functions.wrapInBrackets(QString::number(player->shirtNo())) %
-                QStringLiteral("- ") % player->position()->currentPosition();
-            playersForSelection.append(playerDescription);
-        }
-
-        const QString selectedPlayer = QInputDialog::getItem(nullptr, QStringLiteral("Select player"),
-            message.displayWithReplace(this->objectName(), QStringLiteral("selectPlayerForAction"),
-            { player::preferenceColumnNames[action] }), playersForSelection, 0, false, &selectedInDialog);
+        Player * const selectedPlayer = _observer->selectPlayerForAction(
+            MessageTemplate::find(this->objectName(), QStringLiteral("selectPlayerForAction")).format(
+            { player::preferenceColumnNames[action] }), playersPreferredForAction, &selectedInDialog);
         _automaticSelection = !selectedInDialog;
 
-        for (auto player: playersPreferredForAction)
-            if (selectedPlayer.contains(player->fullName()) && selectedPlayer.contains(QString::number(player->shirtNo())))
-                _playerInPossession = player;
+        if (selectedInDialog)
+            _playerInPossession = selectedPlayer;
     }
 
     if (!selectedInDialog) {
@@ -616,9 +600,9 @@ void GamePlay::changePlayerInPossessionToSpecialist(const player::PreferredForAc
                                playersPreferredForAction[playersPreferredForAction.lastKey()];
     }
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updatePlayer(_playerInPossession->fullName(), teamInPossession);
+        _observer->updatePlayer(_playerInPossession->fullName(), teamInPossession);
         if (this->_settings->diagnosticMode())
             this->displayDiagnosticData(action);
     }
@@ -653,30 +637,26 @@ int8_t GamePlay::distanceToGoalLine() const {
 Team * GamePlay::draw() {
 
     this->_match->timePlayed().switchTimePeriodTo();
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->ui->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
-        _mw->logRecord(QStringLiteral("Draw in progress."));
+        _observer->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
+        _observer->logRecord(QStringLiteral("Draw in progress."));
 
         // show information message
-        _mw->timeStoppedMessageBox("beforeStartOfMatch", { this->_match->referee()->referee() } );
+        _observer->timeStoppedMessageBox("beforeStartOfMatch", { this->_match->referee()->referee() } );
     }
 
-    this->_hostsFirstKickOff = RandomValue::generateRandomBool(50);
+    this->_hostsFirstKickOff = this->_random.generateRandomBool(50);
     const MatchType::Location team = (this->_hostsFirstKickOff) ? MatchType::Location::HOSTS : MatchType::Location::VISITORS;
     Team * teamInPossession = this->_match->team(team);
-    if (this->displayOn(MW))
-        _mw->logRecord(QStringLiteral("Draw won by: ") + teamInPossession->name());
+    if (this->logOn())
+        _observer->logRecord(QStringLiteral("Draw won by: ") % teamInPossession->name());
 
     if (teamInPossession == this->_myTeam) {
 
-        if (this->displayOn(MW)) {
-
-            QMessageBox::StandardButton sideOrBall = QMessageBox::question(nullptr, QStringLiteral("Draw won."),
-                QStringLiteral("Would you prefer to choose side (Yes) over ball (No)?"),
-                QMessageBox::StandardButtons(QMessageBox::Yes|QMessageBox::No));
+        if (this->displayOn(MatchDisplay::DETAIL)) {
 
-            if (sideOrBall == QMessageBox::Yes) {
+            if (_observer->sideOverBall()) {
 
                 this->changeBallPossession(teamInPossession);
                 this->_hostsFirstKickOff = !this->_hostsFirstKickOff;
@@ -686,52 +666,35 @@ Team * GamePlay::draw() {
     }
     else {
 
-        const bool sideOrBall = RandomValue::generateRandomBool(70);
+        const bool sideOrBall = this->_random.generateRandomBool(70);
         if (sideOrBall) {
 
             this->changeBallPossession(teamInPossession);
             this->_hostsFirstKickOff = !this->_hostsFirstKickOff;
-            if (this->displayOn(MW))
-                QMessageBox::information(nullptr, QStringLiteral("Draw lost."), QStringLiteral("Your opponent chooses side."));
+            if (this->displayOn(MatchDisplay::DETAIL))
+                _observer->notify(GamePlayObserver::Notification::INFORMATION,
+                                  QStringLiteral("Draw lost."), QStringLiteral("Your opponent chooses side."));
         }
         else {
 
-            if (this->displayOn(MW))
-                QMessageBox::information(nullptr, QStringLiteral("Draw lost."), QStringLiteral("Your opponent chooses ball."));
+            if (this->displayOn(MatchDisplay::DETAIL))
+                _observer->notify(GamePlayObserver::Notification::INFORMATION,
+                                  QStringLiteral("Draw lost."), QStringLiteral("Your opponent chooses ball."));
             // vybrat stranu
         }
     }
 
     // tag team in possession of the ball (with icon)
-    if (this->displayOn(MW)) {
-
-        _mw->ui->hostsInPossessionLabel->setEnabled(this->_hostsFirstKickOff);
-        _mw->ui->visitorsInPossessionLabel->setEnabled(!this->_hostsFirstKickOff);
-    }
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->possessionChanged((this->_hostsFirstKickOff)
+                                     ? MatchType::Location::HOSTS : MatchType::Location::VISITORS);
 
     return teamInPossession;
 }
 
 void GamePlay::updateBallPositionProgressBars() const {
 
-    if (_distanceFromHalfwayLine >= 0) {
-
-        _mw->ui->ballPositionVisitorsProgressBar->setValue(0);
-        const uint8_t value = std::min<uint8_t>(static_cast<uint8_t>(_distanceFromHalfwayLine),
-                                                groundDimensions.fromGoalLineToHalfwayLine);
-        _mw->ui->ballPositionHostsProgressBar->setValue(value);
-        _mw->ui->ballPositionHostsProgressBar->repaint();
-    }
-
-    if (_distanceFromHalfwayLine <= 0) {
-
-        _mw->ui->ballPositionHostsProgressBar->setValue(0);
-        const uint8_t value = std::min<uint8_t>(static_cast<uint8_t>(std::abs(_distanceFromHalfwayLine)),
-                                                groundDimensions.fromGoalLineToHalfwayLine);
-        _mw->ui->ballPositionVisitorsProgressBar->setValue(value);
-        _mw->ui->ballPositionVisitorsProgressBar->repaint();
-    }
-
+    this->_observer->ballPositionChanged(_distanceFromHalfwayLine);
     return;
 }
 
@@ -744,7 +707,7 @@ void GamePlay::changeBallPositionOnPitch(const uint8_t metresMade) {
         _distanceFromHalfwayLine -= metresMade;
 
     // update ball position progress bars
-    if (this->displayOn(MW))
+    if (this->displayOn(MatchDisplay::DETAIL))
         this->updateBallPositionProgressBars();
 
     return;
@@ -765,14 +728,15 @@ uint8_t GamePlay::moveBallToSpecificPositionOnPitch(const uint8_t moveToThisDist
             (groundDimensions.fromGoalLineToHalfwayLine - moveToThisDistanceFromGoalLine);
 
         // update ball position progress bars
-        if (this->displayOn(MW))
+        if (this->displayOn(MatchDisplay::DETAIL))
             this->updateBallPositionProgressBars();
     }
 
     return (static_cast<uint8_t>(this->distanceToGoalLine()));
 }
 
-double GamePlay::kickAtGoalProbability(const uint8_t distanceFromMiddle, const uint8_t metresFromGoalLine) const {
+// probability based on kick's position only (angle and distance, without kicker's skill)
+double GamePlay::kickAtGoalPositionProbability(const uint8_t distanceFromMiddle, const uint8_t metresFromGoalLine) const {
 
     // calculace effective angle for the penalty (the wider the angle the greater the probability of success)
     const double distanceToFirstGoalPost = std::abs(groundDimensions.widthBetweenGoalPosts/2.0 - distanceFromMiddle);
@@ -796,11 +760,40 @@ double GamePlay::kickAtGoalProbability(const uint8_t distanceFromMiddle, const u
     const double kickDistance = this->kickDistance(distanceFromMiddle, metresFromGoalLine);
     const double distanceProbability = (kickDistance <= groundDimensionsInferred.maxDistance * 0.8) ? 1 : 0.8;
 
+    return (angleProbability * distanceProbability);
+}
+
+// values for all positions on pitch (in whole metres) from one touchline to the middle and from goal line to goal line;
+// index = distanceFromMiddle * (groundDimensions.fromGoalLineToGoalLine + 1) + metresFromGoalLine
+QVector<double> GamePlay::kickAtGoalGrid() const {
+
+    const uint16_t length = groundDimensions.fromGoalLineToGoalLine + 1;
+    QVector<double> grid((groundDimensions.fromTouchToHalfwayPoint + 1) * length);
+
+    for (uint8_t distanceFromMiddle = 0; distanceFromMiddle <= groundDimensions.fromTouchToHalfwayPoint; ++distanceFromMiddle)
+        for (uint8_t metresFromGoalLine = 0; metresFromGoalLine < length; ++metresFromGoalLine)
+            grid[distanceFromMiddle * length + metresFromGoalLine] =
+                this->kickAtGoalPositionProbability(distanceFromMiddle, metresFromGoalLine);
+
+    return grid;
+}
+
+double GamePlay::kickAtGoalProbability(const uint8_t distanceFromMiddle, const uint8_t metresFromGoalLine) const {
+
+    // position part doesn't depend on match or kicker => grid is calculated only once (shared by all matches)
+    static const QVector<double> grid = this->kickAtGoalGrid();
+    const uint16_t length = groundDimensions.fromGoalLineToGoalLine + 1;
+
+    const double positionProbability =
+        (distanceFromMiddle <= groundDimensions.fromTouchToHalfwayPoint && metresFromGoalLine < length)
+        ? grid.at(distanceFromMiddle * length + metresFromGoalLine)
+        : this->kickAtGoalPositionProbability(distanceFromMiddle, metresFromGoalLine);
+
     // probability based on player's attributes (kicking)
     const double playerSkillProbability =
         0.8 + (_playerInPossession->attribute(player::Attributes::KICKING) / static_cast<double>(50));
 
-    return (angleProbability * distanceProbability * playerSkillProbability);
+    return (positionProbability * playerSkillProbability);
 }
 
 void GamePlay::penaltyScored() const {
@@ -811,23 +804,25 @@ void GamePlay::penaltyScored() const {
     const uint8_t currentValuePenalties = this->_match->score(team)->penaltiesScored();
     _playerInPossession->points()->penaltyScored();
     this->_match->playerPoints(team, _playerInPossession)->penaltyScored();
+    this->recordEvent(MatchEvent::Type::PENALTY_GOAL, team, _playerInPossession);
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
-        _mw->updateStatisticsUI(team, QStringLiteral("PenaltiesLabel"), QString::number(currentValuePenalties));
+        _observer->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
+        _observer->updateStatisticsUI(team, QStringLiteral("PenaltiesLabel"), QString::number(currentValuePenalties));
 
         this->refreshPointsList(team);
 
         // display current score in log
-        _mw->logRecord(_mw->currentScore());
+        if (this->logOn())
+            _observer->logRecord(_observer->currentScore());
 
         // show information message
-        _mw->timeStoppedMessageBox("penaltyScored",
+        _observer->timeStoppedMessageBox("penaltyScored",
             { player::preferenceColumnNames[player::PreferredForAction::PENALTY], _playerInPossession->fullName() });
     }
-    if (this->displayOn(FW))
-        _fw->updateScore(team);
+    if (this->displayOn(MatchDisplay::PROGRESS))
+        _observer->updateScore(team);
 
     this->changeInMorale(_playerInPossession, true);
 
@@ -858,7 +853,7 @@ QString GamePlay::selectActionAfterPenaltyInfringement(const QStringList & optio
         (pointsInSpecifiedRange || this->_match->score(team)->points(PointEvent::TRY) == matchPoints.NoOfPointsForDiffPoint-1))
         return GamePlay::actionAfterPenaltyInfringement[GamePlay::PenaltyAction::KICK_TO_TOUCH];
 
-    const uint8_t randomSelection = RandomValue::generateRandomInt<uint8_t>(0, optionsForPenalty.size()-1);
+    const uint8_t randomSelection = this->_random.generateRandomInt<uint8_t>(0, optionsForPenalty.size()-1);
 
     return optionsForPenalty.at(randomSelection);
 }
@@ -866,15 +861,17 @@ QString GamePlay::selectActionAfterPenaltyInfringement(const QStringList & optio
 timePassed GamePlay::penalty() {
 
     this->resetPhases();
+    EngineCounters::instance().increment(EngineCounters::PENALTIES);
 
     // update penalty infringements' statistics
     const MatchType::Location team = this->whoIsInPossession().second;
     const uint8_t currentValueInfringements = this->_match->score(team)->penaltyInfringements();
-    if (this->displayOn(MW))
-        _mw->updateStatisticsUI(team, QStringLiteral("PenaltyInfringementsLabel"), QString::number(currentValueInfringements));
+    this->recordEvent(MatchEvent::Type::PENALTY_INFRINGEMENT, team);
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updateStatisticsUI(team, QStringLiteral("PenaltyInfringementsLabel"), QString::number(currentValueInfringements));
 
     // find out where the infringement has occurred (distance from the middle of the goal-line)
-    const uint8_t distanceFromMiddle = RandomValue::generateRandomInt<uint8_t>(0, groundDimensions.fromTouchToHalfwayPoint);
+    const uint8_t distanceFromMiddle = this->_random.generateRandomInt<uint8_t>(0, groundDimensions.fromTouchToHalfwayPoint);
 
     const uint8_t distanceFromGoalLine = this->distanceToGoalLine();
     // distance from goal-line from which the penalty kick (or other selected type of restart)
@@ -890,21 +887,26 @@ timePassed GamePlay::penalty() {
     if (this->distanceToGoalLine() >= std::min(this->_settings->kickMaxDistance(), groundDimensions.fromGoalLineToHalfwayLine))
         optionsForPenalty.removeOne(GamePlay::actionAfterPenaltyInfringement[GamePlay::PenaltyAction::KICK_AT_GOAL]);
     // tap penalty is possible only on some occassions (and not within 5m of the goal-line)
-    if (!RandomValue::generateRandomBool(this->_settings->matchActivities().probability
+    if (!this->_random.generateRandomBool(this->_settings->matchActivities().probability
         (MatchActionSubtype::TAP_PENALTY_POSSIBLE)) || distanceFromGoalLine < 5)
         optionsForPenalty.removeOne(GamePlay::actionAfterPenaltyInfringement[GamePlay::PenaltyAction::TAP_PENALTY]);
 
-    if (this->displayOn(MW) && _myTeam == _teamInPossession) {
+    if (this->displayOn(MatchDisplay::DETAIL) && _myTeam == _teamInPossession) {
 
-        const QString side = (RandomValue::generateRandomBool(50)) ? QStringLiteral("left") : QStringLiteral("right");
+        const QString side = (this->_random.generateRandomBool(50)) ? QStringLiteral("left") : QStringLiteral("right");
 
         const QString restartMovedTo5m = (distanceFromGoalLine < 5 || distanceFromGoalLine > 95)
                                        ? QStringLiteral(" Restart is moved to 5m line.") : QString();
-        const QString dialogText = message.displayWithReplace(this->objectName(), "penaltyAttempt",
+        const QString dialogText = MessageTemplate::find(this->objectName(), QStringLiteral("penaltyAttempt")).format(
             { QString::number(distanceFromGoalLine), QString::number(distanceFromMiddle), side, restartMovedTo5m });
 
-        selectedAction = QInputDialog::getItem(nullptr, QStringLiteral("Select action after penalty infringement"),
-                                               dialogText, optionsForPenalty);
+        selectedAction = _observer->selectActionAfterPenalty(dialogText, optionsForPenalty);
+    }
+    else if (_myTeam == _teamInPossession && optionsForPenalty.contains(this->_penaltyDecision)) {
+
+        // decision made in advance (see decideNextPenalty) applies to one penalty only
+        selectedAction = this->_penaltyDecision;
+        this->_penaltyDecision.clear();
     }
     else
         // automatic selection of (type of) resuming play from possible options (after penalty infringement)
@@ -918,28 +920,29 @@ timePassed GamePlay::penalty() {
 
             this->changePlayerInPossessionToSpecialist(player::PreferredForAction::PENALTY);
 
-            if (this->displayOn(MW)) {
+            if (this->displayOn(MatchDisplay::DETAIL)) {
 
-                _mw->logRecord(message.displayWithReplace(this->penaltySelectedType(),
-                               QStringLiteral("penaltyKickAtGoal"), { _teamInPossession->name() }));
-                _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+                if (this->logOn())
+                    this->logMessage(this->penaltySelectedType(), QStringLiteral("penaltyKickAtGoal"), { _teamInPossession->name() });
+                _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
             }
 
             // calculate probability of success
             const double probability = this->kickAtGoalProbability(distanceFromMiddle, metresFromGoalLine) *
                                        this->_settings->matchActivities().probability(MatchActionSubtype::PENALTY_SCORED);
 
-            const bool penaltyScored = RandomValue::generateRandomBool(static_cast<uint8_t>(probability));
-            QString penaltyScoredText =
-                QStringLiteral("Penalty kick (from ") % QString::number(kickDistance, 'f', 2) % QStringLiteral(" m) by ") %
-                _playerInPossession->fullName() % QStringLiteral(": kick at goal was not successful");
+            const bool penaltyScored = this->_random.generateRandomBool(static_cast<uint8_t>(probability));
+            // log row is formatted only if it's going to be shown
+            auto penaltyScoredText = [this, kickDistance](const QString & result) -> QString {
 
-            if (!penaltyScored) {
+                return QStringLiteral("Penalty kick (from ") % QString::number(kickDistance, 'f', 2) % QStringLiteral(" m) by ") %
+                       _playerInPossession->fullName() % QStringLiteral(": kick at goal was ") % result;
+            };
 
-                if (this->displayOn(MW)) {
+            if (!penaltyScored) {
 
-                    _mw->logRecord(penaltyScoredText);
-                }
+                if (this->logOn())
+                    _observer->logRecord(penaltyScoredText(QStringLiteral("not successful")));
 
                 // if the ball is caught by the opposition before it leaves the field of play, play continues (not implemented);
                 // otherwise play is restarted with a drop-out from the offenders' 22m line (currently always)
@@ -947,11 +950,8 @@ timePassed GamePlay::penalty() {
             }
             else {
 
-                if (this->displayOn(MW)) {
-
-                    penaltyScoredText = penaltyScoredText.replace("not ", QString()) + _mw->pointsInfoForLog(pointValue.Penalty);
-                    _mw->logRecord(penaltyScoredText);
-                }
+                if (this->logOn())
+                    _observer->logRecord(penaltyScoredText(QStringLiteral("successful")) + _observer->pointsInfoForLog(pointValue.Penalty));
                 this->penaltyScored();
                 this->_restartPlay = true; // restart kick follows
             }
@@ -960,8 +960,8 @@ timePassed GamePlay::penalty() {
             this->changeBallPossession(_teamInPossession);
             this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
 
-            if (this->displayOn(MW))
-                _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+            if (this->displayOn(MatchDisplay::DETAIL))
+                _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
 
             break;
         }
@@ -969,20 +969,20 @@ timePassed GamePlay::penalty() {
 
             this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
 
-            if (this->displayOn(MW)) {
+            if (this->displayOn(MatchDisplay::DETAIL)) {
 
-                _mw->logRecord(message.displayWithReplace(this->penaltySelectedType(),
-                               QStringLiteral("penaltyKickIntoTouch"), { _teamInPossession->name() }));
-                _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+                if (this->logOn())
+                    this->logMessage(this->penaltySelectedType(), QStringLiteral("penaltyKickIntoTouch"), { _teamInPossession->name() });
+                _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
             }
 
             // kick distance
             const uint8_t maxDistance = std::min<uint8_t>(_settings->kickMaxDistance(), distanceToGoalLine());
-            uint8_t metresMade = RandomValue::generateRandomInt<uint8_t>(1, maxDistance);
+            uint8_t metresMade = this->_random.generateRandomInt<uint8_t>(1, maxDistance);
 
             // has kick really ended in touch (as was intended) or not?
             const uint8_t probability = this->_settings->matchActivities().probability(MatchActionSubtype::PENALTY_KICK_INTO_TOUCH);
-            const bool kickIntoTouch = RandomValue::generateRandomBool(probability);
+            const bool kickIntoTouch = this->_random.generateRandomBool(probability);
 
             // if line-out would be thrown within 5m distance off goal line, it is formed on the 5-metre line
             if (kickIntoTouch && (this->distanceToGoalLine() - metresMade < groundDimensions.fromGoalLineTo5metreLine))
@@ -1004,8 +1004,8 @@ timePassed GamePlay::penalty() {
                 // the field of play, play continues; if the ball goes into touch-in-goal then play is restarted with
                 // a drop-out from the offenders' 22m line (currently not implemented)
 
-                if (this->displayOn(MW))
-                    _mw->logRecord(message.display(this->penaltySelectedType(), QStringLiteral("kickIntoTouchMissed")));
+                if (this->logOn())
+                    this->logMessage(this->penaltySelectedType(), QStringLiteral("kickIntoTouchMissed"));
 
                 this->changeBallPossession(_teamInPossession);
                 this->changePlayerInPossession();
@@ -1017,9 +1017,8 @@ timePassed GamePlay::penalty() {
         }
         case GamePlay::PenaltyAction::SCRUM: {
 
-            if (this->displayOn(MW))
-                _mw->logRecord(message.displayWithReplace(this->penaltySelectedType(),
-                               QStringLiteral("scrumInsteadOfPenalty"), { _teamInPossession->name() }));
+            if (this->logOn())
+                this->logMessage(this->penaltySelectedType(), QStringLiteral("scrumInsteadOfPenalty"), { _teamInPossession->name() });
 
             const timePassed timePassed = this->scrum();
             return timePassed;
@@ -1043,26 +1042,30 @@ void GamePlay::conversionScored() const {
     const uint8_t currentValueConversions = this->_match->score(team)->conversionScored();
     _playerInPossession->points()->conversionScored();
     this->_match->playerPoints(team, _playerInPossession)->conversionScored();
+    this->recordEvent(MatchEvent::Type::CONVERSION, team, _playerInPossession);
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
-        _mw->updateStatisticsUI(team, QStringLiteral("ConversionsLabel"), QString::number(currentValueConversions));
+        _observer->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
+        _observer->updateStatisticsUI(team, QStringLiteral("ConversionsLabel"), QString::number(currentValueConversions));
 
         this->refreshPointsList(team);
 
         // display current score in log
-        const QString conversionScoredText = QStringLiteral("Try converted by ") % _playerInPossession->fullName() %
-                                             '.' % _mw->pointsInfoForLog(pointValue.Conversion);
-        _mw->logRecord(conversionScoredText);
-        _mw->logRecord(_mw->currentScore());
+        if (this->logOn()) {
+
+            const QString conversionScoredText = QStringLiteral("Try converted by ") % _playerInPossession->fullName() %
+                                                 '.' % _observer->pointsInfoForLog(pointValue.Conversion);
+            _observer->logRecord(conversionScoredText);
+            _observer->logRecord(_observer->currentScore());
+        }
 
         // show information message
-        _mw->timeStoppedMessageBox("conversionScored",
+        _observer->timeStoppedMessageBox("conversionScored",
             { player::preferenceColumnNames[player::PreferredForAction::CONVERSION], _playerInPossession->fullName() });
     }
-    if (this->displayOn(FW))
-        _fw->updateScore(team);
+    if (this->displayOn(MatchDisplay::PROGRESS))
+        _observer->updateScore(team);
 
     this->changeInMorale(_playerInPossession, true);
 
@@ -1072,22 +1075,22 @@ void GamePlay::conversionScored() const {
 timePassed GamePlay::conversionAttempt() {
 
     // find out where the try has been scored (distance from the middle of the goal-line)
-    const uint8_t distanceFromMiddle = RandomValue::generateRandomInt<uint8_t>(0, groundDimensions.fromTouchToHalfwayPoint);
+    const uint8_t distanceFromMiddle = this->_random.generateRandomInt<uint8_t>(0, groundDimensions.fromTouchToHalfwayPoint);
 
     uint8_t metresFromGoalLine = groundDimensions.fromGoalLineTo5metreLine;
     bool executeConversion = true; // team can decide not to execute the conversion kick
 
-    if (this->displayOn(MW) && _myTeam == _teamInPossession) {
+    if (this->displayOn(MatchDisplay::DETAIL) && _myTeam == _teamInPossession) {
 
-        const QString side = (RandomValue::generateRandomBool(50)) ? QStringLiteral("left") : QStringLiteral("right");
+        const QString side = (this->_random.generateRandomBool(50)) ? QStringLiteral("left") : QStringLiteral("right");
 
         // distance from goal-line from which the conversion kick is going to be executed
-        const QString dialogText = message.displayWithReplace(this->objectName(), "conversionAttempt",
-                                                              { QString::number(distanceFromMiddle), side });
+        const QString dialogText = MessageTemplate::find(this->objectName(), QStringLiteral("conversionAttempt"))
+                                   .format({ QString::number(distanceFromMiddle), side });
 
-        metresFromGoalLine = QInputDialog::getInt(nullptr, QStringLiteral("Conversion"), dialogText,
-                                                  metresFromGoalLine, groundDimensions.fromGoalLineTo5metreLine,
-                                                  groundDimensions.fromGoalLineToHalfwayLine, 1, &executeConversion);
+        metresFromGoalLine = _observer->conversionDistance(dialogText, metresFromGoalLine,
+                                                           groundDimensions.fromGoalLineTo5metreLine,
+                                                           groundDimensions.fromGoalLineToHalfwayLine, &executeConversion);
     }
     else {
 
@@ -1095,12 +1098,12 @@ timePassed GamePlay::conversionAttempt() {
         if (static_cast<float>(distanceFromMiddle) <= std::round(groundDimensions.widthBetweenGoalPosts/2.0f))
             metresFromGoalLine = groundDimensions.fromGoalLineTo5metreLine;
         else if (static_cast<float>(distanceFromMiddle) <= std::round(groundDimensions.fromTouchToHalfwayPoint/2.0f))
-            metresFromGoalLine = RandomValue::generateRandomInt(
+            metresFromGoalLine = this->_random.generateRandomInt(
                 static_cast<uint8_t>(groundDimensions.fromGoalLineTo5metreLine * 2), groundDimensions.fromGoalLineTo22metreLine);
-        else metresFromGoalLine = RandomValue::generateRandomInt(
+        else metresFromGoalLine = this->_random.generateRandomInt(
                 groundDimensions.fromGoalLineTo22metreLine, groundDimensions.fromGoalLineTo10metreLine);
 
-        executeConversion = RandomValue::generateRandomBool(
+        executeConversion = this->_random.generateRandomBool(
             this->_settings->matchActivities().probability(MatchActionSubtype::MatchActivityType::CONVERSION_KICKED));
     }
 
@@ -1108,8 +1111,8 @@ timePassed GamePlay::conversionAttempt() {
 
         this->changePlayerInPossessionToSpecialist(player::PreferredForAction::CONVERSION);
 
-        if (this->displayOn(MW))
-            _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+        if (this->displayOn(MatchDisplay::DETAIL))
+            _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
     }
     else  { // conversion is not executed (as desired by team which scored)
 
@@ -1117,8 +1120,8 @@ timePassed GamePlay::conversionAttempt() {
         this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
         this->_restartPlay = true;
 
-        if (this->displayOn(MW))
-            _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+        if (this->displayOn(MatchDisplay::DETAIL))
+            _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
 
         this->changeInMorale(_teamInPossession, false);
 
@@ -1129,15 +1132,12 @@ timePassed GamePlay::conversionAttempt() {
     const double probability = this->kickAtGoalProbability(distanceFromMiddle, metresFromGoalLine) *
                                this->_settings->matchActivities().probability(MatchActionSubtype::CONVERSION_SUCCESSFUL);
 
-    const bool conversionConverted = RandomValue::generateRandomBool(static_cast<uint8_t>(probability));
+    const bool conversionConverted = this->_random.generateRandomBool(static_cast<uint8_t>(probability));
 
     if (!conversionConverted) {
 
-        if (this->displayOn(MW)) {
-
-            const QString conversionScoredText = QStringLiteral("Try not converted.");
-            _mw->logRecord(conversionScoredText);
-        }
+        if (this->logOn())
+            _observer->logRecord(QStringLiteral("Try not converted."));
     }
     else
         this->conversionScored();
@@ -1149,8 +1149,8 @@ timePassed GamePlay::conversionAttempt() {
 
     this->changeInMorale(_teamInPossession, false);
 
-    if (this->displayOn(MW))
-        _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
 
     return timeForGameAction.CONVERSION;
 }
@@ -1163,38 +1163,36 @@ timePassed GamePlay::tryScored() {
     const uint8_t currentValueTries = this->_match->score(team)->tryScored();
     _playerInPossession->points()->tryScored();
     this->_match->playerPoints(team, _playerInPossession)->tryScored();
+    this->recordEvent(MatchEvent::Type::TRY, team, _playerInPossession);
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
-        _mw->updateStatisticsUI(team, QStringLiteral("TriesLabel"), QString::number(currentValueTries));
+        _observer->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
+        _observer->updateStatisticsUI(team, QStringLiteral("TriesLabel"), QString::number(currentValueTries));
 
         // bonus point try
         const bool bonusPoint = (currentValueTries == matchPoints.NoOfTriesForBonusPoint);
-        if (bonusPoint) {
-
-            const QString prefix = (team == MatchType::Location::HOSTS) ? on::shared.hostsPrefix : on::shared.visitorsPrefix;
-            const QString labelName = prefix + QStringLiteral("BonusPointLabel");
-            QLabel * const bonusPointLabel = _mw->findChild<QLabel *>(labelName, Qt::FindDirectChildrenOnly);
-
-            bonusPointLabel->setStyleSheet(ss::shared.style(ss::matchwidget.BonusPointStyleEnabled));
-        }
+        if (bonusPoint)
+            _observer->bonusPointGained(team);
 
         this->refreshPointsList(team);
 
         // display current score in log
-        const QString bonusPointTry = (bonusPoint) ? QStringLiteral(" [bonus point try]") : QString();
-        const QString tryScoredText = QStringLiteral("Try scored by: ") % _playerInPossession->fullName() % ", " %
-                                      _teamInPossession->name() % _mw->pointsInfoForLog(pointValue.Try) % bonusPointTry;
-        _mw->logRecord(tryScoredText);
-        _mw->logRecord(_mw->currentScore());
+        if (this->logOn()) {
+
+            const QString bonusPointTry = (bonusPoint) ? QStringLiteral(" [bonus point try]") : QString();
+            const QString tryScoredText = QStringLiteral("Try scored by: ") % _playerInPossession->fullName() % ", " %
+                                          _teamInPossession->name() % _observer->pointsInfoForLog(pointValue.Try) % bonusPointTry;
+            _observer->logRecord(tryScoredText);
+            _observer->logRecord(_observer->currentScore());
+        }
 
         // show information message
-        _mw->timeStoppedMessageBox("tryScored", { _playerInPossession->fullName(), _teamInPossession->name(),
+        _observer->timeStoppedMessageBox("tryScored", { _playerInPossession->fullName(), _teamInPossession->name(),
                                                   QString::number(this->_match->score(team)->points(PointEvent::TRY)) });
     }
-    if (this->displayOn(FW))
-        _fw->updateScore(team);
+    if (this->displayOn(MatchDisplay::PROGRESS))
+        _observer->updateScore(team);
 
     this->changeInMorale(_teamInPossession, true);
 
@@ -1212,25 +1210,29 @@ timePassed GamePlay::dropGoalScored() {
     const uint8_t currentValueDropGoals = this->_match->score(team)->dropScored();
     _playerInPossession->points()->dropGoalScored();
     this->_match->playerPoints(team, _playerInPossession)->dropGoalScored();
+    this->recordEvent(MatchEvent::Type::DROP_GOAL, team, _playerInPossession);
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
-        _mw->updateStatisticsUI(team, QStringLiteral("DropGoalsLabel"), QString::number(currentValueDropGoals));
+        _observer->updateStatisticsUI(team, QStringLiteral("PointsLabel"), QString::number(this->_match->score(team)->points()));
+        _observer->updateStatisticsUI(team, QStringLiteral("DropGoalsLabel"), QString::number(currentValueDropGoals));
 
         this->refreshPointsList(team);
 
         // display current score in log
-        const QString dropGoalScoredText = QStringLiteral("Drop goal scored by: ") % _playerInPossession->fullName() %
-                                           ", " % _teamInPossession->name() % _mw->pointsInfoForLog(pointValue.DropGoal);
-        _mw->logRecord(dropGoalScoredText);
-        _mw->logRecord(_mw->currentScore());
+        if (this->logOn()) {
+
+            const QString dropGoalScoredText = QStringLiteral("Drop goal scored by: ") % _playerInPossession->fullName() %
+                                               ", " % _teamInPossession->name() % _observer->pointsInfoForLog(pointValue.DropGoal);
+            _observer->logRecord(dropGoalScoredText);
+            _observer->logRecord(_observer->currentScore());
+        }
 
         // show information message
-        _mw->timeStoppedMessageBox("dropGoalScored", { _playerInPossession->fullName(), _teamInPossession->name() });
+        _observer->timeStoppedMessageBox("dropGoalScored", { _playerInPossession->fullName(), _teamInPossession->name() });
     }
-    if (this->displayOn(FW))
-        _fw->updateScore(team);
+    if (this->displayOn(MatchDisplay::PROGRESS))
+        _observer->updateScore(team);
 
     this->changeInMorale(_playerInPossession, true);
 
@@ -1239,8 +1241,8 @@ timePassed GamePlay::dropGoalScored() {
     this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
     this->_restartPlay = true;
 
-    if (this->displayOn(MW))
-        _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
 
     return timeForGameAction.DROP_GOAL;
 }
@@ -1249,11 +1251,12 @@ void GamePlay::ballCarried() {
 
     const MatchType::Location team = this->whoIsInPossession().first;
     const QString newValueCarries = QString::number(this->_match->score(team)->carries());
+    this->recordEvent(MatchEvent::Type::CARRY, team);
 
     this->updateStatistics(team, StatsType::NumberOf::CARRIES, _playerInPossession);
 
-    if (this->displayOn(MW))
-        _mw->updateStatisticsUI(team, QStringLiteral("CarriesLabel"), newValueCarries);
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updateStatisticsUI(team, QStringLiteral("CarriesLabel"), newValueCarries);
 
     // toggle back to true after player in possession changes
     this->_incrementCarries = false;
@@ -1265,21 +1268,22 @@ void GamePlay::ballPassed(const MatchScore::Passes pass) {
 
     MatchType::Location team = this->whoIsInPossession().first;
     this->_match->score(team)->passAttempted(pass);
+    this->recordEvent(MatchEvent::Type::PASS, team, nullptr, 0, static_cast<uint8_t>(pass));
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
         // update passes' (either completed or missed) stats (team in possession)
         const QString passesLabelName = (pass == MatchScore::Passes::COMPLETED) ?
             QStringLiteral("PassesCompletedLabel") : QStringLiteral("PassesMissedLabel");
         const QString newValuePasses = QString::number(this->_match->score(team)->passes(pass));
-        _mw->updateStatisticsUI(team, passesLabelName, newValuePasses);
+        _observer->updateStatisticsUI(team, passesLabelName, newValuePasses);
 
         // update passes' (made in total) stats
         const QString newValuePassesMade = QString::number(this->_match->score(team)->passes(MatchScore::Passes::ATTEMPTED));
-        _mw->updateStatisticsUI(team, QStringLiteral("PassesMadeLabel"), newValuePassesMade);
+        _observer->updateStatisticsUI(team, QStringLiteral("PassesMadeLabel"), newValuePassesMade);
 
         // update passes' success rate stats
-        _mw->updateStatisticsUI(team, QStringLiteral("PassesSuccessRateLabel"), this->_match->score(team)->passesSuccessRate());
+        _observer->updateStatisticsUI(team, QStringLiteral("PassesSuccessRateLabel"), this->_match->score(team)->passesSuccessRate());
     }
 
     return;
@@ -1298,14 +1302,16 @@ timePassed GamePlay::scrum() {
     this->changePlayerInPossessionToSpecialist(player::PreferredForAction::SCRUM);
 
     // display in log
-    const QString scrumInOwn22 = (metresFromGoalLine <= groundDimensions.fromGoalLineTo22metreLine)
-        ? QStringLiteral(" (") % QString::number(metresFromGoalLine) % QStringLiteral(" m)") : QString();
-    const QString scrumAwardedToText = QStringLiteral("Scrum awarded to: ") % this->_teamInPossession->name() % scrumInOwn22;
-    if (this->displayOn(MW))
-        _mw->logRecord(scrumAwardedToText);
+    if (this->logOn()) {
+
+        const QString scrumInOwn22 = (metresFromGoalLine <= groundDimensions.fromGoalLineTo22metreLine)
+            ? QStringLiteral(" (") % QString::number(metresFromGoalLine) % QStringLiteral(" m)") : QString();
+        const QString scrumAwardedToText = QStringLiteral("Scrum awarded to: ") % this->_teamInPossession->name() % scrumInOwn22;
+        _observer->logRecord(scrumAwardedToText);
+    }
 
     // is ball thrown straight into the scrum?
-    const bool thrownInStraight = RandomValue::generateRandomBool(
+    const bool thrownInStraight = this->_random.generateRandomBool(
         this->_settings->matchActivities().probability(MatchActionSubtype::SCRUM_BALL_THROWN_STRAIGHT));
 
     // if not thrown straight, free kick is awarded to the opponent
@@ -1314,10 +1320,10 @@ timePassed GamePlay::scrum() {
         this->changeBallPossession(_teamInPossession);
         this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
 
-        if (this->displayOn(MW)) {
+        if (this->displayOn(MatchDisplay::DETAIL)) {
 
-            _mw->logRecord(QStringLiteral("Ball was not thrown straight into the scrum."));
-            _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+            _observer->logRecord(QStringLiteral("Ball was not thrown straight into the scrum."));
+            _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
         }
 
         return (timeForGameAction.SCRUM / 2);
@@ -1337,10 +1343,10 @@ timePassed GamePlay::scrum() {
     const int16_t packWeightsDiff = teamPackWeight - opponentPackWeight;
     const int8_t compensationCoeff = (packWeightsDiff == std::abs(packWeightsDiff))
         ? std::min(packWeightsDiff/10, 5) : std::max(packWeightsDiff/10, -5);
-    const uint16_t scrum = RandomValue::generateRandomInt<uint16_t>(6-compensationCoeff, 120);
+    const uint16_t scrum = this->_random.generateRandomInt<uint16_t>(6-compensationCoeff, 120);
 
     const MatchActionSubtype::MatchActivityType scrumResult =
-        _settings->matchActivities().action(scrum, MatchActionType::MatchActivityBaseType::SCRUM);
+        this->activityOutcome(scrum, MatchActionType::MatchActivityBaseType::SCRUM);
     QString infringementDescription = MatchScore::unknownValue;
 
     switch (scrumResult) {
@@ -1352,7 +1358,7 @@ timePassed GamePlay::scrum() {
         case MatchActionSubtype::SCRUM_NOT_PUSHING_STRAIGHT: {
 
             infringementDescription.clear(); // null value means an infringements has occurred
-            infringementByTeamInPossession = RandomValue::generateRandomBool(25);
+            infringementByTeamInPossession = this->_random.generateRandomBool(25);
             scrumResultForTeamInPossession = (infringementByTeamInPossession)
                                            ? MatchScore::Scrums::LOST : MatchScore::Scrums::WON;
             break;
@@ -1363,24 +1369,26 @@ timePassed GamePlay::scrum() {
 
     // update team-in-possession's statistics
     this->_match->score(team)->scrumThrown(scrumResultForTeamInPossession);
+    this->recordEvent(MatchEvent::Type::SCRUM, team, nullptr, 0, static_cast<uint8_t>(scrumResultForTeamInPossession));
 
     // team that threw in the ball has won
     if (scrumResultForTeamInPossession == MatchScore::Scrums::WON) {
 
         // update opponent's statistics
         this->_match->score(opponent)->scrumThrown(MatchScore::Scrums::LOST);
+        this->recordEvent(MatchEvent::Type::SCRUM, opponent, nullptr, 0, static_cast<uint8_t>(MatchScore::Scrums::LOST));
 
-        if (this->displayOn(MW)) {
+        if (this->displayOn(MatchDisplay::DETAIL)) {
 
             const QString newValueScrumsWon = QString::number(this->_match->score(team)->scrums(scrumResultForTeamInPossession));
-            _mw->updateStatisticsUI(team, QStringLiteral("ScrumsWonLabel"), newValueScrumsWon);
+            _observer->updateStatisticsUI(team, QStringLiteral("ScrumsWonLabel"), newValueScrumsWon);
 
             const QString newValueScrumsLost = QString::number(this->_match->score(opponent)->scrums(MatchScore::Scrums::LOST));
-            _mw->updateStatisticsUI(opponent, QStringLiteral("ScrumsLostLabel"), newValueScrumsLost);
+            _observer->updateStatisticsUI(opponent, QStringLiteral("ScrumsLostLabel"), newValueScrumsLost);
 
             // display scrum result in log
-            const QString scrumResultText = QStringLiteral("Scrum won by: ") + this->_match->team(team)->name();
-            _mw->logRecord(scrumResultText);
+            if (this->logOn())
+                _observer->logRecord(QStringLiteral("Scrum won by: ") % this->_match->team(team)->name());
         }
     }
 
@@ -1389,21 +1397,19 @@ timePassed GamePlay::scrum() {
 
         // update opponent's statistics
         this->_match->score(opponent)->scrumThrown(MatchScore::Scrums::WON);
+        this->recordEvent(MatchEvent::Type::SCRUM, opponent, nullptr, 0, static_cast<uint8_t>(MatchScore::Scrums::WON));
 
-        if (this->displayOn(MW)) {
+        if (this->displayOn(MatchDisplay::DETAIL)) {
 
             const QString newValueScrumsWon = QString::number(this->_match->score(opponent)->scrums(MatchScore::Scrums::WON));
-            _mw->updateStatisticsUI(opponent, QStringLiteral("ScrumsWonLabel"), newValueScrumsWon);
+            _observer->updateStatisticsUI(opponent, QStringLiteral("ScrumsWonLabel"), newValueScrumsWon);
 
             const QString newValueScrumsLost = QString::number(this->_match->score(team)->scrums(scrumResultForTeamInPossession));
-            _mw->updateStatisticsUI(team, QStringLiteral("ScrumsLostLabel"), newValueScrumsLost);
+            _observer->updateStatisticsUI(team, QStringLiteral("ScrumsLostLabel"), newValueScrumsLost);
 
             // display scrum result in log (but not in case of an infringement)
-            if (infringementDescription == MatchScore::unknownValue) {
-
-                const QString scrumResultText = QStringLiteral("Scrum won by: ") + this->_match->team(opponent)->name();
-                _mw->logRecord(scrumResultText);
-            }
+            if (infringementDescription == MatchScore::unknownValue && this->logOn())
+                _observer->logRecord(QStringLiteral("Scrum won by: ") % this->_match->team(opponent)->name());
         }
     }
 
@@ -1412,8 +1418,8 @@ timePassed GamePlay::scrum() {
 
         case MatchActionSubtype::SCRUM_COLLAPSED: {
 
-            if (this->displayOn(MW))
-                _mw->logRecord(message.display(this->scrumInfringement(), QStringLiteral("scrumCollapsed")));
+            if (this->logOn())
+                this->logMessage(this->scrumInfringement(), QStringLiteral("scrumCollapsed"));
 
             this->refreshTime(timeForGameAction.SCRUM/2, false);
             const timePassed timePassed = this->scrum();
@@ -1429,12 +1435,13 @@ timePassed GamePlay::scrum() {
             if (infringementDescription.isNull())
                 infringementDescription = QStringLiteral("notPushingStraight");
 
-            const QStringList teams = (!infringementByTeamInPossession)
-                ? QStringList { this->_match->team(opponent)->name(), this->_match->team(team)->name() }
-                : QStringList { this->_match->team(team)->name(), this->_match->team(opponent)->name() };
+            if (this->logOn()) {
 
-            if (this->displayOn(MW))
-               _mw->logRecord(message.displayWithReplace(this->scrumInfringement(), infringementDescription, teams));
+                const QStringList teams = (!infringementByTeamInPossession)
+                    ? QStringList { this->_match->team(opponent)->name(), this->_match->team(team)->name() }
+                    : QStringList { this->_match->team(team)->name(), this->_match->team(opponent)->name() };
+                this->logMessage(this->scrumInfringement(), infringementDescription, teams);
+            }
 
             if (infringementByTeamInPossession)
                 this->changeBallPossession(this->_teamInPossession);
@@ -1466,11 +1473,11 @@ timePassed GamePlay::lineOutIsThrowed() {
 
     this->changePlayerInPossessionToSpecialist(player::PreferredForAction::LINEOUT);
 
-    if (this->displayOn(MW))
-        _mw->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updatePlayer(_playerInPossession->fullName(), this->whoIsInPossession().first);
 
     // is lineout thrown straight (and goes at least 5 m)?
-    const bool straight = RandomValue::generateRandomBool(
+    const bool straight = this->_random.generateRandomBool(
         this->_settings->matchActivities().probability(MatchActionSubtype::LINEOUT_STRAIGHT));
 
     // if lineout is not thrown straight (or touches the ground less than 5m from the touch-line),
@@ -1484,32 +1491,31 @@ timePassed GamePlay::lineOutIsThrowed() {
 
     // who has won the lineout?
     const uint8_t probability = this->probability(MatchActionSubtype::LINEOUT_WON);
-    const MatchScore::Lineouts lineoutWon = static_cast<MatchScore::Lineouts>(RandomValue::generateRandomBool(probability));
+    const MatchScore::Lineouts lineoutWon = static_cast<MatchScore::Lineouts>(this->_random.generateRandomBool(probability));
     this->_match->score(team)->lineoutThrown(lineoutWon);
+    this->recordEvent(MatchEvent::Type::LINEOUT, team, nullptr, 0, static_cast<uint8_t>(lineoutWon));
 
     // update lineouts' thrown-in-total stats
     const QString newValueLineoutsThrown = QString::number(this->_match->score(team)->lineouts(MatchScore::Lineouts::THROWN));
     // update lineouts' won/lost stats
     const QString newValueLineoutsWonOrLost = QString::number(this->_match->score(team)->lineouts(lineoutWon));
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-        _mw->updateStatisticsUI(team, QStringLiteral("LineoutsThrownLabel"), newValueLineoutsThrown);
-        _mw->updateStatisticsUI(team, QStringLiteral("LineoutsSuccessRateLabel"), this->_match->score(team)->lineoutsSuccessRate());
+        _observer->updateStatisticsUI(team, QStringLiteral("LineoutsThrownLabel"), newValueLineoutsThrown);
+        _observer->updateStatisticsUI(team, QStringLiteral("LineoutsSuccessRateLabel"), this->_match->score(team)->lineoutsSuccessRate());
 
         // display lineout result in log
-        QString lineoutThrownText = QStringLiteral("Lineout awarded to: ") % this->_teamInPossession->name() % QStringLiteral(" (won)");
-        if (lineoutWon == MatchScore::Lineouts::LOST)
-            lineoutThrownText.replace("won", "lost");
-
-        _mw->logRecord(lineoutThrownText);
+        if (this->logOn())
+            _observer->logRecord(QStringLiteral("Lineout awarded to: ") % this->_teamInPossession->name() %
+                ((lineoutWon == MatchScore::Lineouts::LOST) ? QStringLiteral(" (lost)") : QStringLiteral(" (won)")));
     }
 
     // team that threw in the ball has won
     if (lineoutWon == MatchScore::Lineouts::WON) {
 
-        if (this->displayOn(MW))
-            _mw->updateStatisticsUI(team, QStringLiteral("LineoutsWonLabel"), newValueLineoutsWonOrLost);
+        if (this->displayOn(MatchDisplay::DETAIL))
+            _observer->updateStatisticsUI(team, QStringLiteral("LineoutsWonLabel"), newValueLineoutsWonOrLost);
 
         // is maul formed? - TO DO
     }
@@ -1518,10 +1524,10 @@ timePassed GamePlay::lineOutIsThrowed() {
     if (lineoutWon == MatchScore::Lineouts::LOST) {
 
         // team that threw in has lost = team that didn't throw in has stolen the lineout
-        if (this->displayOn(MW)) {
+        if (this->displayOn(MatchDisplay::DETAIL)) {
 
             const MatchType::Location opponent = this->whoIsInPossession().second;
-            _mw->updateStatisticsUI(opponent, QStringLiteral("LineoutsStolenLabel"), newValueLineoutsWonOrLost);
+            _observer->updateStatisticsUI(opponent, QStringLiteral("LineoutsStolenLabel"), newValueLineoutsWonOrLost);
         }
     }
 
@@ -1541,9 +1547,9 @@ bool GamePlay::dangerousTackle(Player * const tacklingPlayer, const player::Tack
     // is player sin-binned or sent-off (or possibly warned only)?
     const uint8_t probabilityFrom = PlayerCondition::minValue + PlayerCondition::maxValue -
                                     tacklingPlayer->condition(player::Conditions::MORALE);
-    const uint8_t punishment = RandomValue::generateRandomInt<uint8_t>(probabilityFrom, 100);
+    const uint8_t punishment = this->_random.generateRandomInt<uint8_t>(probabilityFrom, 100);
     MatchActionSubtype::MatchActivityType punishmentType =
-        _settings->matchActivities().action(punishment, MatchActionType::MatchActivityBaseType::FOUL_PLAY);
+        this->activityOutcome(punishment, MatchActionType::MatchActivityBaseType::FOUL_PLAY);
 
     // in case of second yellow card it's a sent-off
     const uint8_t numberOfYellowCardsForPlayer =
@@ -1564,18 +1570,22 @@ bool GamePlay::dangerousTackle(Player * const tacklingPlayer, const player::Tack
             numberOfCardsForTeam = this->_match->score(opponent)->yellowCards();
             tacklingPlayer->stats()->incrementStatsValue(StatsType::NumberOf::YELLOW_CARDS);
             this->_match->playerStats(opponent, tacklingPlayer)->incrementStatsValue(StatsType::NumberOf::YELLOW_CARDS);
+            this->recordEvent(MatchEvent::Type::YELLOW_CARD, opponent, tacklingPlayer);
+            this->recordEvent(MatchEvent::Type::PLAYER_STATS, opponent, tacklingPlayer, 0,
+                              static_cast<uint8_t>(StatsType::NumberOf::YELLOW_CARDS));
 
             this->_match->addSuspension(tacklingPlayer, tacklingPlayer->noOnPitch(), opponent, punishmentType);
             tacklingPlayer->withdrawPlayer();
+            this->_match->team(opponent)->lineupChanged();
             penalized = true;
 
-            if (this->displayOn(MW)) {
+            if (this->displayOn(MatchDisplay::DETAIL)) {
 
                 // display in log
                 messageBoxKey = QStringLiteral("playerSinBinned");
-                const QString playerSinBinnedMessage = message.displayWithReplace(this->objectName(), messageBoxKey,
-                    { tacklingPlayer->fullName(), this->_match->team(opponent)->name(), QString::number(::penalty.Minutes) });
-                _mw->logRecord(playerSinBinnedMessage);
+                if (this->logOn())
+                    this->logMessage(this->objectName(), messageBoxKey, { tacklingPlayer->fullName(),
+                                     this->_match->team(opponent)->name(), QString::number(::penalty.Minutes) });
 
                 label = QStringLiteral("YellowCardsLabel");
             }
@@ -1588,19 +1598,23 @@ bool GamePlay::dangerousTackle(Player * const tacklingPlayer, const player::Tack
             numberOfCardsForTeam = this->_match->score(opponent)->redCards();
             tacklingPlayer->stats()->incrementStatsValue(StatsType::NumberOf::RED_CARDS);
             this->_match->playerStats(opponent, tacklingPlayer)->incrementStatsValue(StatsType::NumberOf::RED_CARDS);
+            this->recordEvent(MatchEvent::Type::RED_CARD, opponent, tacklingPlayer);
+            this->recordEvent(MatchEvent::Type::PLAYER_STATS, opponent, tacklingPlayer, 0,
+                              static_cast<uint8_t>(StatsType::NumberOf::RED_CARDS));
 
             this->_match->addSuspension(tacklingPlayer, tacklingPlayer->noOnPitch(), opponent, punishmentType);
             tacklingPlayer->withdrawPlayer();
+            this->_match->team(opponent)->lineupChanged();
             penalized =  true;
             tacklingPlayer->sentOff();
 
-            if (this->displayOn(MW)) {
+            if (this->displayOn(MatchDisplay::DETAIL)) {
 
                 // display in log
                 messageBoxKey = QStringLiteral("playerSentOff");
-                const QString playerSentOffMessage = message.displayWithReplace(this->objectName(), messageBoxKey,
-                    { tacklingPlayer->fullName(), this->_match->team(opponent)->name() });
-                _mw->logRecord(playerSentOffMessage);
+                if (this->logOn())
+                    this->logMessage(this->objectName(), messageBoxKey,
+                                     { tacklingPlayer->fullName(), this->_match->team(opponent)->name() });
 
                 label = QStringLiteral("RedCardsLabel");
             }
@@ -1610,19 +1624,19 @@ bool GamePlay::dangerousTackle(Player * const tacklingPlayer, const player::Tack
         default: break;
     }
 
-    if (this->displayOn(MW) && !label.isNull()) {
+    if (this->displayOn(MatchDisplay::DETAIL) && !label.isNull()) {
 
-        _mw->updateStatisticsUI(opponent, label, QString::number(numberOfCardsForTeam));
+        _observer->updateStatisticsUI(opponent, label, QString::number(numberOfCardsForTeam));
         this->refreshPointsList(opponent);
 
-        _mw->updatePackWeight();
+        _observer->updatePackWeight();
 
         // show information message
         const uint8_t numberOfPlayersOnPitch = this->_match->team(opponent)->numberOfPlayersOnPitch();
         const QString suspensionReasonMessage = ::message.display(this->dangerousTackle(),
                                                 player::dangerousPlayReasonDescription[type_of_tackle]);
 
-        _mw->timeStoppedMessageBox(messageBoxKey, { tacklingPlayer->fullName(), this->_match->team(opponent)->name(),
+        _observer->timeStoppedMessageBox(messageBoxKey, { tacklingPlayer->fullName(), this->_match->team(opponent)->name(),
             QString::number(::penalty.Minutes), QString::number(numberOfPlayersOnPitch), this->_match->referee()->referee(),
             suspensionReasonMessage });
     }
@@ -1637,15 +1651,15 @@ bool GamePlay::playerInjured(Player * const player, bool injured) const {
         const uint8_t probabilityOfInjury = 50 + (player->attribute(player::Attributes::AGILITY) * 2 +
                                                   player->attribute(player::Attributes::DEXTERITY) * 5 +
                                                   player->attribute(player::Attributes::TACKLING) * 3) / 2;
-        injured = RandomValue::generateRandomBool(100 - probabilityOfInjury);
+        injured = this->_random.generateRandomBool(100 - probabilityOfInjury);
     }
 
     if (injured) {
 
         // add new record to PlayerHealth
         player->condition()->newHealthIssue(this->_dateTime.systemDate(), player::HealthStatus::INJURY,
-                                                                          player::HealthStatus::SERIOUS_INJURY);
-        if (this->displayOn(MW)) {
+                                                                          player::HealthStatus::SERIOUS_INJURY, &this->_random);
+        if (this->displayOn(MatchDisplay::DETAIL)) {
 
             const QString reasonOfAbsence = player->availability(player::Conditions::AVAILABILITY, this->_dateTime.systemDate());
             const QString team = _myTeam->teamName(player);
@@ -1653,16 +1667,16 @@ bool GamePlay::playerInjured(Player * const player, bool injured) const {
             // display message box
             const QString dialogTextKey = (_myTeam->squad().contains(player))
                 ? QStringLiteral("playerMustBeReplaced") : QStringLiteral("opponentPlayerInjured");
-            const QString dialogText = message.displayWithReplace(this->playerSubstitution(),
-                dialogTextKey, { player->fullName(), QString::number(player->shirtNo()), reasonOfAbsence });
+            const QString dialogText = MessageTemplate::find(this->playerSubstitution(), dialogTextKey).format(
+                { player->fullName(), QString::number(player->shirtNo()), reasonOfAbsence });
             const QString dialogTitle = QStringLiteral("Health report (") % team % QStringLiteral(")");
 
-            QMessageBox::critical(nullptr, dialogTitle, dialogText);
+            _observer->notify(GamePlayObserver::Notification::CRITICAL, dialogTitle, dialogText);
 
             // display in log
-            const QString logMessage = player->fullName() % string_functions.wrapInBrackets(team) %
-                                       QStringLiteral("has been ") % reasonOfAbsence % QStringLiteral(".");
-            _mw->logRecord(logMessage);
+            if (this->logOn())
+                _observer->logRecord(player->fullName() % string_functions.wrapInBrackets(team) %
+                                     QStringLiteral("has been ") % reasonOfAbsence % QStringLiteral("."));
         }
     }
 
@@ -1679,23 +1693,24 @@ MatchScore::Tackles GamePlay::playerIsTackled() {
                                   this->probability(MatchActionSubtype::RUN_TACKLE_COMPLETED, true);
     const uint8_t probability = std::min(static_cast<uint8_t>(std::round(probabilityRaw)), static_cast<uint8_t>(100));
 
-    const MatchScore::Tackles tackleCompleted = static_cast<MatchScore::Tackles>(RandomValue::generateRandomBool(probability));
+    const MatchScore::Tackles tackleCompleted = static_cast<MatchScore::Tackles>(this->_random.generateRandomBool(probability));
     this->_match->score(team)->tackleAttempted(tackleCompleted);
+    this->recordEvent(MatchEvent::Type::TACKLE, team, nullptr, 0, static_cast<uint8_t>(tackleCompleted));
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
         // update tackles' (either completed or missed) stats (team not in possession)
         const QString tacklesLabelName = (tackleCompleted == MatchScore::Tackles::COMPLETED) ?
             QStringLiteral("TacklesCompletedLabel") : QStringLiteral("TacklesMissedLabel");
         const QString newValueTackles = QString::number(this->_match->score(team)->tackles(tackleCompleted));
-        _mw->updateStatisticsUI(team, tacklesLabelName, newValueTackles);
+        _observer->updateStatisticsUI(team, tacklesLabelName, newValueTackles);
 
         // update tackles' (made in total) stats
         const QString newValueTacklesMade = QString::number(this->_match->score(team)->tackles(MatchScore::Tackles::ATTEMPTED));
-        _mw->updateStatisticsUI(team, QStringLiteral("TacklesMadeLabel"), newValueTacklesMade);
+        _observer->updateStatisticsUI(team, QStringLiteral("TacklesMadeLabel"), newValueTacklesMade);
 
         // update tackles' success rate stats
-        _mw->updateStatisticsUI(team, QStringLiteral("TacklesSuccessRateLabel"), this->_match->score(team)->tacklesSuccessRate());
+        _observer->updateStatisticsUI(team, QStringLiteral("TacklesSuccessRateLabel"), this->_match->score(team)->tacklesSuccessRate());
     }
 
     return tackleCompleted;
@@ -1710,9 +1725,10 @@ bool GamePlay::playerIsRunning(uint8_t & metresMade) {
     metresMade = static_cast<uint8_t>(static_cast<int8_t>(metresMade) + std::min<int8_t>(0, this->distanceToGoalLine()));
     _playerInPossession->stats()->addMetresRun(metresMade);
     const uint16_t newValue = this->_match->score(team)->run(metresMade);
+    this->recordEvent(MatchEvent::Type::RUN, team, _playerInPossession, metresMade);
 
-    if (this->displayOn(MW))
-        _mw->updateStatisticsUI(team, QStringLiteral("MetresMadeByRunningLabel"), QString::number(newValue));
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updateStatisticsUI(team, QStringLiteral("MetresMadeByRunningLabel"), QString::number(newValue));
 
     // if goal line has been crossed (possibly a try)
     if (this->distanceToGoalLine() < 0)
@@ -1728,24 +1744,22 @@ void GamePlay::playerIsKicking(const uint8_t metresMade) {
     // update metres-made-by-kicking stats
     _playerInPossession->stats()->addMetresKicked(metresMade);
     const uint16_t newValue = this->_match->score(team)->kick(metresMade);
+    this->recordEvent(MatchEvent::Type::KICK, team, _playerInPossession, metresMade);
 
-    if (this->displayOn(MW))
-        _mw->updateStatisticsUI(team, QStringLiteral("MetresMadeByKickingLabel"), QString::number(newValue));
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->updateStatisticsUI(team, QStringLiteral("MetresMadeByKickingLabel"), QString::number(newValue));
 
     return;
 }
 
-// true = player injured because of low fatigue
-bool GamePlay::changeInFatigue(Player * const player) const {
+// fatigue itself has been changed already (see ConditionBatch::changeFatigue); return value: true = player must be
+// (or should be) replaced
+bool GamePlay::changeInFatigue(const ConditionBatch::Event & event) const {
 
-    const uint8_t probabilityOfDecrease = 72 - player->attribute(player::Attributes::ENDURANCE) * 2;
-    const bool fatigueDecrease = RandomValue::generateRandomBool(probabilityOfDecrease);
-
-    if (!fatigueDecrease)
-        return false;
+    Player * const player = event.player;
 
-    // if fatigue is at minimum level already, don't decrease it's value; declare player injured instead
-    if (player->condition(player::Conditions::FATIGUE) == PlayerCondition::minValue) {
+    // fatigue was at minimum level already => player is injured
+    if (event.crossing == ConditionBatch::Crossing::EXHAUSTED) {
 
         const bool substitution = this->playerInjured(player, true);
 
@@ -1753,45 +1767,35 @@ bool GamePlay::changeInFatigue(Player * const player) const {
         return substitution;
     }
 
-    player->condition()->decreaseCondition(player::Conditions::FATIGUE, static_cast<uint8_t>(fatigueDecrease));
-
-    ConditionThresholds::ConditionValue severity = ConditionThresholds::ConditionValue::NORMAL;
-    const uint8_t fatigueNewValue = player->condition(player::Conditions::FATIGUE, severity);
-
-    if (severity == ConditionThresholds::ConditionValue::CRITICAL) {
-
-        // other teams' players are replaced whenever this situation arises
-        QMessageBox::StandardButton substitution = QMessageBox::StandardButton::Ok;
-
-        if (this->displayOn(MW) && _myTeam->squad().contains(player)) {
+    // other teams' players are replaced whenever this situation arises
+    bool substitution = true;
 
-            const QString dialogText = message.displayWithReplace(this->playerSubstitution(), "playerShouldBeReplaced",
-                { player->fullName(), QString::number(player->shirtNo()), QString::number(fatigueNewValue) } );
-            substitution = QMessageBox::warning(nullptr, QStringLiteral("Player's fatigue very low."), dialogText);
-        }
+    if (this->displayOn(MatchDisplay::DETAIL) && _myTeam->squad().contains(player)) {
 
-        // voluntary replacement
-        return (substitution == QMessageBox::StandardButton::Ok);
+        const QString dialogText = MessageTemplate::find(this->playerSubstitution(), QStringLiteral("playerShouldBeReplaced")).format(
+            { player->fullName(), QString::number(player->shirtNo()), QString::number(event.fatigue) } );
+        substitution = _observer->substituteTiredPlayer(dialogText);
     }
 
-    return false;
+    // voluntary replacement
+    return substitution;
 }
 
 void GamePlay::changeInMorale(Team * const team, const bool increase, const uint8_t number) const {
 
-    for (auto player: team->squad()) {
-
-        if (!player->isOnPitch())
-            continue;
+    const MatchType::Location loc = (team == this->_match->team(MatchType::Location::HOSTS))
+                                  ? MatchType::Location::HOSTS : MatchType::Location::VISITORS;
+    ConditionBatch batch;
+    for (auto player: team->playersOnPitch())
+        batch.add(player, loc);
 
-        this->changeInMorale(player, increase, number);
-    }
+    batch.changeMorale(this->_random, increase, number);
     return;
 }
 
 bool GamePlay::changeInMorale(Player * const player, const bool increase, const uint8_t number) const {
 
-    if (RandomValue::generateRandomBool(25)) {
+    if (this->_random.generateRandomBool(25)) {
 
         PlayerCondition * const pc = player->condition();
         pc->changeCondition = (increase) ? &PlayerCondition::increaseCondition : &PlayerCondition::decreaseCondition;
@@ -1810,63 +1814,93 @@ void GamePlay::suspensionsUpdate(const uint8_t minutes) {
     uint8_t listsToRefresh = 0;
     this->_match->deductSuspensionMinutesRemaining(playersBackOnPitch, listsToRefresh, minutes);
 
-    // players returning after suspension
-    for (auto player: playersBackOnPitch) {
-
-        // original position is assigned back to player going out of sin-bin
+    // players returning after suspension: original position is assigned back to player going out of sin-bin
+    for (auto player: playersBackOnPitch)
         player.first->introducePlayer(player.second);
 
-        if (this->displayOn(MW)) {
+    // on-pitch index of affected teams is rebuilt only after all of them are back on pitch and before anything
+    // is displayed (message box runs event loop => index may be queried meanwhile)
+    if ((listsToRefresh & 1) == 1)
+        this->_match->team(MatchType::Location::HOSTS)->lineupChanged();
+    if ((listsToRefresh & 2) == 2)
+        this->_match->team(MatchType::Location::VISITORS)->lineupChanged();
+
+    if (this->displayOn(MatchDisplay::DETAIL)) {
+
+        for (auto player: playersBackOnPitch) {
 
             // display in log
-            const QString playerBackFromSinBinMessage =
-                player.first->fullName() + QStringLiteral(" is back on pitch (after suspension).");
-            _mw->logRecord(playerBackFromSinBinMessage);
+            if (this->logOn())
+                _observer->logRecord(player.first->fullName() % QStringLiteral(" is back on pitch (after suspension)."));
 
             // show information message
-            _mw->timeStoppedMessageBox("playerBackFromSinBin", { player.first->fullName() } );
+            _observer->timeStoppedMessageBox("playerBackFromSinBin", { player.first->fullName() } );
         }
     }
 
-    // update points' lists
-    if (this->displayOn(MW)) {
+    // update points' lists (only if someone has returned)
+    if (this->displayOn(MatchDisplay::DETAIL) && listsToRefresh != 0) {
 
         if ((listsToRefresh & 1) == 1)
             this->refreshPointsList(MatchType::Location::HOSTS);
         if ((listsToRefresh & 2) == 2)
             this->refreshPointsList(MatchType::Location::VISITORS);
 
-        _mw->updatePackWeight();
+        _observer->updatePackWeight();
     }
 
     return;
 }
 
+// substitutes of given team are indexed by position base type (see Team::buildBench); player has played in this match
+// if his stats record counts a game played
+void GamePlay::buildBench(const MatchType::Location loc) {
+
+    this->_match->team(loc)->buildBench([this, loc](Player * const player) -> bool {
+
+        return (this->_match->playerStats(loc, player) != nullptr && !this->_match->playerStats(loc, player)->noMatchesPlayed());
+    });
+
+    return;
+}
+
 // returns true if playerPossiblyGoingIn can be used as substitution player
+// bench index holds healthy players on bench of the same position base type only: a player may have been injured earlier
+// during current match so although he's on the bench (_noOnPitch == 0) such a player is not available for selection
+// (not even for another injured player which would be otherwise possible); an already (tactically) replaced player
+// is allowed to return to play when replacing injured player
 bool GamePlay::isEligibleForSubstitution(Player * const playerGoingOut, Player * const playerPossiblyGoingIn,
                                          const MatchType::Location loc, const bool injuryReplacement) const {
 
     const PlayerPosition_index_item::PositionBaseType baseType =
         playerPosition_index.findPositionBaseTypeByType(playerGoingOut->position()->positionType());
 
-    return // an already (tactically) replaced player is allowed to return to play when replacing injured player [a)]
-        playerPosition_index.findPositionBaseTypeByType(playerPossiblyGoingIn->position()->positionType()) == baseType &&
-        playerPossiblyGoingIn->isOnBench() && (this->_match->playerStats(loc, playerPossiblyGoingIn) == nullptr ||
-        this->_match->playerStats(loc, playerPossiblyGoingIn)->noMatchesPlayed() || injuryReplacement /* a) */) &&
-        playerPossiblyGoingIn->isHealthy(); // a player may have been injured earlier during current match so
-        // although he's on the bench (_noOnPitch == 0) such a player is not available for selection
-        // (not even for another injured player which would be otherwise possible)
+    return this->_match->team(loc)->isSubstitute(playerPossiblyGoingIn, baseType, injuryReplacement);
+}
+
+// the same conditions as in isEligibleForSubstitution; the best candidate is taken from bench index as it is
+// return value: nullptr if there's no suitable player on bench
+Player * GamePlay::bestSubstituteFor(Player * const playerGoingOut, const MatchType::Location loc,
+                                     const bool injuryReplacement) const {
+
+    const PlayerPosition_index_item::PositionBaseType baseType =
+        playerPosition_index.findPositionBaseTypeByType(playerGoingOut->position()->positionType());
+
+    return this->_match->team(loc)->bestSubstitute(baseType, injuryReplacement);
 }
 
 void GamePlay::switchPlayers(Player * const playerOut, Player * const playerIn, const MatchType::Location loc) {
 
+    EngineCounters::instance().increment(EngineCounters::SUBSTITUTIONS);
+
     // player going in
     playerIn->introducePlayer(playerOut->noOnPitch());
     playerIn->position()->assignNewPlayerPosition(playerOut->position()->playerPosition());
     this->_match->addNewStatsRecordForPlayer(loc, playerIn);
 
     // transfer preferences (except captaincy)
-    if (this->displayOn(FW) || this->_match->team(loc) != _myTeam || this->_settings->substitutionRules().transferPreferences())
+    if (!this->displayOn(MatchDisplay::DETAIL) || this->_match->team(loc) != _myTeam ||
+        this->_settings->substitutionRules().transferPreferences())
         playerOut->transferPreferences(playerIn, player::PreferredForAction::KICK_OFF, player::PreferredForAction::CONVERSION);
 
     this->updateStatistics(loc, StatsType::NumberOf::GAMES_PLAYED, playerIn);
@@ -1874,21 +1908,23 @@ void GamePlay::switchPlayers(Player * const playerOut, Player * const playerIn,
 
     if (playerIn->position()->positionType() != playerOut->position()->positionType())
         playerIn->condition()->decreaseCondition(player::Conditions::FORM,
-        static_cast<uint8_t>(RandomValue::generateRandomBool(50)));
+        static_cast<uint8_t>(this->_random.generateRandomBool(50)));
 
     // player going out
     playerOut->withdrawPlayer();
+    this->_match->team(loc)->lineupChanged();
+    this->_match->team(loc)->benchSubstitution(playerIn, playerOut);
 
-    if (this->displayOn(MW)) {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
         this->refreshPointsList(loc);
-        _mw->updatePackWeight();
+        _observer->updatePackWeight();
 
         // display in log
-        const QString logMessage = message.displayWithReplace(this->playerSubstitution(),
-            "playerReplacedByAnotherPlayer", { this->_match->team(loc)->name(), playerIn->fullName(),
-            QString::number(playerIn->shirtNo()), playerOut->fullName(), QString::number(playerOut->shirtNo()) } );
-        _mw->logRecord(logMessage);
+        if (this->logOn())
+            this->logMessage(this->playerSubstitution(), QStringLiteral("playerReplacedByAnotherPlayer"),
+                { this->_match->team(loc)->name(), playerIn->fullName(), QString::number(playerIn->shirtNo()),
+                  playerOut->fullName(), QString::number(playerOut->shirtNo()) });
     }
 
     return;
@@ -1902,18 +1938,18 @@ timePassed GamePlay::regularSubstitutions() {
 
         const MatchType::Location loc = static_cast<MatchType::Location>(i);
 
-        // my team (matchwidget) - called in regular intervals or after request
-        if (this->displayOn(MW) && _myTeam == this->_match->team(loc) &&
+        // my team (detailed display) - called in regular intervals or after request
+        if (this->displayOn(MatchDisplay::DETAIL) && _myTeam == this->_match->team(loc) &&
             ((this->_settings->substitutionRules().replacementInterval() != 0 && // replacement interval from settings
              (this->_match->timePlayed().minutesPlayed() % this->_settings->substitutionRules().replacementInterval()) == 0) ||
-             _mw->resumePlay() == MatchWidget::ResumePlay::SUBSTITUTION)) {
+             _observer->substitutionRequested())) {
 
             timePassed = this->substitution(_myTeam);
-            _mw->nextAction(MatchWidget::ResumePlay::NO_ACTION);
+            _observer->substitutionRequestHandled();
         }
 
-        // opponent (matchwidget) or either team (fixtureswidget) - called in regular intervals
-        if (((this->displayOn(MW) && _myTeam != this->_match->team(loc)) || this->displayOn(FW)) &&
+        // opponent (detailed display) or either team (progress display or headless) - called in regular intervals
+        if ((!this->displayOn(MatchDisplay::DETAIL) || _myTeam != this->_match->team(loc)) &&
             timeForGameAction.REPLACEMENT_INTERVAL != 0 && // default replacement interval
             (this->_match->timePlayed().minutesPlayed() % timeForGameAction.REPLACEMENT_INTERVAL) == 0) {
 
@@ -1930,16 +1966,19 @@ timePassed GamePlay::substitution(Team * const team, Player * const injuredPlaye
     timePassed timePassed = 0;
     bool makeSubstitution = true;
 
+    if (injuredPlayer != nullptr)
+        EngineCounters::instance().increment(EngineCounters::INJURY_SUBSTITUTIONS);
+
     const MatchType::Location loc = (team == this->_match->team(MatchType::Location::HOSTS)) ? MatchType::Location::HOSTS : MatchType::Location::VISITORS;
 
-    if (this->displayOn(MW) && team == _myTeam && (!this->_settings->substitutionRules().automaticSubstitutions() ||
-                                                   _mw->resumePlay() == MatchWidget::ResumePlay::SUBSTITUTION)) {
+    if (this->displayOn(MatchDisplay::DETAIL) && team == _myTeam && (!this->_settings->substitutionRules().automaticSubstitutions() ||
+                                                   _observer->substitutionRequested())) {
         QMap<QString, Player *> playersOnPitch;
 
         for (auto player: team->squad()) {
 
             if (player->isOnPitch() && player->isHealthy())
-                playersOnPitch.insert(_mw->playerForSubstitution(player), player);
+                playersOnPitch.insert(_observer->playerForSubstitution(player), player);
         }
 
         QStringList playersOnPitchList = playersOnPitch.keys();
@@ -1947,34 +1986,34 @@ timePassed GamePlay::substitution(Team * const team, Player * const injuredPlaye
         do {
 
             const QString oldPlayer = (injuredPlayer == nullptr) ?
-                InputDialog::getItem(nullptr, QStringLiteral("Substitution (phase 1)"),
-                QStringLiteral("Select player for substitution (out):"), playersOnPitchList,
-                &makeSubstitution, 400, QStringLiteral("transfer.png")) : QString();
+                _observer->selectPlayerForSubstitution(playersOnPitchList, false, &makeSubstitution) : QString();
 
             if (makeSubstitution) {
 
                 Player * const playerOut = (injuredPlayer == nullptr) ? playersOnPitch[oldPlayer] : injuredPlayer;
 
                 QMap<QString, Player *> playersOnBench;
+                const PlayerPosition_index_item::PositionBaseType baseType =
+                    playerPosition_index.findPositionBaseTypeByType(playerOut->position()->positionType());
 
-                for (auto player: this->_match->team(loc)->squad())
-                    if (this->isEligibleForSubstitution(playerOut, player, loc, injuredPlayer != nullptr))
-                        playersOnBench.insert(_mw->playerForSubstitution(player), player);
+                for (auto player: this->_match->team(loc)->substitutes(baseType, injuredPlayer != nullptr))
+                    playersOnBench.insert(_observer->playerForSubstitution(player), player);
 
                 if (playersOnBench.isEmpty()) {
 
-                    const QString dialogText = message.displayWithReplace(this->playerSubstitution(),
-                        "noPlayerForReplacement", { playerOut->position()->playerPosition()->positionTypeName(),
+                    const QString dialogText = MessageTemplate::find(this->playerSubstitution(),
+                        QStringLiteral("noPlayerForReplacement")).format({ playerOut->position()->playerPosition()->positionTypeName(),
                         playerOut->fullName(), QString::number(playerOut->shirtNo()) });
-                    QMessageBox::information(nullptr, QStringLiteral("Substitution"), dialogText);
+                    _observer->notify(GamePlayObserver::Notification::INFORMATION, QStringLiteral("Substitution"), dialogText);
 
                     // if there's no suitable player to replace an injured player the injured player must be withdrawn anyway
                     if (injuredPlayer != nullptr) {
 
                         // player going out
                         playerOut->withdrawPlayer();
-                        if (this->displayOn(MW))
-                            _mw->updatePackWeight();
+                        this->_match->team(loc)->lineupChanged();
+                        if (this->displayOn(MatchDisplay::DETAIL))
+                            _observer->updatePackWeight();
                         break;
                     }
                     continue;
@@ -1982,9 +2021,7 @@ timePassed GamePlay::substitution(Team * const team, Player * const injuredPlaye
 
                 const QStringList playersOnBenchList = playersOnBench.keys();
 
-                const QString newPlayer = InputDialog::getItem(nullptr, QStringLiteral("Substitution (phase 2)"),
-                                          QStringLiteral("Select player for substitution (in):"), playersOnBenchList,
-                                          &makeSubstitution, 400, QStringLiteral("transfer.png"));
+                const QString newPlayer = _observer->selectPlayerForSubstitution(playersOnBenchList, true, &makeSubstitution);
                 if (makeSubstitution) {
 
                     Player * const playerIn = playersOnBench[newPlayer];
@@ -2006,13 +2043,13 @@ timePassed GamePlay::substitution(Team * const team, Player * const injuredPlaye
     }
 
     /* make substitutions in the background if
-     * a] game is played in FW mode (from FixturesWidget)
-     * b] game is played in MW mode (from MatchWidget); opponent's team makes substitution
-     * c] game is played in MW mode (from MatchWidet); my team makes substitution and
+     * a] game is played headless or with progress display only (from FixturesWidget)
+     * b] game is played with detailed display (from MatchWidget); opponent's team makes substitution
+     * c] game is played with detailed display (from MatchWidget); my team makes substitution and
      *    1. automatic substitutions are switched on
      *    2. it's not a substitution on request */
-    if ((this->displayOn(MW) && (team != _myTeam || (this->_settings->substitutionRules().automaticSubstitutions() &&
-         _mw->resumePlay() != MatchWidget::ResumePlay::SUBSTITUTION))) || this->displayOn(FW)) {
+    if (!this->displayOn(MatchDisplay::DETAIL) || team != _myTeam ||
+        (this->_settings->substitutionRules().automaticSubstitutions() && !_observer->substitutionRequested())) {
 
         uint8_t noOfReplacedPlayers = 0;
 
@@ -2027,38 +2064,31 @@ timePassed GamePlay::substitution(Team * const team, Player * const injuredPlaye
                 this->_match->playerStats(loc, oldPlayer)->getStatsValue(StatsType::NumberOf::MINS_PLAYED) >=
                 std::max(/* a) */static_cast<uint8_t>(1), /* b) */ timeForGameAction.MIN_PLAY_INTERVAL)))) {
 
-                QVector<Player *> playersForSubstitution;
-
-                for (auto player: team->squad())
-                    if (this->isEligibleForSubstitution(oldPlayer, player, loc, injuredPlayer != nullptr))
-                        playersForSubstitution.push_back(player);
-
-                auto newPlayerIt = std::max_element(playersForSubstitution.begin(), playersForSubstitution.end(),
-                    [](Player * const & first, Player * const & second) -> bool
-                    { return first->condition(player::Conditions::OVERALL) < second->condition(player::Conditions::OVERALL); });
+                Player * const newPlayer = this->bestSubstituteFor(oldPlayer, loc, injuredPlayer != nullptr);
 
                 // change players (if a suitable player for substitution has been found); suitable player is
                 // in case of regular substitution: player with higher overall condition; in case of injury: any player
-                if (newPlayerIt != playersForSubstitution.end() && (injuredPlayer != nullptr ||
-                    (*newPlayerIt)->condition(player::Conditions::OVERALL) > oldPlayer->condition(player::Conditions::OVERALL) * 1.05)) {
+                if (newPlayer != nullptr && (injuredPlayer != nullptr ||
+                    newPlayer->condition(player::Conditions::OVERALL) > oldPlayer->condition(player::Conditions::OVERALL) * 1.05)) {
 
                     // add new record to list of substitutions
-                    if (this->_match->addSubstitution(oldPlayer, *newPlayerIt, loc) &&
+                    if (this->_match->addSubstitution(oldPlayer, newPlayer, loc) &&
                         !this->_periods->isInterval(this->_match->currentPeriod()))
                         // update time if first sub at given minute (and current game period hasn't finished yet)
                         timePassed = timeForGameAction.REPLACEMENT;
 
-                    this->switchPlayers(oldPlayer, *newPlayerIt, loc);
+                    this->switchPlayers(oldPlayer, newPlayer, loc);
                     ++noOfReplacedPlayers;
                 }
 
                 // if there's no suitable player to replace an injured player the injured player must be withdrawn anyway
-                if (newPlayerIt == playersForSubstitution.end() && injuredPlayer != nullptr) {
+                if (newPlayer == nullptr && injuredPlayer != nullptr) {
 
                     // player going out
                     oldPlayer->withdrawPlayer();
-                    if (this->displayOn(MW))
-                        _mw->updatePackWeight();
+                    this->_match->team(loc)->lineupChanged();
+                    if (this->displayOn(MatchDisplay::DETAIL))
+                        _observer->updatePackWeight();
                 }
 
             }
@@ -2089,820 +2119,1141 @@ void GamePlay::kickingCompetition() {
         const int bestKickingSize =  std::min(static_cast<int>(noOfPlayers), bestKicking.size());
         const uint8_t sumKicking = std::accumulate(bestKicking.crbegin(), bestKicking.crbegin() + bestKickingSize, 0);
         maxNumberOfGoals = static_cast<uint8_t>((sumKicking + 9.9) / 10);
-        goalsInShootOut[team] = RandomValue::generateRandomInt<uint8_t>(0, maxNumberOfGoals);
+        goalsInShootOut[team] = this->_random.generateRandomInt<uint8_t>(0, maxNumberOfGoals);
     }
 
     while (goalsInShootOut.at(0) == goalsInShootOut.at(1))
-        goalsInShootOut[1] = RandomValue::generateRandomInt<uint8_t>(0, maxNumberOfGoals);
+        goalsInShootOut[1] = this->_random.generateRandomInt<uint8_t>(0, maxNumberOfGoals);
 
     this->_match->score(MatchType::Location::HOSTS)->shootOutGoalsScored(goalsInShootOut.at(0));
     this->_match->score(MatchType::Location::VISITORS)->shootOutGoalsScored(goalsInShootOut.at(1));
+    this->recordEvent(MatchEvent::Type::SHOOT_OUT, MatchType::Location::HOSTS, nullptr, goalsInShootOut.at(0));
+    this->recordEvent(MatchEvent::Type::SHOOT_OUT, MatchType::Location::VISITORS, nullptr, goalsInShootOut.at(1));
 
     this->_match->timePlayed().addTime(this->_periods->length(this->_match->currentPeriod(), 60));
 
     return;
 }
 
+// match is played in steps (step = one iteration of match loop <=> one game action); steps are run either one after
+// another without any delay (playMatch: headless matches) or one per timer tick (start: control returns to event loop
+// between steps => ui stays responsive and change of speed applies immediately)
 void GamePlay::playMatch() {
 
-    this->_restartPlay = false;
-
-    if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::FULL_TIME)
+    if (!this->resume())
         return;
 
-    // draw is performed at match start
-    if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::WARM_UP) {
-
-        this->startOfMatch();
+    while (this->step());
 
-        if (this->displayOn(MW))
-            _mw->logRecord(this->_periods->description(this->_match->currentPeriod()));
+    return;
+}
 
-        if (this->displayOn(FW)) {
+// return value: false if match is already over (or steps are being run already) => nothing was started
+bool GamePlay::start() {
 
-            _fw->ui->currentMatchProgress->setVisible(true);
+    if (this->_timer->isActive() || !this->resume())
+        return false;
 
-            ClickableLabel * label = _fw->findWidgetByCode<ClickableLabel *>(this->_match->code(), on::fixtureswidget.scoreSeparator);
-            label->setText(QStringLiteral(" : "));
-            label->repaint();
+    this->_timer->start(this->stepInterval());
+    return true;
+}
 
-            for (uint8_t i = 0; i < 2; ++i) {
+// [slot]
+void GamePlay::nextStep() {
 
-                QLabel * label = _fw->findWidgetByCode<QLabel *>(this->_match->code(), on::fixtureswidget.teamScore[i]);
-                label->setText(QString::number(0));
-                label->repaint();
-            }
-        }
+    // timer is single-shot => it can't fire again while current step waits for manager's decision (modal dialog)
+    if (this->step())
+        this->_timer->start(this->stepInterval());
+    else
+        emit stopped();
 
-        _teamInPossession = this->draw();
-        this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
-    }
+    return;
+}
 
-    bool endOfPeriod = false;
-    bool isOffload = false;
+// plays the rest of the match at once (from its current state): observer is detached while the match is being played
+// => no pacing, no repaints and no dialogs (all decisions are made the same way as in non-interactive mode);
+// final state is displayed afterwards; return value: false if match is already over
+bool GamePlay::finish() {
 
-    while ((_match->timePlayedInSeconds() < this->_periods->timePlayed(MatchPeriod::TimePeriod::BEFORE_EXTRA_TIME_INTERVAL, 60) &&
-            _match->currentPeriod() < MatchPeriod::TimePeriod::BEFORE_EXTRA_TIME_INTERVAL) ||
-           (_match->timePlayedInSeconds() < this->_periods->timePlayed(MatchPeriod::TimePeriod::BEFORE_SUDDEN_DEATH_TIME_INTERVAL, 60) &&
-            _match->currentPeriod() < MatchPeriod::TimePeriod::BEFORE_SUDDEN_DEATH_TIME_INTERVAL) ||
-           (_match->timePlayedInSeconds() < this->_periods->timePlayed(MatchPeriod::TimePeriod::BEFORE_KICKING_INTERVAL, 60) &&
-            _match->currentPeriod() < MatchPeriod::TimePeriod::BEFORE_KICKING_INTERVAL)) {
+    this->_timer->stop();
 
-        if (this->displayOn(MW))
-            QThread::msleep(this->_gameplaySpeedDetailed);
-        if (this->displayOn(FW))
-            QThread::msleep(this->_gameplaySpeedStandard);
+    GamePlayObserver * const observer = this->_observer;
+    this->attachObserver(nullptr);
 
-        // after match time is incremented (= refreshTime called): endOfPeriod (bool) value must be
-        // assigned to in the following way in case current (to be replaced) value of this variable
-        // is already true (after previous call to refreshTime) otherwise it would be overwritten
-        // back to false: endOfPeriod |= refreshTime(numberOfSeconds);
+    const bool played = this->resume();
+    if (played)
+        while (this->step());
 
-        if (this->_periods->isInterval(this->_match->currentPeriod())) {
+    this->attachObserver(observer);
 
-            // set length of interval period
-            const uint16_t periodLength = this->_periods->length(this->_match->currentPeriod(), 60);
-            this->_match->timePlayed().setTimeForInterval(periodLength);
+    if (played && this->displayOn(MatchDisplay::DETAIL)) {
 
-            // refresh system time (= move time forward by number of minutes reserved for current interval)
-            this->_dateTime.refreshSystemDateAndTime(periodLength, 60);
+        _observer->timeRefreshed(this->_match->timePlayed().timePlayed(), this->_match->timePlayed().timePlayedInSecondsInPeriod());
+        _observer->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
+        _observer->logRecord(this->_periods->description(this->_match->currentPeriod()));
 
-            // previous period can be longer than "booked" number of minutes (e.g. first half-time could take 40:52)
-            // nevertheless subsequent period must always start at the designated time (e.g. 40:00)
-            _match->timePlayed().resetTime(this->_periods->timePlayed(this->_match->currentPeriod()));
+        // score and statistics are rebuilt from event log (the same values as in match itself)
+        MatchReplay summary(this->_match, this->_match->events());
+        summary.rebuild();
+        summary.display(_observer);
 
-            this->_match->timePlayed().switchTimePeriodTo(/*Next*/);
+        for (uint8_t i = 0; i < 2; ++i) {
 
-            // determine what team (hosts/visitors) starts current period (with a kick-off)
-            const MatchType::Location team = (this->_hostsFirstKickOff)
-                                           ? MatchType::Location::HOSTS : MatchType::Location::VISITORS;
-            _teamInPossession = _match->team(team);
-            this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
-            this->_hostsFirstKickOff = !this->_hostsFirstKickOff;
+            const MatchType::Location team = static_cast<MatchType::Location>(i);
+            if (this->_match->score(team)->bonusPointTry())
+                _observer->bonusPointGained(team);
 
-            if (this->displayOn(MW)) {
+            // display points gained in this match (for regular matches only)
+            if (this->_match->type() == MatchType::Type::REGULAR && this->logOn())
+                _observer->logRecord(this->_match->team(team)->name() % QStringLiteral(": ") %
+                    QString::number(this->_match->points(team)) % QStringLiteral(" point(s)"));
+        }
+    }
 
-                _mw->ui->timePlayedLabel->setText(_match->timePlayed().timePlayed());
-                _mw->ui->matchProgressProgressBar->setValue(_match->timePlayedInSeconds());
+    if (played && this->displayOn(MatchDisplay::PROGRESS))
+        _observer->matchFinished();
 
-                _mw->ui->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
-                _mw->logRecord(this->_periods->description(this->_match->currentPeriod()));
-            }
+    // nothing has changed if match was already over (no autosave, no refresh)
+    if (played) {
 
-            this->_restartPlay = true;
-            this->resetPhases();
-        }
+        this->dateTimeChanged();
+        emit stopped();
+    }
 
-        const uint16_t event = RandomValue::generateRandomInt<uint16_t>(1, 70);
-        MatchActionType::MatchActivityBaseType action =
-            (this->_restartPlay) ? MatchActionType::KICKING : _settings->matchActivities().action(event);
+    return played;
+}
 
-        // kick-off (at start of each match period) or restart kick (after a score)
-        if (this->_restartPlay) {
+uint16_t GamePlay::stepInterval() const {
 
-            // ball is taken back to the half-way line
-            this->moveBallToSpecificPositionOnPitch();
-            if (this->displayOn(MW))
-                _mw->logRecord(QStringLiteral("Kick-off: ") + _teamInPossession->name());
-        }
+    if (this->displayOn(MatchDisplay::DETAIL))
+        return this->_gameplaySpeedDetailed;
+    if (this->displayOn(MatchDisplay::PROGRESS))
+        return this->_gameplaySpeedStandard;
 
-        // player is running (with the ball)
-        if (action == MatchActionType::RUNNING) {
+    return 0;
+}
 
-            // if no action occurs during running which forces change in PlayerInPossession (tackle, try, etc.)
-            // then the entire loop continues and subsequest action (for the same player) follows
-            // note: this situation is not detected by DiagnosticMode because this responds only to player changes
+// play is resumed either at match start (kick-off), at start of a period (play stopped at the end of previous one)
+// or in the middle of a period (pause, finish, playUntil, restored snapshot); only at match/period start there's nothing
+// pending from previous play => state of play in the middle of a period (e.g. restart kick after a score) is kept
+// return value: false if match is already over
+bool GamePlay::resume() {
 
-            // probability of current player (who carries the ball) being tackled
-            const uint8_t probabilityOfTackle = this->probability(MatchActionSubtype::RUN_PLAYER_TACKLED, true);
-            const bool opponentTackles = RandomValue::generateRandomBool(probabilityOfTackle);
+    if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::FULL_TIME)
+        return false;
 
-            uint8_t maxDistance;
-            if (opponentTackles) {
+    if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::WARM_UP)
+        this->kickOff();
+    else if (this->_periods->isInterval(this->_match->currentPeriod())) {
 
-                // the closer the goal line, the greater probability that player would make less distance before tackle
-                maxDistance = (this->distanceToGoalLine() >= groundDimensions.fromGoalLineTo5metreLine)
-                            ? groundDimensions.fromGoalLineTo5metreLine : (this->distanceToGoalLine() + 1);
-            }
-            else {
-                // player with higher speed can cover more distance
-                maxDistance = _playerInPossession->attribute(player::Attributes::SPEED) * 2;
-            }
-            uint8_t metresMade = RandomValue::generateRandomInt<uint8_t>(static_cast<uint8_t>(!opponentTackles), maxDistance);
+        this->_restartPlay = false;
+        this->_isOffload = false;
+    }
 
-            // update carries' stats
-            if (metresMade > 0 && _incrementCarries)
-                this->ballCarried();
+    return true;
+}
 
-            // change ball position ...
-            this->changeBallPositionOnPitch(metresMade);
+// draw is performed at match start
+void GamePlay::kickOff() {
 
-            // ... and check if goal line has been crossed
-            const bool goalLineCrossed = this->playerIsRunning(metresMade);
+    this->_restartPlay = false;
+    this->_isOffload = false;
 
-            endOfPeriod |= this->refreshTime(metresMade);
+    this->startOfMatch();
 
-            if (goalLineCrossed) {
+    if (this->displayOn(MatchDisplay::DETAIL))
+        _observer->logRecord(this->_periods->description(this->_match->currentPeriod()));
 
-                // check if TMO should be consulted
-                const uint8_t probabilityOfTMOReview = this->probability(MatchActionSubtype::RUN_OVER_GOAL_LINE_TRY_UNDER_REVIEW);
-                bool tryAchieved = RandomValue::generateRandomBool(100-probabilityOfTMOReview);
+    if (this->displayOn(MatchDisplay::PROGRESS))
+        _observer->matchStarted();
 
-                // TMO consulted
-                if (!tryAchieved) {
+    _teamInPossession = this->draw();
+    this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
 
-                    if (this->displayOn(MW)) {
+    return;
+}
 
-                        const QString tryUnderReviewText = message.displayWithReplace(this->objectName(), "tryUnderReview",
-                                                           { _playerInPossession->fullName(), _teamInPossession->name() });
-                        QMessageBox::warning(nullptr, QStringLiteral("TMO review (pending)"), tryUnderReviewText);
-                    }
+// complete state of a match in progress (taken between steps): state of gameplay itself (incl. random number generator),
+// state of every player of both squads and state of the match; raw binary data (no compression, no text) => it takes
+// only a fraction of a millisecond and can be done after every period or pause (autosave)
+// note: players' totals (stored "under" player) are not part of snapshot, they are rebuilt from event log when restored
+QByteArray GamePlay::snapshot() const {
 
-                    // check if try is valid
-                    const uint8_t probabilityOfIllegalTry = this->probability(MatchActionSubtype::RUN_OVER_GOAL_LINE_TRY_ILLEGAL);
+    QByteArray data;
+    data.reserve(snapshotReservedSize + 12 * this->_match->events().records().size());
+    QDataStream stream(&data, QIODevice::WriteOnly);
 
-                    tryAchieved = RandomValue::generateRandomBool(100-probabilityOfIllegalTry);
+    const std::array<uint64_t, 4> randomState = this->_random.state();
+    const uint8_t teamInPossession = (this->_teamInPossession == nullptr) ? noTeam
+                                   : static_cast<uint8_t>(this->whoIsInPossession().first);
 
-                    if (!tryAchieved) {
+    stream << GamePlay::snapshotFormatVersion << this->_match->code() << static_cast<quint64>(GamePlay::sessionId)
+           << this->_automaticSelection << this->_hostsFirstKickOff << this->_restartPlay << this->_incrementCarries
+           << this->_isOffload << static_cast<qint8>(this->_distanceFromHalfwayLine) << static_cast<quint8>(this->_noOfPhases)
+           << teamInPossession << ((this->_playerInPossession != nullptr) ? this->_playerInPossession->code() : 0)
+           << static_cast<quint64>(randomState[0]) << static_cast<quint64>(randomState[1])
+           << static_cast<quint64>(randomState[2]) << static_cast<quint64>(randomState[3]);
 
-                        if (this->displayOn(MW)) {
+    for (uint8_t i = 0; i < 2; ++i) {
 
-                            QString tryNotScoredText = message.displayWithReplace(this->objectName(),
-                                                       "tryDeclaredIllegal", { _playerInPossession->fullName() });
-                            QMessageBox::information(nullptr, QStringLiteral("TMO review"), tryNotScoredText);
-                            _mw->logRecord(QStringLiteral("[TMO review] ") + tryNotScoredText.replace('\n',' '));
-                        }
-                        endOfPeriod |= this->refreshTime(timeForGameAction.ILLEGAL_TRY);
+        const QVector<Player *> & squad = this->_match->team(static_cast<MatchType::Location>(i))->squad();
+        stream << static_cast<quint8>(squad.size());
 
-                        // play resumes with 22-metre drop-out
-                        action = MatchActionType::KICKING;
-                        this->moveBallToSpecificPositionOnPitch(groundDimensions.fromGoalLineTo22metreLine);
-                        this->changeBallPossession(_teamInPossession);
-                        this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
-                    }
-                }
+        for (auto player: squad) {
 
-                // if try is legal
-                if (tryAchieved) {
+            stream << player->code();
+            player->writeMatchState(stream);
+        }
+    }
 
-                    timePassed timePassed = 0; this->tryScored();
-                    endOfPeriod |= this->refreshTime(timePassed);
+    this->_match->writeState(stream);
 
-                    // conversion attempt follows (except for sudden-death time)
-                    if (!this->_periods->matchEndsWithResultChange(this->_match->timePlayed().lastPeriodPlayed())) {
+    return data;
+}
 
-                        timePassed = 0; this->conversionAttempt();
-                        endOfPeriod |= this->refreshTime(timePassed);
-                    }
-                }
-            }
-            else {
+// snapshot can be restored only into a match which hasn't been started yet (i.e. right after gameplay is created)
+// return value: false if snapshot is corrupted or belongs to another match or session; gameplay, match and players are left
+// untouched then (players' states are applied only after match's state has been read successfully);
+// squads must be the same as when snapshot was taken
+bool GamePlay::restore(const QByteArray & data) {
 
-                if (opponentTackles) {
+    if (this->_match->currentPeriod() != MatchPeriod::TimePeriod::WARM_UP)
+        return false;
 
-                    this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::TACKLES_RECEIVED, _playerInPossession);
+    QDataStream stream(data);
 
-                    const uint8_t probabilityOfOffload = _settings->matchActivities().probability(MatchActionSubtype::TACKLE_OFFLOAD);
-                    isOffload = RandomValue::generateRandomBool(probabilityOfOffload);
+    quint32 version = 0, code = 0, playerInPossession = 0;
+    quint64 sessionId = 0;
+    bool automaticSelection = false, hostsFirstKickOff = false, restartPlay = false, incrementCarries = true,
+         isOffload = false;
+    qint8 distanceFromHalfwayLine = 0;
+    quint8 noOfPhases = 0, teamInPossession = noTeam;
+    std::array<quint64, 4> randomState = {};
 
-                    // player is either able to pass the ball (off-load) or is tackled by the opponent
-                    action = (isOffload) ? MatchActionType::PASSING : MatchActionType::TACKLING;
-                    endOfPeriod |= this->refreshTime(4);
-                }
-                else
-                    ; // play continues with another action
-            }
-        }
+    stream >> version >> code >> sessionId;
+    if (stream.status() != QDataStream::Ok || version != GamePlay::snapshotFormatVersion || code != this->_match->code() ||
+        sessionId != GamePlay::sessionId)
+        return false;
 
-        // player is being tackled
-        if (action == MatchActionType::TACKLING) {
+    stream >> automaticSelection >> hostsFirstKickOff >> restartPlay >> incrementCarries >> isOffload
+           >> distanceFromHalfwayLine >> noOfPhases >> teamInPossession >> playerInPossession
+           >> randomState[0] >> randomState[1] >> randomState[2] >> randomState[3];
 
-            Player * const tacklingPlayer = this->searchForOpponentsPlayer();
-            this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::TACKLES_MADE, tacklingPlayer);
+    if (stream.status() != QDataStream::Ok || (teamInPossession > 1 && teamInPossession != noTeam))
+        return false;
 
-            if (this->playerIsTackled() == MatchScore::Tackles::COMPLETED) {
+    QVector<QPair<Player *, Player::MatchState>> playerStates;
+    for (uint8_t i = 0; i < 2; ++i) {
 
-                this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::TACKLES_COMPLETED, tacklingPlayer);
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+        quint8 noOfPlayers = 0;
+        stream >> noOfPlayers;
 
-                // if tackle has been completed then either ruck is formed or ball
-                // is lost to opponent or play is stopped due to dangerous tackle
-                const uint8_t tackle = RandomValue::generateRandomInt<uint8_t>(1, 100);
-                const MatchActionSubtype::MatchActivityType nextAction = _settings->matchActivities().action(tackle, action);
+        if (noOfPlayers != this->_match->team(loc)->squad().size())
+            return false;
 
-                switch (nextAction) {
+        for (uint8_t j = 0; j < noOfPlayers; ++j) {
 
-                    case MatchActionSubtype::TACKLE_RUCK_IS_FORMED: {
+            quint32 playerCode = 0;
+            Player::MatchState state;
+            stream >> playerCode;
 
-                        action = MatchActionType::RUCK;
-                        endOfPeriod |= this->refreshTime(timeForGameAction.TACKLE);
-                        break;
-                    }
-                    case MatchActionSubtype::TACKLE_PLAYER_PUSHED_INTO_OUT: {
+            Player * const player = this->_match->playerByCode(loc, playerCode);
+            if (player == nullptr || !Player::readMatchState(stream, state))
+                return false;
+            playerStates.append(qMakePair(player, state));
+        }
+    }
 
-                        this->changeBallPossession(_teamInPossession);
-                        const timePassed timePassed = this->lineOutIsThrowed();
-                        endOfPeriod |= this->refreshTime(timePassed);
-                        break;
-                    }
-                    case MatchActionSubtype::TACKLE_BALL_LOST_TO_OPPONENT: {
+    // match's state is read as the last one and it is applied only if it's valid as a whole
+    if (!this->_match->readState(stream))
+        return false;
 
-                        this->changeBallPossession(_teamInPossession);
-                        this->changePlayerInPossession();
+    for (const auto & playerState: playerStates)
+        playerState.first->applyMatchState(playerState.second);
 
-                        endOfPeriod |= this->refreshTime(timeForGameAction.TACKLE);
-                        break;
-                    }
-                    // tackling or attempting to tackle an opponent above the line of the shoulders
-                    case MatchActionSubtype::TACKLE_HIGH_TACKLE: {
+    this->restoreTotals();
 
-                        this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::HIGH_TACKLES, tacklingPlayer);
-                        this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::DANGEROUS_TACKLES, tacklingPlayer);
+    for (uint8_t i = 0; i < 2; ++i) {
 
-                        if (this->dangerousTackle(tacklingPlayer, player::Tackles::HIGH_TACKLE)) {
+        this->_match->team(static_cast<MatchType::Location>(i))->lineupChanged();
+        this->buildBench(static_cast<MatchType::Location>(i));
+    }
 
-                            endOfPeriod |= refreshTime(timeForGameAction.SUSPENSION);
+    this->_probabilities.build(this->_match->team(MatchType::Location::HOSTS)->ranking(),
+                               this->_match->team(MatchType::Location::VISITORS)->ranking());
 
-                            // tackled player may be injured
-                            const bool isPlayerInjured = this->playerInjured(_playerInPossession);
-                            if (isPlayerInjured) // time is stopped <=> no time increase
-                                /* const timePassed timePassed = */ this->substitution(_teamInPossession, _playerInPossession);
-                        }
+    this->_automaticSelection = automaticSelection;
+    this->_hostsFirstKickOff = hostsFirstKickOff;
+    this->_restartPlay = restartPlay;
+    this->_incrementCarries = incrementCarries;
+    this->_isOffload = isOffload;
+    this->_distanceFromHalfwayLine = distanceFromHalfwayLine;
+    this->_noOfPhases = noOfPhases;
+    this->_teamInPossession = (teamInPossession == noTeam) ? nullptr
+                            : this->_match->team(static_cast<MatchType::Location>(teamInPossession));
+    this->_playerInPossession = (this->_teamInPossession == nullptr) ? nullptr
+                              : this->_match->playerByCode(this->whoIsInPossession().first, playerInPossession);
+    this->_random.setState({ randomState[0], randomState[1], randomState[2], randomState[3] });
 
-                        // a penalty follows ...
-                        const timePassed timePassed = this->penalty();
-                        endOfPeriod |= this->refreshTime(timePassed);
-                        break;
-                    }
-                    /* - a player must not tackle an opponent early or late; an opponent who is
-                       not in possession of the ball; an opponent whose feet are off the ground
-                       - a player must not lift an opponent off the ground and drop that player
-                       so that that player's head or torso makes contact with the ground */
-                    case MatchActionSubtype::TACKLE_DANGEROUS_PLAY: {
+    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-                        this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::DANGEROUS_TACKLES, tacklingPlayer);
+        _observer->timeRefreshed(this->_match->timePlayed().timePlayed(), this->_match->timePlayed().timePlayedInSecondsInPeriod());
+        _observer->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
+        if (this->logOn())
+            _observer->logRecord(QStringLiteral("Match resumed at ") % this->_match->timePlayed().timePlayed() %
+                                 QStringLiteral(" (") % this->_periods->description(this->_match->currentPeriod()) % QStringLiteral(")."));
 
-                        // check if TMO should be consulted
-                        if (this->displayOn(MW)) {
+        if (this->_teamInPossession != nullptr)
+            _observer->possessionChanged(this->whoIsInPossession().first);
+        _observer->ballPositionChanged(this->_distanceFromHalfwayLine);
+        _observer->updatePackWeight();
+    }
 
-                            const uint8_t probabilityOfTMOReview = this->probability(MatchActionSubtype::TACKLE_UNDER_REVIEW);
+    return true;
+}
 
-                            if (RandomValue::generateRandomBool(probabilityOfTMOReview)) {
+// players' totals (stored "under" player) of a loaded game don't contain the part of match played before snapshot
+// was taken => it's added to them the same way as GamePlay has done it (see updateStatistics, playerIsRunning, ...)
+// => after full-time Ʃ(games-stats) = total-stats holds as if the match hasn't been interrupted
+void GamePlay::restoreTotals() {
 
-                                const QString tackleUnderReviewText =
-                                    message.displayWithReplace(this->dangerousTackle(), "tackleUnderReview",
-                                    { tacklingPlayer->fullName(), this->_match->team(this->whoIsInPossession().second)->name() });
-                                QMessageBox::warning(nullptr, QStringLiteral("TMO review (pending)"), tackleUnderReviewText);
-                            }
-                        }
+    for (const auto & record: this->_match->events().records()) {
 
-                        const uint8_t probability = RandomValue::generateRandomInt(1,4);
-                        player::Tackles dangerousTackle = static_cast<player::Tackles>(probability);
+        Player * const player = this->_match->playerByCode(static_cast<MatchType::Location>(record.team), record.player);
+        if (player == nullptr)
+            continue;
 
-                        if (this->dangerousTackle(tacklingPlayer, dangerousTackle)) {
+        switch (record.type) {
 
-                            endOfPeriod |= refreshTime(timeForGameAction.SUSPENSION);
+            case MatchEvent::Type::TRY: player->points()->tryScored(); break;
+            case MatchEvent::Type::CONVERSION: player->points()->conversionScored(); break;
+            case MatchEvent::Type::PENALTY_GOAL: player->points()->penaltyScored(); break;
+            case MatchEvent::Type::DROP_GOAL: player->points()->dropGoalScored(); break;
 
-                            // tackled player may be injured
-                            const bool isPlayerInjured = this->playerInjured(_playerInPossession);
-                            if (isPlayerInjured) // time is stopped <=> no time increase
-                                /* const timePassed timePassed = */ this->substitution(_teamInPossession, _playerInPossession);
-                        }
+            case MatchEvent::Type::RUN: player->stats()->addMetresRun(static_cast<uint8_t>(record.value)); break;
+            case MatchEvent::Type::KICK: player->stats()->addMetresKicked(static_cast<uint8_t>(record.value)); break;
+            case MatchEvent::Type::PLAYER_STATS:
+                player->stats()->incrementStatsValue(static_cast<StatsType::NumberOf>(record.outcome)); break;
 
-                        // a penalty follows ...
-                        const timePassed timePassed = this->penalty();
-                        endOfPeriod |= this->refreshTime(timePassed);
-                        break;
-                    }
-                    default: ;
-                }
-            }
+            default: break;
         }
+    }
 
-        // ruck is being formed
-        if (action == MatchActionType::RUCK) {
+    // minutes played aren't logged until full-time (they are part of match's state instead)
+    for (uint8_t i = 0; i < 2; ++i) {
 
-            // if ruck is being formed then either another phase of play follows
-            // or some kind of infringment occurs (offside, not releasing ball, etc.)
-            const uint8_t ruck = RandomValue::generateRandomInt<uint8_t>(1, 50);
-            const MatchActionSubtype::MatchActivityType nextAction = _settings->matchActivities().action(ruck, action);
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+        for (auto player: this->_match->team(loc)->squad()) {
 
-            QString infringement = QString();
+            const PlayerStats * const statsInThisMatch = this->_match->playerStats(loc, player);
+            if (statsInThisMatch != nullptr)
+                player->stats()->addMinutesPlayed(statsInThisMatch->getStatsValue(StatsType::NumberOf::MINS_PLAYED));
+        }
+    }
 
-            switch (nextAction) {
+    return;
+}
 
-                case MatchActionSubtype::RUCK_ANOTHER_PHASE: {
+// the following functions allow to play alternative continuations of a match restored from snapshot (see MatchBranching)
+void GamePlay::reseed(const uint64_t code) {
 
-                    ++this->_noOfPhases;
+    this->_random = RandomStream::forCode(code);
+    return;
+}
 
-                    if (this->displayOn(MW)) {
+// return value: false if match is over (before given time has been reached)
+bool GamePlay::playUntil(const uint16_t second) {
 
-                        if (this->whoIsInPossession().first == MatchType::Location::HOSTS) {
+    if (!this->resume())
+        return false;
 
-                            _mw->ui->hostsNoOfPhasesLabel->setText(QStringLiteral("Phase: ") + QString::number(_noOfPhases));
-                            if (_noOfPhases == 1) _mw->ui->hostsNoOfPhasesLabel->setVisible(true);
-                            _mw->ui->hostsNoOfPhasesLabel->repaint();
-                        }
-                        else {
+    while (this->_match->timePlayedInSeconds() < second)
+        if (!this->step())
+            return false;
 
-                            _mw->ui->visitorsNoOfPhasesLabel->setText(QStringLiteral("Phase: ") + QString::number(_noOfPhases));
-                            if (_noOfPhases == 1) _mw->ui->visitorsNoOfPhasesLabel->setVisible(true);
-                            _mw->ui->visitorsNoOfPhasesLabel->repaint();
-                        }
-                    }
+    return true;
+}
 
-                    this->changePlayerInPossession();
+// substitution made by manager outside of the match flow (the same way as after manager's request during a pause)
+bool GamePlay::substitute(Player * const playerOut, Player * const playerIn, const MatchType::Location loc) {
 
-                    endOfPeriod |= this->refreshTime(timeForGameAction.RUCK_PHASE);
-                    break;
+    if (playerOut == nullptr || playerIn == nullptr || !playerOut->isOnPitch() || !playerOut->isHealthy() ||
+        !this->isEligibleForSubstitution(playerOut, playerIn, loc, false))
+        return false;
+
+    this->_match->addSubstitution(playerOut, playerIn, loc);
+    this->switchPlayers(playerOut, playerIn, loc);
+
+    return true;
+}
+
+// action selected in advance for the next penalty awarded to my team (if this action is possible at the time)
+void GamePlay::decideNextPenalty(const PenaltyAction action) {
+
+    this->_penaltyDecision = GamePlay::actionAfterPenaltyInfringement.value(action);
+    return;
+}
+
+// snapshot file holds one match only (the one which has been paused most recently)
+bool GamePlay::saveSnapshot(const QString & fileName) const {
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    return (file.write(this->snapshot()) != -1);
+}
+
+// return value: false if there's no snapshot of this match
+bool GamePlay::loadSnapshot(const QString & fileName) {
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    return this->restore(file.readAll());
+}
+
+// regular time, extra time and sudden-death time of the match haven't been played yet (as far as they should be played)
+bool GamePlay::matchTimeRemaining() const {
+
+    return (_match->timePlayedInSeconds() < this->_periods->timePlayed(MatchPeriod::TimePeriod::BEFORE_EXTRA_TIME_INTERVAL, 60) &&
+            _match->currentPeriod() < MatchPeriod::TimePeriod::BEFORE_EXTRA_TIME_INTERVAL) ||
+           (_match->timePlayedInSeconds() < this->_periods->timePlayed(MatchPeriod::TimePeriod::BEFORE_SUDDEN_DEATH_TIME_INTERVAL, 60) &&
+            _match->currentPeriod() < MatchPeriod::TimePeriod::BEFORE_SUDDEN_DEATH_TIME_INTERVAL) ||
+           (_match->timePlayedInSeconds() < this->_periods->timePlayed(MatchPeriod::TimePeriod::BEFORE_KICKING_INTERVAL, 60) &&
+            _match->currentPeriod() < MatchPeriod::TimePeriod::BEFORE_KICKING_INTERVAL);
+}
+
+// return value: false if match is over or paused (at the end of period in detailed display)
+bool GamePlay::step() {
+
+    const EngineCounters::StepTimer stepTimer;
+
+    if (!this->matchTimeRemaining()) {
+
+        if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::BEFORE_KICKING_INTERVAL) {
+
+            this->_match->timePlayed().switchTimePeriodTo(/*kicking competition*/);
+
+            if (this->displayOn(MatchDisplay::DETAIL)) {
+
+                _observer->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
+                _observer->logRecord(this->_periods->description(this->_match->currentPeriod()));
+            }
+
+            // determine winner of kicking competition
+            this->kickingCompetition();
+
+            // refresh system time
+            this->_dateTime.refreshSystemDateAndTime(this->_periods->length(this->_match->currentPeriod(), 60));
+            this->dateTimeChanged();
+
+            this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::FULL_TIME);
+            this->celebrationsTime();
+
+            if (this->displayOn(MatchDisplay::PROGRESS))
+                _observer->matchFinished();
+
+            if (this->displayOn(MatchDisplay::DETAIL)) {
+
+                _observer->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
+                _observer->logRecord(this->_periods->description(this->_match->currentPeriod()));
+                _observer->timeStoppedMessageBox(this->_periods->messageBoxDefinition(this->_match->currentPeriod()),
+                    { this->_match->team(MatchType::Location::HOSTS)->name(),
+                      this->_match->team(MatchType::Location::VISITORS)->name() });
+            }
+
+            endOfMatch();
+        }
+        return false;
+    }
+
+    bool endOfPeriod = false;
+
+    // after match time is incremented (= refreshTime called): endOfPeriod (bool) value must be
+    // assigned to in the following way in case current (to be replaced) value of this variable
+    // is already true (after previous call to refreshTime) otherwise it would be overwritten
+    // back to false: endOfPeriod |= refreshTime(numberOfSeconds);
+
+    if (this->_periods->isInterval(this->_match->currentPeriod())) {
+
+        // set length of interval period
+        const uint16_t periodLength = this->_periods->length(this->_match->currentPeriod(), 60);
+        this->_match->timePlayed().setTimeForInterval(periodLength);
+
+        // refresh system time (= move time forward by number of minutes reserved for current interval)
+        this->_dateTime.refreshSystemDateAndTime(periodLength, 60);
+
+        // previous period can be longer than "booked" number of minutes (e.g. first half-time could take 40:52)
+        // nevertheless subsequent period must always start at the designated time (e.g. 40:00)
+        _match->timePlayed().resetTime(this->_periods->timePlayed(this->_match->currentPeriod()));
+
+        this->_match->timePlayed().switchTimePeriodTo(/*Next*/);
+
+        // determine what team (hosts/visitors) starts current period (with a kick-off)
+        const MatchType::Location team = (this->_hostsFirstKickOff)
+                                       ? MatchType::Location::HOSTS : MatchType::Location::VISITORS;
+        _teamInPossession = _match->team(team);
+        this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
+        this->_hostsFirstKickOff = !this->_hostsFirstKickOff;
+
+        if (this->displayOn(MatchDisplay::DETAIL)) {
+
+            _observer->timeRefreshed(_match->timePlayed().timePlayed(), _match->timePlayedInSeconds(), false);
+            _observer->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
+            _observer->logRecord(this->_periods->description(this->_match->currentPeriod()));
+        }
+
+        this->_restartPlay = true;
+        this->resetPhases();
+    }
+
+    const uint16_t event = this->_random.generateRandomInt<uint16_t>(1, 70);
+    MatchActionType::MatchActivityBaseType action =
+        (this->_restartPlay) ? MatchActionType::KICKING : _settings->matchActivities().action(event);
+    EngineCounters::instance().action(static_cast<uint8_t>(action));
+
+    // kick-off (at start of each match period) or restart kick (after a score)
+    if (this->_restartPlay) {
+
+        // ball is taken back to the half-way line
+        this->moveBallToSpecificPositionOnPitch();
+        if (this->logOn())
+            _observer->logRecord(QStringLiteral("Kick-off: ") % _teamInPossession->name());
+    }
+
+    // player is running (with the ball)
+    if (action == MatchActionType::RUNNING) {
+
+        // if no action occurs during running which forces change in PlayerInPossession (tackle, try, etc.)
+        // then the entire loop continues and subsequest action (for the same player) follows
+        // note: this situation is not detected by DiagnosticMode because this responds only to player changes
+
+        // probability of current player (who carries the ball) being tackled
+        const uint8_t probabilityOfTackle = this->probability(MatchActionSubtype::RUN_PLAYER_TACKLED, true);
+        const bool opponentTackles = this->_random.generateRandomBool(probabilityOfTackle);
+
+        uint8_t maxDistance;
+        if (opponentTackles) {
+
+            // the closer the goal line, the greater probability that player would make less distance before tackle
+            maxDistance = (this->distanceToGoalLine() >= groundDimensions.fromGoalLineTo5metreLine)
+                        ? groundDimensions.fromGoalLineTo5metreLine : (this->distanceToGoalLine() + 1);
+        }
+        else {
+            // player with higher speed can cover more distance
+            maxDistance = _playerInPossession->attribute(player::Attributes::SPEED) * 2;
+        }
+        uint8_t metresMade = this->_random.generateRandomInt<uint8_t>(static_cast<uint8_t>(!opponentTackles), maxDistance);
+
+        // update carries' stats
+        if (metresMade > 0 && _incrementCarries)
+            this->ballCarried();
+
+        // change ball position ...
+        this->changeBallPositionOnPitch(metresMade);
+
+        // ... and check if goal line has been crossed
+        const bool goalLineCrossed = this->playerIsRunning(metresMade);
+
+        endOfPeriod |= this->refreshTime(metresMade);
+
+        if (goalLineCrossed) {
+
+            // check if TMO should be consulted
+            const uint8_t probabilityOfTMOReview = this->probability(MatchActionSubtype::RUN_OVER_GOAL_LINE_TRY_UNDER_REVIEW);
+            bool tryAchieved = this->_random.generateRandomBool(100-probabilityOfTMOReview);
+
+            // TMO consulted
+            if (!tryAchieved) {
+
+                if (this->displayOn(MatchDisplay::DETAIL)) {
+
+                    const QString tryUnderReviewText = MessageTemplate::find(this->objectName(), QStringLiteral("tryUnderReview"))
+                                                       .format({ _playerInPossession->fullName(), _teamInPossession->name() });
+                    _observer->notify(GamePlayObserver::Notification::WARNING,
+                                      QStringLiteral("TMO review (pending)"), tryUnderReviewText);
                 }
-                case MatchActionSubtype::RUCK_NOT_RELEASING_BALL: {
 
-                    this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::PENALTIES_CAUSED, _playerInPossession);
+                // check if try is valid
+                const uint8_t probabilityOfIllegalTry = this->probability(MatchActionSubtype::RUN_OVER_GOAL_LINE_TRY_ILLEGAL);
 
-                    if (this->displayOn(MW)) {
-                        _mw->logRecord(message.displayWithReplace(this->penaltyInfringement(),
-                            QStringLiteral("notReleasingBall"), { _teamInPossession->name() }));
+                tryAchieved = this->_random.generateRandomBool(100-probabilityOfIllegalTry);
+
+                if (!tryAchieved) {
+
+                    if (this->displayOn(MatchDisplay::DETAIL)) {
+
+                        QString tryNotScoredText = MessageTemplate::find(this->objectName(),
+                                                   QStringLiteral("tryDeclaredIllegal")).format({ _playerInPossession->fullName() });
+                        _observer->notify(GamePlayObserver::Notification::INFORMATION,
+                                          QStringLiteral("TMO review"), tryNotScoredText);
+                        if (this->logOn())
+                            _observer->logRecord(QStringLiteral("[TMO review] ") % tryNotScoredText.replace('\n',' '));
                     }
+                    endOfPeriod |= this->refreshTime(timeForGameAction.ILLEGAL_TRY);
 
-                    // team-in-possession's infringement
+                    // play resumes with 22-metre drop-out
+                    action = MatchActionType::KICKING;
+                    this->moveBallToSpecificPositionOnPitch(groundDimensions.fromGoalLineTo22metreLine);
                     this->changeBallPossession(_teamInPossession);
-                    const timePassed timePassed = this->penalty();
-                    endOfPeriod |= this->refreshTime(timePassed);
-                    break;
+                    this->changePlayerInPossessionToSpecialist(player::PreferredForAction::KICK_OFF);
                 }
-                case MatchActionSubtype::RUCK_NOT_RELEASING_PLAYER:
-                    if (infringement.isNull()) infringement = QStringLiteral("notReleasingPlayer"); // fall through
-                case MatchActionSubtype::RUCK_OFFSIDE:
-                    if (infringement.isNull()) infringement = QStringLiteral("offSide"); // fall through
-                case MatchActionSubtype::RUCK_OFF_FEET:
-                    if (infringement.isNull()) infringement = QStringLiteral("offFeet"); // fall through
-                case MatchActionSubtype::RUCK_IN_AT_THE_SIDE: {
-
-                    if (infringement.isNull())
-                        infringement = QStringLiteral("inAtTheSide");
-
-                    Player * const infringementByPlayer = this->searchForOpponentsPlayer();
-                    this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::PENALTIES_CAUSED, infringementByPlayer);
-
-                    if (this->displayOn(MW)) {
-                        _mw->logRecord(message.displayWithReplace(this->penaltyInfringement(),
-                            infringement, { this->_match->team(this->whoIsInPossession().second)->name() }));
-                    }
+            }
 
-                    const timePassed timePassed = this->penalty();
+            // if try is legal
+            if (tryAchieved) {
+
+                timePassed timePassed = 0; this->tryScored();
+                endOfPeriod |= this->refreshTime(timePassed);
+
+                // conversion attempt follows (except for sudden-death time)
+                if (!this->_periods->matchEndsWithResultChange(this->_match->timePlayed().lastPeriodPlayed())) {
+
+                    timePassed = 0; this->conversionAttempt();
                     endOfPeriod |= this->refreshTime(timePassed);
-                    break;
                 }
-                default: ;
             }
         }
+        else {
 
-        // player is passing (the ball)
-        if (action == MatchActionType::PASSING) {
-
-            this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::PASSES_MADE, _playerInPossession);
+            if (opponentTackles) {
 
-            // probability of pass being successful is lower if number of players of attacking team,
-            // i.e. team in possession of the ball, is less than number of players of defending team
-            const double playersRatio = this->_match->playersOnPitchRatio(this->whoIsInPossession().second);
-            const uint8_t probabilityFrom = (playersRatio <= 1) ? 1 : static_cast<uint8_t>(std::round((playersRatio - 1) * 100));
-            const uint8_t pass = RandomValue::generateRandomInt<uint8_t>(probabilityFrom, 100);
+                this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::TACKLES_RECEIVED, _playerInPossession);
 
-            MatchActionSubtype::MatchActivityType nextAction = _settings->matchActivities().action(pass, action);
+                const uint8_t probabilityOfOffload = _settings->matchActivities().probability(MatchActionSubtype::TACKLE_OFFLOAD);
+                this->_isOffload = this->_random.generateRandomBool(probabilityOfOffload);
 
-            bool isDeliberate = true;
-            bool isHandlingError = false;
+                // player is either able to pass the ball (off-load) or is tackled by the opponent
+                action = (this->_isOffload) ? MatchActionType::PASSING : MatchActionType::TACKLING;
+                endOfPeriod |= this->refreshTime(4);
+            }
+            else
+                ; // play continues with another action
+        }
+    }
 
-            const QPair<Player * const, Team * const> passingPlayer =
-                qMakePair<Player * const, Team * const>(_playerInPossession, _teamInPossession);
+    // player is being tackled
+    if (action == MatchActionType::TACKLING) {
 
-            endOfPeriod |= this->refreshTime(timeForGameAction.PASS);
+        Player * const tacklingPlayer = this->searchForOpponentsPlayer();
+        this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::TACKLES_MADE, tacklingPlayer);
 
-            switch (nextAction) {
+        if (this->playerIsTackled() == MatchScore::Tackles::COMPLETED) {
 
-                case MatchActionSubtype::PASS_OK: {
+            this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::TACKLES_COMPLETED, tacklingPlayer);
 
-                    this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::PASSES_COMPLETED, _playerInPossession);
+            // if tackle has been completed then either ruck is formed or ball
+            // is lost to opponent or play is stopped due to dangerous tackle
+            const uint8_t tackle = this->_random.generateRandomInt<uint8_t>(1, 100);
+            const MatchActionSubtype::MatchActivityType nextAction = this->activityOutcome(tackle, action);
 
-                    if (isOffload) {
+            switch (nextAction) {
 
-                        this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::OFFLOADS, _playerInPossession);
+                case MatchActionSubtype::TACKLE_RUCK_IS_FORMED: {
 
-                        // update offloads' statistics
-                        const MatchType::Location team = this->whoIsInPossession().first;
-                        const uint8_t currentValueOffloads = this->_match->score(team)->offloads();
+                    action = MatchActionType::RUCK;
+                    endOfPeriod |= this->refreshTime(timeForGameAction.TACKLE);
+                    break;
+                }
+                case MatchActionSubtype::TACKLE_PLAYER_PUSHED_INTO_OUT: {
 
-                        if (this->displayOn(MW))
-                            _mw->updateStatisticsUI(team, QStringLiteral("OffloadsLabel"), QString::number(currentValueOffloads));
-                    }
+                    this->changeBallPossession(_teamInPossession);
+                    const timePassed timePassed = this->lineOutIsThrowed();
+                    endOfPeriod |= this->refreshTime(timePassed);
+                    break;
+                }
+                case MatchActionSubtype::TACKLE_BALL_LOST_TO_OPPONENT: {
 
-                    this->ballPassed(MatchScore::Passes::COMPLETED);
+                    this->changeBallPossession(_teamInPossession);
                     this->changePlayerInPossession();
+
+                    endOfPeriod |= this->refreshTime(timeForGameAction.TACKLE);
                     break;
                 }
-                case MatchActionSubtype::PASS_MISSED: {
+                // tackling or attempting to tackle an opponent above the line of the shoulders
+                case MatchActionSubtype::TACKLE_HIGH_TACKLE: {
+
+                    this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::HIGH_TACKLES, tacklingPlayer);
+                    this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::DANGEROUS_TACKLES, tacklingPlayer);
 
-                    this->ballPassed(MatchScore::Passes::MISSED);
+                    if (this->dangerousTackle(tacklingPlayer, player::Tackles::HIGH_TACKLE)) {
 
-                    // missed pass can be picked up either by team which "is"/was in possession or by opponent
-                    const bool opponentPicksUpBall = RandomValue::generateRandomBool(50);
-                    if (opponentPicksUpBall) {
+                        endOfPeriod |= refreshTime(timeForGameAction.SUSPENSION);
 
-                        this->changeBallPossession(_teamInPossession);
-                        this->changePlayerInPossession();
-                        isHandlingError = true;
+                        // tackled player may be injured
+                        const bool isPlayerInjured = this->playerInjured(_playerInPossession);
+                        if (isPlayerInjured) // time is stopped <=> no time increase
+                            /* const timePassed timePassed = */ this->substitution(_teamInPossession, _playerInPossession);
                     }
+
+                    // a penalty follows ...
+                    const timePassed timePassed = this->penalty();
+                    endOfPeriod |= this->refreshTime(timePassed);
                     break;
                 }
-                case MatchActionSubtype::PASS_KNOCK_ON: isDeliberate = false; // fall through
-                case MatchActionSubtype::PASS_FORWARD_PASS: {
+                /* - a player must not tackle an opponent early or late; an opponent who is
+                   not in possession of the ball; an opponent whose feet are off the ground
+                   - a player must not lift an opponent off the ground and drop that player
+                   so that that player's head or torso makes contact with the ground */
+                case MatchActionSubtype::TACKLE_DANGEROUS_PLAY: {
+
+                    this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::DANGEROUS_TACKLES, tacklingPlayer);
 
-                    // is ball passed forward deliberately? if yes a penalty follows, if no a scrum follows
-                    isDeliberate &= RandomValue::generateRandomBool(MatchActionSubtype::PASS_DELIBERATE_FORWARD_PASS);
+                    // check if TMO should be consulted
+                    if (this->displayOn(MatchDisplay::DETAIL)) {
 
-                    if (this->displayOn(MW)) {
+                        const uint8_t probabilityOfTMOReview = this->probability(MatchActionSubtype::TACKLE_UNDER_REVIEW);
 
-                        if (isDeliberate)
-                            _mw->logRecord(message.displayWithReplace(this->penaltyInfringement(), "passForward",
-                                           { this->_match->team(this->whoIsInPossession().first)->name() }));
-                        else
-                            _mw->logRecord(message.displayWithReplace(this->objectName(), "scrumAfterKnockOn",
-                                           { this->_match->team(this->whoIsInPossession().first)->name() }));
+                        if (this->_random.generateRandomBool(probabilityOfTMOReview)) {
+
+                            const QString tackleUnderReviewText =
+                                MessageTemplate::find(this->dangerousTackle(), QStringLiteral("tackleUnderReview")).format(
+                                { tacklingPlayer->fullName(), this->_match->team(this->whoIsInPossession().second)->name() });
+                            _observer->notify(GamePlayObserver::Notification::WARNING,
+                                              QStringLiteral("TMO review (pending)"), tackleUnderReviewText);
+                        }
                     }
-                    this->changeBallPossession(_teamInPossession);
-                    isHandlingError = !isDeliberate;
 
-                    const timePassed timePassed = (isDeliberate) ? this->penalty() : this->scrum();
-                    endOfPeriod |= this->refreshTime(timePassed);
-                    break;
-                }
-                case MatchActionSubtype::PASS_PASS_INTERCEPTED: {
+                    const uint8_t probability = this->_random.generateRandomInt(1,4);
+                    player::Tackles dangerousTackle = static_cast<player::Tackles>(probability);
 
-                    this->ballPassed(MatchScore::Passes::MISSED);
-                    this->changeBallPossession(_teamInPossession);
-                    this->changePlayerInPossession();
+                    if (this->dangerousTackle(tacklingPlayer, dangerousTackle)) {
 
-                    isHandlingError = true;
-                    break;
-                }
-                case MatchActionSubtype::PASS_THROWN_INTO_OUT: {
+                        endOfPeriod |= refreshTime(timeForGameAction.SUSPENSION);
 
-                    this->ballPassed(MatchScore::Passes::MISSED);
-                    this->changeBallPossession(_teamInPossession);
-                    isHandlingError = true;
+                        // tackled player may be injured
+                        const bool isPlayerInjured = this->playerInjured(_playerInPossession);
+                        if (isPlayerInjured) // time is stopped <=> no time increase
+                            /* const timePassed timePassed = */ this->substitution(_teamInPossession, _playerInPossession);
+                    }
 
-                    const timePassed timePassed = this->lineOutIsThrowed();
+                    // a penalty follows ...
+                    const timePassed timePassed = this->penalty();
                     endOfPeriod |= this->refreshTime(timePassed);
                     break;
                 }
                 default: ;
             }
+        }
+    }
+
+    // ruck is being formed
+    if (action == MatchActionType::RUCK) {
 
-            if (isHandlingError) {
+        // if ruck is being formed then either another phase of play follows
+        // or some kind of infringment occurs (offside, not releasing ball, etc.)
+        const uint8_t ruck = this->_random.generateRandomInt<uint8_t>(1, 50);
+        const MatchActionSubtype::MatchActivityType nextAction = this->activityOutcome(ruck, action);
 
-                // we don't know at this moment if passing player's team is in possession or not
-                // because possession could've changed (penalty, scrum, line-out could be executed in the meantime)
-                const MatchType::Location team = (_teamInPossession == passingPlayer.second)
-                                    ? this->whoIsInPossession().first : this->whoIsInPossession().second;
+        QString infringement = QString();
 
-                // update handling errors' statistics
-                const uint8_t currentValueHandlingErrors = this->_match->score(team)->handlingErrors();
+        switch (nextAction) {
 
-                this->updateStatistics(team, StatsType::NumberOf::HANDLING_ERRORS, passingPlayer.first);
+            case MatchActionSubtype::RUCK_ANOTHER_PHASE: {
 
-                if (this->displayOn(MW))
-                    _mw->updateStatisticsUI(team, QStringLiteral("HandlingErrorsLabel"), QString::number(currentValueHandlingErrors));
+                ++this->_noOfPhases;
+
+                if (this->displayOn(MatchDisplay::DETAIL))
+                    _observer->phasesChanged(this->whoIsInPossession().first, _noOfPhases);
+
+                this->changePlayerInPossession();
+
+                endOfPeriod |= this->refreshTime(timeForGameAction.RUCK_PHASE);
+                break;
             }
+            case MatchActionSubtype::RUCK_NOT_RELEASING_BALL: {
 
-            isOffload = false;
+                this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::PENALTIES_CAUSED, _playerInPossession);
+
+                if (this->logOn())
+                    this->logMessage(this->penaltyInfringement(), QStringLiteral("notReleasingBall"), { _teamInPossession->name() });
+
+                // team-in-possession's infringement
+                this->changeBallPossession(_teamInPossession);
+                const timePassed timePassed = this->penalty();
+                endOfPeriod |= this->refreshTime(timePassed);
+                break;
+            }
+            case MatchActionSubtype::RUCK_NOT_RELEASING_PLAYER:
+                if (infringement.isNull()) infringement = QStringLiteral("notReleasingPlayer"); // fall through
+            case MatchActionSubtype::RUCK_OFFSIDE:
+                if (infringement.isNull()) infringement = QStringLiteral("offSide"); // fall through
+            case MatchActionSubtype::RUCK_OFF_FEET:
+                if (infringement.isNull()) infringement = QStringLiteral("offFeet"); // fall through
+            case MatchActionSubtype::RUCK_IN_AT_THE_SIDE: {
+
+                if (infringement.isNull())
+                    infringement = QStringLiteral("inAtTheSide");
+
+                Player * const infringementByPlayer = this->searchForOpponentsPlayer();
+                this->updateStatistics(this->whoIsInPossession().second, StatsType::NumberOf::PENALTIES_CAUSED, infringementByPlayer);
+
+                if (this->logOn())
+                    this->logMessage(this->penaltyInfringement(), infringement,
+                                     { this->_match->team(this->whoIsInPossession().second)->name() });
+
+                const timePassed timePassed = this->penalty();
+                endOfPeriod |= this->refreshTime(timePassed);
+                break;
+            }
+            default: ;
         }
+    }
 
-        // player is kicking (the ball); incl. kick-off
-        if (action == MatchActionType::KICKING) {
+    // player is passing (the ball)
+    if (action == MatchActionType::PASSING) {
 
-            this->resetPhases();
+        this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::PASSES_MADE, _playerInPossession);
 
-            // if distance to goal line is less than 2 metres (incl.), kick can't go through
-            const uint8_t probabilityThreshold =
-                _settings->matchActivities().probability(MatchActionSubtype::KICK_KICKED_FORWARD) + 1;
-            const uint8_t from = (this->distanceToGoalLine() > 2) ? 1 : probabilityThreshold;
-            const uint16_t kick = RandomValue::generateRandomInt<uint16_t>(from, 100);
+        // probability of pass being successful is lower if number of players of attacking team,
+        // i.e. team in possession of the ball, is less than number of players of defending team
+        const double playersRatio = this->_match->playersOnPitchRatio(this->whoIsInPossession().second);
+        const uint8_t probabilityFrom = (playersRatio <= 1) ? 1 : static_cast<uint8_t>(std::round((playersRatio - 1) * 100));
+        const uint8_t pass = this->_random.generateRandomInt<uint8_t>(probabilityFrom, 100);
 
-            MatchActionSubtype::MatchActivityType nextAction = _settings->matchActivities().action(kick, action);
+        MatchActionSubtype::MatchActivityType nextAction = this->activityOutcome(pass, action);
 
-            // drop goal can't be scored from distance over 40m (by default; may be changed in Settings)
-            const bool dropGoalPossible = (this->distanceToGoalLine() > _settings->dropGoalMaxDistance()) ? false : true;
-            if (_restartPlay || (nextAction == MatchActionSubtype::KICK_DROP_GOAL_ATTEMPT && !dropGoalPossible))
-                nextAction = MatchActionSubtype::KICK_KICKED_FORWARD;
+        bool isDeliberate = true;
+        bool isHandlingError = false;
 
-            // the closer the goal line, the less powerful kick would be attempted (by kicking player)
-            const uint8_t maxDistance = std::min<uint8_t>(_settings->kickMaxDistance(), static_cast<uint8_t>(distanceToGoalLine()));
-            uint8_t metresMade = RandomValue::generateRandomInt<uint8_t>(1, maxDistance);
+        const QPair<Player * const, Team * const> passingPlayer =
+            qMakePair<Player * const, Team * const>(_playerInPossession, _teamInPossession);
 
-            switch (nextAction) {
+        endOfPeriod |= this->refreshTime(timeForGameAction.PASS);
 
-                // kick goes through - team in possession moves forward
-                case MatchActionSubtype::KICK_KICKED_FORWARD: {
+        switch (nextAction) {
 
-                    this->_restartPlay = false;
+            case MatchActionSubtype::PASS_OK: {
 
-                    // change ball position first then update statistics
-                    this->changeBallPositionOnPitch(metresMade);
-                    playerIsKicking(metresMade);
+                this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::PASSES_COMPLETED, _playerInPossession);
 
-                    // add metres made to player's stats
+                if (this->_isOffload) {
 
-                    endOfPeriod |= this->refreshTime(metresMade/4);
+                    this->updateStatistics(this->whoIsInPossession().first, StatsType::NumberOf::OFFLOADS, _playerInPossession);
 
-                    // who catches the ball
-                    const uint8_t probability =
-                        _settings->matchActivities().probability(MatchActionSubtype::KICK_CATCHED_BY_OPPONENT);
-                    const bool opponentCatchesTheBall = RandomValue::generateRandomBool(probability);
-                    if (opponentCatchesTheBall)
-                        this->changeBallPossession(_teamInPossession);
+                    // update offloads' statistics
+                    const MatchType::Location team = this->whoIsInPossession().first;
+                    const uint8_t currentValueOffloads = this->_match->score(team)->offloads();
+                    this->recordEvent(MatchEvent::Type::OFFLOAD, team);
+
+                    if (this->displayOn(MatchDisplay::DETAIL))
+                        _observer->updateStatisticsUI(team, QStringLiteral("OffloadsLabel"), QString::number(currentValueOffloads));
+                }
+
+                this->ballPassed(MatchScore::Passes::COMPLETED);
+                this->changePlayerInPossession();
+                break;
+            }
+            case MatchActionSubtype::PASS_MISSED: {
 
+                this->ballPassed(MatchScore::Passes::MISSED);
+
+                // missed pass can be picked up either by team which "is"/was in possession or by opponent
+                const bool opponentPicksUpBall = this->_random.generateRandomBool(50);
+                if (opponentPicksUpBall) {
+
+                    this->changeBallPossession(_teamInPossession);
                     this->changePlayerInPossession();
-                    break;
+                    isHandlingError = true;
                 }
+                break;
+            }
+            case MatchActionSubtype::PASS_KNOCK_ON: isDeliberate = false; // fall through
+            case MatchActionSubtype::PASS_FORWARD_PASS: {
 
-                // kick goes over touch line; opponent throws line-out
-                case MatchActionSubtype::KICK_KICKED_INTO_OUT: {
+                // is ball passed forward deliberately? if yes a penalty follows, if no a scrum follows
+                isDeliberate &= this->_random.generateRandomBool(MatchActionSubtype::PASS_DELIBERATE_FORWARD_PASS);
 
-                    // metres made are counted only to the point where ball crossed touch line
-                    const uint8_t metresAfterTouchLineWasCrossed = RandomValue::generateRandomInt<uint8_t>(1, metresMade-1);
-                    metresMade -= metresAfterTouchLineWasCrossed;
+                if (this->logOn()) {
 
-                    // kicked directly into touch or with bounce?
-                    const uint8_t probability =
-                        _settings->matchActivities().probability(MatchActionSubtype::KICK_KICKED_DIRECTLY_INTO_OUT);
-                    const bool kickedDirectly = RandomValue::generateRandomBool(probability);
+                    if (isDeliberate)
+                        this->logMessage(this->penaltyInfringement(), QStringLiteral("passForward"),
+                                         { this->_match->team(this->whoIsInPossession().first)->name() });
+                    else
+                        this->logMessage(this->objectName(), QStringLiteral("scrumAfterKnockOn"),
+                                         { this->_match->team(this->whoIsInPossession().first)->name() });
+                }
+                this->changeBallPossession(_teamInPossession);
+                isHandlingError = !isDeliberate;
 
-                    // kick goes directly over touch line
-                    if (kickedDirectly) {
+                const timePassed timePassed = (isDeliberate) ? this->penalty() : this->scrum();
+                endOfPeriod |= this->refreshTime(timePassed);
+                break;
+            }
+            case MatchActionSubtype::PASS_PASS_INTERCEPTED: {
 
-                        // no gain in ground (if kicked from outside of its own 22)
-                        if (this->distanceToGoalLine() <= groundDimensions.from22metreLineToOpponentsGoalLine)
-                            metresMade = 0;
+                this->ballPassed(MatchScore::Passes::MISSED);
+                this->changeBallPossession(_teamInPossession);
+                this->changePlayerInPossession();
 
-                        // team in possesion moves forward (if kicked from inside of its own 22)
-                        // no action needed <=> metres made already set
-                    }
-                    // kick bounces off the ground and then goes over touch line
-                    else {
+                isHandlingError = true;
+                break;
+            }
+            case MatchActionSubtype::PASS_THROWN_INTO_OUT: {
 
-                        // team in possesion moves forward
-                        // no action needed <=> metres made already set
-                    }
+                this->ballPassed(MatchScore::Passes::MISSED);
+                this->changeBallPossession(_teamInPossession);
+                isHandlingError = true;
+
+                const timePassed timePassed = this->lineOutIsThrowed();
+                endOfPeriod |= this->refreshTime(timePassed);
+                break;
+            }
+            default: ;
+        }
 
-                    // if line-out would be thrown within 5m distance off goal-line, it is formed on the 5-metre line
-                    // note: move to 5-metre line is actually made inside lineOutIsThrowed() function;
-                    // this code serves for adjustment of metres made (kicked) only
-                    if (this->distanceToGoalLine() - metresMade < groundDimensions.fromGoalLineTo5metreLine) {
+        if (isHandlingError) {
 
-                        // if kick into touch has been performed from within 5m distance off goal-line
-                        metresMade = (this->distanceToGoalLine() < groundDimensions.fromGoalLineTo5metreLine)
-                                   ? 0 : this->distanceToGoalLine() - groundDimensions.fromGoalLineTo5metreLine;
-                    }
+            // we don't know at this moment if passing player's team is in possession or not
+            // because possession could've changed (penalty, scrum, line-out could be executed in the meantime)
+            const MatchType::Location team = (_teamInPossession == passingPlayer.second)
+                                ? this->whoIsInPossession().first : this->whoIsInPossession().second;
 
-                    // change ball position first then update statistics
-                    this->changeBallPositionOnPitch(metresMade);
-                    this->playerIsKicking(metresMade);
+            // update handling errors' statistics
+            const uint8_t currentValueHandlingErrors = this->_match->score(team)->handlingErrors();
+            this->recordEvent(MatchEvent::Type::HANDLING_ERROR, team);
 
-                    endOfPeriod |= this->refreshTime(metresMade/4);
+            this->updateStatistics(team, StatsType::NumberOf::HANDLING_ERRORS, passingPlayer.first);
 
-                    // opponent throws line-out
-                    this->changeBallPossession(_teamInPossession);
-                    const timePassed timePassed = this->lineOutIsThrowed();
-                    endOfPeriod |= this->refreshTime(timePassed);
+            if (this->displayOn(MatchDisplay::DETAIL))
+                _observer->updateStatisticsUI(team, QStringLiteral("HandlingErrorsLabel"), QString::number(currentValueHandlingErrors));
+        }
 
-                    break;
-                }
+        this->_isOffload = false;
+    }
 
-                // kick is blocked by opponent's player (no move forward); either team can pick up the ball
-                case MatchActionSubtype::KICK_BLOCKED: {
+    // player is kicking (the ball); incl. kick-off
+    if (action == MatchActionType::KICKING) {
 
-                    endOfPeriod |= this->refreshTime(4);
+        this->resetPhases();
 
-                    // who picks up the ball
-                    const bool opponentPicksUpTheBall = RandomValue::generateRandomBool(50);
-                    if (opponentPicksUpTheBall)
-                        this->changeBallPossession(_teamInPossession);
+        // if distance to goal line is less than 2 metres (incl.), kick can't go through
+        const uint8_t probabilityThreshold =
+            _settings->matchActivities().probability(MatchActionSubtype::KICK_KICKED_FORWARD) + 1;
+        const uint8_t from = (this->distanceToGoalLine() > 2) ? 1 : probabilityThreshold;
+        const uint16_t kick = this->_random.generateRandomInt<uint16_t>(from, 100);
 
-                    this->changePlayerInPossession();
-                    break;
-                }
+        MatchActionSubtype::MatchActivityType nextAction = this->activityOutcome(kick, action);
 
-                // drop goal scored
-                case MatchActionSubtype::KICK_DROP_GOAL_ATTEMPT: {
+        // drop goal can't be scored from distance over 40m (by default; may be changed in Settings)
+        const bool dropGoalPossible = (this->distanceToGoalLine() > _settings->dropGoalMaxDistance()) ? false : true;
+        if (_restartPlay || (nextAction == MatchActionSubtype::KICK_DROP_GOAL_ATTEMPT && !dropGoalPossible))
+            nextAction = MatchActionSubtype::KICK_KICKED_FORWARD;
 
-                    // update metres made by kicking <=> whole distance to goal line
-                    metresMade = this->distanceToGoalLine();
+        // the closer the goal line, the less powerful kick would be attempted (by kicking player)
+        const uint8_t maxDistance = std::min<uint8_t>(_settings->kickMaxDistance(), static_cast<uint8_t>(distanceToGoalLine()));
+        uint8_t metresMade = this->_random.generateRandomInt<uint8_t>(1, maxDistance);
 
-                    // change ball position first then update statistics
-                    this->changeBallPositionOnPitch(metresMade);
-                    this->playerIsKicking(metresMade);
+        switch (nextAction) {
 
-                    const timePassed timePassed = this->dropGoalScored();
-                    endOfPeriod |= this->refreshTime(metresMade/4 + timePassed);
+            // kick goes through - team in possession moves forward
+            case MatchActionSubtype::KICK_KICKED_FORWARD: {
 
-                    // add metres made to player's stats
+                this->_restartPlay = false;
 
-                    break;
-                }
-                default: ;
-            }
-        }
+                // change ball position first then update statistics
+                this->changeBallPositionOnPitch(metresMade);
+                playerIsKicking(metresMade);
 
-        if (this->_match->timePlayed().lastIncrement() > 0) {
+                // add metres made to player's stats
 
-            const uint8_t minutes = this->_match->timePlayed().lastIncrement();
+                endOfPeriod |= this->refreshTime(metresMade/4);
 
-            // adjust players' characteristics values dependent on time progress
-            for (uint8_t i = 0; i < 2; ++i) {
+                // who catches the ball
+                const uint8_t probability =
+                    _settings->matchActivities().probability(MatchActionSubtype::KICK_CATCHED_BY_OPPONENT);
+                const bool opponentCatchesTheBall = this->_random.generateRandomBool(probability);
+                if (opponentCatchesTheBall)
+                    this->changeBallPossession(_teamInPossession);
 
-                const MatchType::Location loc = static_cast<MatchType::Location>(i);
-                for (auto player: this->_match->team(loc)->squad()) {
+                this->changePlayerInPossession();
+                break;
+            }
 
-                    if (player->isOnPitch() && player->isHealthy()) {
+            // kick goes over touch line; opponent throws line-out
+            case MatchActionSubtype::KICK_KICKED_INTO_OUT: {
 
-                        // total number of minutes played (in all matches including this one)
-                        player->stats()->addMinutesPlayed(minutes);
+                // metres made are counted only to the point where ball crossed touch line
+                const uint8_t metresAfterTouchLineWasCrossed = this->_random.generateRandomInt<uint8_t>(1, metresMade-1);
+                metresMade -= metresAfterTouchLineWasCrossed;
 
-                        // current number of minutes played in this match
-                        const uint8_t minutesPlayedInThisMatchOriginalValue =
-                            this->_match->playerStats(loc, player)->getStatsValue(StatsType::NumberOf::MINS_PLAYED);
-                        this->_match->playerStats(loc, player)->addMinutesPlayed(minutes);
-                        const uint8_t minutesPlayedInThisMatchCurrentValue =
-                            this->_match->playerStats(loc, player)->getStatsValue(StatsType::NumberOf::MINS_PLAYED);
+                // kicked directly into touch or with bounce?
+                const uint8_t probability =
+                    _settings->matchActivities().probability(MatchActionSubtype::KICK_KICKED_DIRECTLY_INTO_OUT);
+                const bool kickedDirectly = this->_random.generateRandomBool(probability);
 
-                        if (minutesPlayedInThisMatchCurrentValue/10 > minutesPlayedInThisMatchOriginalValue/10) {
+                // kick goes directly over touch line
+                if (kickedDirectly) {
 
-                            const bool substitutionFollows = this->changeInFatigue(player);
-                            if (substitutionFollows) {
+                    // no gain in ground (if kicked from outside of its own 22)
+                    if (this->distanceToGoalLine() <= groundDimensions.from22metreLineToOpponentsGoalLine)
+                        metresMade = 0;
 
-                                const timePassed timePassed = this->substitution(this->_match->team(loc), player);
-                                endOfPeriod |= this->refreshTime(timePassed);
-                            }
-                        }
-                    }
+                    // team in possesion moves forward (if kicked from inside of its own 22)
+                    // no action needed <=> metres made already set
                 }
-            }
+                // kick bounces off the ground and then goes over touch line
+                else {
 
-            // update sin-bin
-            if (!this->_match->sinBin().isEmpty())
-                this->suspensionsUpdate(minutes);
+                    // team in possesion moves forward
+                    // no action needed <=> metres made already set
+                }
 
-            // make substitutions
-            if (this->_match->currentPeriod() != MatchPeriod::TimePeriod::FULL_TIME) {
+                // if line-out would be thrown within 5m distance off goal-line, it is formed on the 5-metre line
+                // note: move to 5-metre line is actually made inside lineOutIsThrowed() function;
+                // this code serves for adjustment of metres made (kicked) only
+                if (this->distanceToGoalLine() - metresMade < groundDimensions.fromGoalLineTo5metreLine) {
 
-                timePassed timePassed = this->regularSubstitutions();
+                    // if kick into touch has been performed from within 5m distance off goal-line
+                    metresMade = (this->distanceToGoalLine() < groundDimensions.fromGoalLineTo5metreLine)
+                               ? 0 : this->distanceToGoalLine() - groundDimensions.fromGoalLineTo5metreLine;
+                }
+
+                // change ball position first then update statistics
+                this->changeBallPositionOnPitch(metresMade);
+                this->playerIsKicking(metresMade);
+
+                endOfPeriod |= this->refreshTime(metresMade/4);
+
+                // opponent throws line-out
+                this->changeBallPossession(_teamInPossession);
+                const timePassed timePassed = this->lineOutIsThrowed();
                 endOfPeriod |= this->refreshTime(timePassed);
+
+                break;
             }
 
-            // change settings (to be updated)
-            // _mw->nextAction(MatchWidget::ResumePlay::NO_ACTION);
+            // kick is blocked by opponent's player (no move forward); either team can pick up the ball
+            case MatchActionSubtype::KICK_BLOCKED: {
 
-            this->_match->timePlayed().resetIncrement();
-        }
+                endOfPeriod |= this->refreshTime(4);
 
-        if (endOfPeriod) {
+                // who picks up the ball
+                const bool opponentPicksUpTheBall = this->_random.generateRandomBool(50);
+                if (opponentPicksUpTheBall)
+                    this->changeBallPossession(_teamInPossession);
 
-            if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::FULL_TIME) {
+                this->changePlayerInPossession();
+                break;
+            }
 
-                // add time spent on celebrations :-)
-                this->celebrationsTime();
+            // drop goal scored
+            case MatchActionSubtype::KICK_DROP_GOAL_ATTEMPT: {
 
-                if (this->displayOn(MW)) {
+                // update metres made by kicking <=> whole distance to goal line
+                metresMade = this->distanceToGoalLine();
 
-                    _mw->ui->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
-                    _mw->logRecord(this->_periods->description(this->_match->currentPeriod()));
-                    _mw->timeStoppedMessageBox("endOfMatch", { this->_match->team(MatchType::Location::HOSTS)->name(),
-                                                               this->_match->team(MatchType::Location::VISITORS)->name()});
+                // change ball position first then update statistics
+                this->changeBallPositionOnPitch(metresMade);
+                this->playerIsKicking(metresMade);
 
-                    // display points gained in this match (for regular matches only)
-                    if (this->_match->type() == MatchType::Type::REGULAR) {
+                const timePassed timePassed = this->dropGoalScored();
+                endOfPeriod |= this->refreshTime(metresMade/4 + timePassed);
 
-                        _mw->logRecord(this->_match->team(MatchType::Location::HOSTS)->name() % QStringLiteral(": ") %
-                            QString::number(this->_match->points(MatchType::Location::HOSTS)) % QStringLiteral(" point(s)"));
-                        _mw->logRecord(this->_match->team(MatchType::Location::VISITORS)->name() % QStringLiteral(": ") %
-                            QString::number(this->_match->points(MatchType::Location::VISITORS)) % QStringLiteral(" point(s)"));
-                    }
-                }
+                // add metres made to player's stats
 
-                if (this->displayOn(FW)) {
+                break;
+            }
+            default: ;
+        }
+    }
 
-                    _fw->ui->currentMatchProgress->setVisible(false);
-                    _fw->ui->currentMatchProgress->repaint();
+    if (this->_match->timePlayed().lastIncrement() > 0) {
 
-                    QLabel * const resultTypeLabel = _fw->findWidgetByCode<QLabel *>
-                        (this->_match->code(), on::fixtureswidget.resultType);
-                    _fw->ui->displayResultTypeSuffix(this->_match, resultTypeLabel);
-                    resultTypeLabel->repaint();
+        const uint8_t minutes = this->_match->timePlayed().lastIncrement();
 
-                    if (this->_match->type() == MatchType::Type::REGULAR) {
+        // adjust players' characteristics values dependent on time progress: fatigue of all players who have completed
+        // another 10 minutes is changed at once; substitutions follow afterwards (lineup doesn't change in the meantime)
+        ConditionBatch fatigueBatch;
 
-                        QLabel * const teamsPointsLabel = _fw->findWidgetByCode<QLabel *>
-                            (this->_match->code(), on::fixtureswidget.pointsFromGame);
-                        _fw->ui->displayTeamsPoints(this->_match, teamsPointsLabel);
-                        teamsPointsLabel->repaint();
-                    }
-                }
+        for (uint8_t i = 0; i < 2; ++i) {
+
+            const MatchType::Location loc = static_cast<MatchType::Location>(i);
+            for (auto player: this->_match->team(loc)->playersOnPitch()) {
 
-                endOfMatch();
+                if (player->isOnPitch() && player->isHealthy()) {
+
+                    // total number of minutes played (in all matches including this one)
+                    player->stats()->addMinutesPlayed(minutes);
+
+                    // current number of minutes played in this match
+                    const uint8_t minutesPlayedInThisMatchOriginalValue =
+                        this->_match->playerStats(loc, player)->getStatsValue(StatsType::NumberOf::MINS_PLAYED);
+                    this->_match->playerStats(loc, player)->addMinutesPlayed(minutes);
+                    const uint8_t minutesPlayedInThisMatchCurrentValue =
+                        this->_match->playerStats(loc, player)->getStatsValue(StatsType::NumberOf::MINS_PLAYED);
+
+                    if (minutesPlayedInThisMatchCurrentValue/10 > minutesPlayedInThisMatchOriginalValue/10)
+                        fatigueBatch.add(player, loc);
+                }
             }
-            return;
         }
-    }
 
-    if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::BEFORE_KICKING_INTERVAL) {
+        QVector<ConditionBatch::Event> fatigueEvents;
+        if (!fatigueBatch.isEmpty())
+            fatigueBatch.changeFatigue(this->_random, fatigueEvents);
+
+        for (const auto & event: fatigueEvents) {
 
-        if (this->displayOn(FW)) {
+            const bool substitutionFollows = this->changeInFatigue(event);
+            if (substitutionFollows) {
 
-            _fw->ui->currentMatchProgress->setVisible(false);
-            _fw->ui->currentMatchProgress->repaint();
+                const timePassed timePassed = this->substitution(this->_match->team(event.team), event.player);
+                endOfPeriod |= this->refreshTime(timePassed);
+            }
         }
 
-        this->_match->timePlayed().switchTimePeriodTo(/*kicking competition*/);
+        // update sin-bin
+        if (this->_match->anyActiveSuspension())
+            this->suspensionsUpdate(minutes);
 
-        if (this->displayOn(MW)) {
+        // make substitutions
+        if (this->_match->currentPeriod() != MatchPeriod::TimePeriod::FULL_TIME) {
 
-            _mw->ui->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
-            _mw->logRecord(this->_periods->description(this->_match->currentPeriod()));
+            timePassed timePassed = this->regularSubstitutions();
+            endOfPeriod |= this->refreshTime(timePassed);
         }
 
-        // determine winner of kicking competition
-        this->kickingCompetition();
+        // change settings (to be updated)
+        // _observer->substitutionRequestHandled();
 
-        // refresh system time
-        this->_dateTime.refreshSystemDateAndTime(this->_periods->length(this->_match->currentPeriod(), 60));
-        emit timeChanged();
+        this->_match->timePlayed().resetIncrement();
+    }
 
-        this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::FULL_TIME);
-        this->celebrationsTime();
+    if (endOfPeriod) {
 
-        if (this->displayOn(FW)) {
+        if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::FULL_TIME) {
 
-            QLabel * const resultTypeLabel = _fw->findWidgetByCode<QLabel *>
-                (this->_match->code(), on::fixtureswidget.resultType);
-            _fw->ui->displayResultTypeSuffix(this->_match, resultTypeLabel);
-            resultTypeLabel->repaint();
-        }
+            // add time spent on celebrations :-)
+            this->celebrationsTime();
 
-        if (this->displayOn(MW)) {
+            if (this->displayOn(MatchDisplay::DETAIL)) {
 
-            _mw->ui->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
-            _mw->logRecord(this->_periods->description(this->_match->currentPeriod()));
-            _mw->timeStoppedMessageBox(this->_periods->messageBoxDefinition(this->_match->currentPeriod()),
-                { this->_match->team(MatchType::Location::HOSTS)->name(),
-                  this->_match->team(MatchType::Location::VISITORS)->name() });
-        }
+                _observer->updatePeriod(this->_periods->description(this->_match->currentPeriod()));
+                _observer->logRecord(this->_periods->description(this->_match->currentPeriod()));
+                _observer->timeStoppedMessageBox("endOfMatch", { this->_match->team(MatchType::Location::HOSTS)->name(),
+                                                           this->_match->team(MatchType::Location::VISITORS)->name()});
+
+                // display points gained in this match (for regular matches only)
+                if (this->_match->type() == MatchType::Type::REGULAR && this->logOn()) {
 
-        endOfMatch();
+                    _observer->logRecord(this->_match->team(MatchType::Location::HOSTS)->name() % QStringLiteral(": ") %
+                        QString::number(this->_match->points(MatchType::Location::HOSTS)) % QStringLiteral(" point(s)"));
+                    _observer->logRecord(this->_match->team(MatchType::Location::VISITORS)->name() % QStringLiteral(": ") %
+                        QString::number(this->_match->points(MatchType::Location::VISITORS)) % QStringLiteral(" point(s)"));
+                }
+            }
+
+            if (this->displayOn(MatchDisplay::PROGRESS))
+                _observer->matchFinished();
+
+            endOfMatch();
+        }
+        return false;
     }
 
-    return;
+    return true;
 }
-
-// explicit instantiation of constructor(s)
-template GamePlay::GamePlay(MatchWidget * const, Settings * const, DateTime &, Match * const, Team * const);
-template GamePlay::GamePlay(FixturesWidget * const, Settings * const, DateTime &, Match * const, Team * const);
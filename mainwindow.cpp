@@ -4,17 +4,27 @@
 *******************************************************************************/
 
 #include <QApplication>
+#include <QFutureWatcher>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QPushButton>
+#include <QShortcut>
+#include <QtConcurrent>
+#include <numeric>
 #include "aboutwindow.h"
 #include "fixtureswidget.h"
 #include "mainwindow.h"
+#include "match/engine_counters.h"
+#include "match/quick_sim.h"
+#include "match/quick_sim_calibration.h"
+#include "match/season_forecast.h"
 #include "matchwidget.h"
 #include "nextmatchwindow.h"
 #include "playerswidget.h"
 #include "processwindow.h"
 #include "shared/messages.h"
+#include "shared/random_stream.h"
 #include "squadwidget.h"
 #include "statswidget.h"
 #include "tablewidget.h"
@@ -27,6 +37,20 @@ MainWindow::MainWindow(QWidget * parent):
     connect(ui->dbQueryShortCut, &QShortcut::activated, this, &MainWindow::userQueryDialog);
     connect(ui->restoreSystemDbShortCut, &QShortcut::activated, this, &MainWindow::restoreSystemQueryDialog);
 
+    QShortcut * const masterSeedShortCut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+R")), this);
+    connect(masterSeedShortCut, &QShortcut::activated, this, &MainWindow::masterSeedDialog);
+    QShortcut * const seasonForecastShortCut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+F")), this);
+    connect(seasonForecastShortCut, &QShortcut::activated, this, &MainWindow::seasonForecast);
+    QShortcut * const matchEngineShortCut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+E")), this);
+    connect(matchEngineShortCut, &QShortcut::activated, this, &MainWindow::matchEngineDialog);
+    QShortcut * const calibrationShortCut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+K")), this);
+    connect(calibrationShortCut, &QShortcut::activated, this, &MainWindow::quickSimCalibration);
+    QShortcut * const engineCountersShortCut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+Shift+D")), this);
+    connect(engineCountersShortCut, &QShortcut::activated, this, &MainWindow::engineCountersDialog);
+
+    // parameters of quick simulation (as fitted by last calibration)
+    QuickSim::backgroundModel() = QuickSim::loadModel(QuickSim::modelFileName);
+
     connect(ui->dateAndTimeIconLabel, &TimeShiftLabel::leftClicked, this, &MainWindow::progress);
     connect(ui->aboutLabel, &ClickableLabel::leftClicked, this, &MainWindow::about);
     connect(ui->quitLabel, &ClickableLabel::leftClicked, this, &QApplication::quit);
@@ -156,6 +180,55 @@ void MainWindow::userQueryDialog() {
     return;
 }
 
+// [slot]
+// master seed can be displayed (and changed) in order to replay matches (same seed + same save = same results)
+void MainWindow::masterSeedDialog() {
+
+    bool selectedInDialog;
+    const QString seed = QInputDialog::getText(this, QStringLiteral("Random generator"), QStringLiteral("Master seed:"),
+                                               QLineEdit::Normal, QString::number(this->_currentSession->seed()), &selectedInDialog);
+    if (!selectedInDialog)
+        return;
+
+    bool isNumber;
+    const uint64_t newSeed = seed.toULongLong(&isNumber);
+    if (isNumber)
+        this->_currentSession->setSeed(newSeed);
+
+    return;
+}
+
+// [slot]
+// other teams' matches can be played either by GamePlay (action by action) or by QuickSim (much faster)
+void MainWindow::matchEngineDialog() {
+
+    const QStringList engines = { QStringLiteral("full simulation"), QStringLiteral("quick simulation") };
+    const int current = static_cast<int>(QuickSim::backgroundEngine());
+
+    bool selectedInDialog;
+    const QString engine = QInputDialog::getItem(this, QStringLiteral("Match engine"), QStringLiteral("Other teams' matches:"),
+                                                 engines, current, false, &selectedInDialog);
+    if (selectedInDialog)
+        QuickSim::backgroundEngine() = static_cast<QuickSim::Engine>(engines.indexOf(engine));
+
+    return;
+}
+
+// [slot]
+// counters of match engine (all matches played since start or since last reset)
+void MainWindow::engineCountersDialog() {
+
+    QMessageBox countersBox(QMessageBox::Information, QStringLiteral("Match engine"),
+                            EngineCounters::asHtml(EngineCounters::instance().values()), QMessageBox::Close, this);
+    const QPushButton * const resetButton = countersBox.addButton(QStringLiteral("Reset"), QMessageBox::ResetRole);
+
+    countersBox.exec();
+    if (countersBox.clickedButton() == resetButton)
+        EngineCounters::instance().reset();
+
+    return;
+}
+
 // [slot]
 void MainWindow::restoreSystemQueryDialog() {
 
@@ -244,6 +317,15 @@ void MainWindow::fixtures() {
         this->_currentSession->competition().periodToSwitch(), this->_currentSession->config().team(),
         this->_currentSession->settings(), this->_currentSession->fixtures(), this->_currentSession->referees());
 
+    // matches are played without blocking event loop => fixtures widget mustn't be replaced (nor time shifted)
+    // while they are in play
+    connect(fixturesWidget, &FixturesWidget::playInProgress, this, [this](const bool inProgress) {
+
+        this->enableButtons(!inProgress);
+        this->ui->nextMatchButton->setEnabled(!inProgress);
+        this->ui->dateAndTimeIconLabel->setEnabled(!inProgress);
+    });
+
     this->_widgetInDrawingArea = fixturesWidget->objectName();
     this->ui->drawingAreaScrollArea->setWidget(fixturesWidget);
 
@@ -353,6 +435,116 @@ void MainWindow::table() {
     return;
 }
 
+// [slot]
+// remaining fixtures are simulated SeasonForecast::defaultNumberOfRuns times in the background (on a thread pool) by the
+// same model as matches played in the background; forecast works with its own copy of current standings => session
+// can't be affected by it
+void MainWindow::seasonForecast() {
+
+    // if game is not loaded
+    if (this->_currentSession->config().team() == nullptr) {
+
+        QMessageBox::information(this, QStringLiteral("Season forecast"), message.display(this->objectName(), "tableNotAvailable"));
+        return;
+    }
+
+    const SeasonForecast * const forecast = new SeasonForecast(this->_currentSession->teams(), this->_currentSession->fixtures(),
+                                                               this->_currentSession->seed(), QuickSim::backgroundModel());
+    Team * const myTeam = this->_currentSession->config().team();
+
+    QVector<uint32_t> runs(SeasonForecast::defaultNumberOfRuns);
+    std::iota(runs.begin(), runs.end(), 0);
+
+    QProgressDialog * const forecastProgress = new QProgressDialog(QStringLiteral("Simulating rest of the season..."),
+                                                                   QStringLiteral("Cancel"), 0, runs.size(), this);
+    forecastProgress->setWindowModality(Qt::WindowModal);
+    forecastProgress->setValue(0);
+
+    typedef QFutureWatcher<SeasonForecast::Summary> ForecastWatcher;
+    ForecastWatcher * const forecastWatcher = new ForecastWatcher(this);
+
+    connect(forecastWatcher, &ForecastWatcher::progressValueChanged, forecastProgress, &QProgressDialog::setValue);
+    connect(forecastProgress, &QProgressDialog::canceled, forecastWatcher, &ForecastWatcher::cancel);
+    connect(forecastWatcher, &ForecastWatcher::finished, this, [this, forecast, myTeam, forecastProgress, forecastWatcher]() {
+
+        forecastProgress->close();
+        if (!forecastWatcher->isCanceled())
+            QMessageBox::information(this, QStringLiteral("Season forecast"), forecast->summaryAsHtml(forecastWatcher->result(), myTeam));
+
+        forecastProgress->deleteLater();
+        forecastWatcher->deleteLater();
+        delete forecast;
+    });
+
+    forecastWatcher->setFuture(QtConcurrent::mappedReduced(runs, SeasonForecast::RunFunctor(forecast), &SeasonForecast::add));
+
+    return;
+}
+
+// [slot]
+// full matches (GamePlay) of all pairings of current season are played repeatedly and parameters of quick simulation
+// are fitted to their results; fitted parameters are used immediately and stored for next sessions
+void MainWindow::quickSimCalibration() {
+
+    // if game is not loaded
+    if (this->_currentSession->config().team() == nullptr) {
+
+        QMessageBox::information(this, QStringLiteral("Quick simulation"), message.display(this->objectName(), "tableNotAvailable"));
+        return;
+    }
+
+    const QVector<QPair<Team *, Team *>> pairings = QuickSimCalibration::pairings(this->_currentSession->fixtures());
+    if (pairings.isEmpty())
+        return;
+
+    bool selectedInDialog;
+    const int runsPerPairing = QInputDialog::getInt(this, QStringLiteral("Quick simulation"), QStringLiteral("Matches per pairing:"),
+                                                    QuickSimCalibration::defaultNumberOfRunsPerPairing, 1, 10000, 1, &selectedInDialog);
+    if (!selectedInDialog)
+        return;
+
+    const QuickSimCalibration * const calibration =
+        new QuickSimCalibration(this->_currentSession->settings(), this->_currentSession->datetime(), pairings);
+
+    QVector<uint32_t> runs(runsPerPairing * pairings.size());
+    std::iota(runs.begin(), runs.end(), 0);
+
+    QProgressDialog * const calibrationProgress = new QProgressDialog(QStringLiteral("Playing matches..."),
+                                                                      QStringLiteral("Cancel"), 0, runs.size(), this);
+    calibrationProgress->setWindowModality(Qt::WindowModal);
+    calibrationProgress->setValue(0);
+
+    typedef QFutureWatcher<QuickSimCalibration::Summary> CalibrationWatcher;
+    CalibrationWatcher * const calibrationWatcher = new CalibrationWatcher(this);
+
+    connect(calibrationWatcher, &CalibrationWatcher::progressValueChanged, calibrationProgress, &QProgressDialog::setValue);
+    connect(calibrationProgress, &QProgressDialog::canceled, calibrationWatcher, &CalibrationWatcher::cancel);
+    connect(calibrationWatcher, &CalibrationWatcher::finished, this, [this, calibration, calibrationProgress, calibrationWatcher]() {
+
+        calibrationProgress->close();
+        if (!calibrationWatcher->isCanceled()) {
+
+            const QuickSimCalibration::Summary summary = calibrationWatcher->result();
+            const QuickSim::Model model = calibration->fit(summary);
+
+            QuickSim::backgroundModel() = model;
+            QuickSim::saveModel(model, QuickSim::modelFileName);
+
+            QMessageBox::information(this, QStringLiteral("Quick simulation"),
+                                     QuickSimCalibration::modelAsHtml(model, summary.teamMatches / 2));
+        }
+
+        calibrationProgress->deleteLater();
+        calibrationWatcher->deleteLater();
+        delete calibration;
+    });
+
+    calibrationWatcher->setFuture(QtConcurrent::mappedReduced(runs, QuickSimCalibration::RunFunctor(calibration),
+                                                              &QuickSimCalibration::add));
+
+    return;
+}
+
 // [slot]
 void MainWindow::nextMatch() {
 
@@ -404,6 +596,9 @@ void MainWindow::nextMatch() {
         return;
     }
 
+    // the same stream as in preparation of the match itself (see FixturesWidget::prepareMatch)
+    RandomStream preparation = RandomStream::forPreparationOf(nextMatch->code());
+
     // if referee is not assigned draw someone from pool of referees
     if (nextMatch->refereeNotAssigned()) {
 
@@ -411,14 +606,14 @@ void MainWindow::nextMatch() {
         for (auto fixture: *(this->_currentSession->fixtures()))
             if (fixture->date() == nextMatch->date() && !fixture->refereeNotAssigned())
                 excludedReferees.push_back(fixture->referee());
-        nextMatch->assignReferee(nextMatch->drawReferee(this->_currentSession->referees(), excludedReferees));
+        nextMatch->assignReferee(nextMatch->drawReferee(this->_currentSession->referees(), excludedReferees, preparation));
     }
 
     // select squad of opponent's team
     Team * const opponent = (nextMatch->isTeamInPlay(MatchType::Location::HOSTS, this->_currentSession->config().team())) ?
         nextMatch->team(MatchType::Location::VISITORS) : nextMatch->team(MatchType::Location::HOSTS);
     const bool selectionComplete =
-        opponent->selectPlayersForNextMatch(this->_currentSession->settings()->playerConditions());
+        opponent->selectPlayersForNextMatch(this->_currentSession->settings()->playerConditions(), &preparation);
 
     if (!selectionComplete)
         QMessageBox::information(this, QStringLiteral("Squad selection failed"), message.display(this->objectName(), "noPlayWithoutOpponent"));
@@ -455,11 +650,11 @@ void MainWindow::nextMatch() {
                 this->_currentSession->competition().periodToSwitch(), this->_currentSession->config().team(),
                 this->_currentSession->settings(), this->_currentSession->fixtures(), this->_currentSession->referees());
 
-            // matches are played one after another until:
+            // matches are played matchday after matchday (independent matches of the same day simultaneously) until:
             // - there are no matches remaining (in the whole competition) [1] OR
             // - next match involves "my" team (= this match can't be played in non-interactive mode) [2] OR
             // - squad selection for one and/or the other team playing in next match fails [3]
-            while (fixturesWidgetTemp.playNextMatch(true));
+            while (fixturesWidgetTemp.playNextMatchday());
 
             if ((nextMatch = this->_currentSession->nextMatchMyTeam()) != this->_currentSession->nextMatchAllTeams())
                 // == if [1] or [3]
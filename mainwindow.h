@@ -36,6 +36,9 @@ class MainWindow: public QDialog {
     private slots:    
         void userQueryDialog();
         void restoreSystemQueryDialog();
+        void masterSeedDialog();
+        void matchEngineDialog();
+        void engineCountersDialog();
 
         int progress(const bool = false);
         int about();
@@ -50,6 +53,8 @@ class MainWindow: public QDialog {
         void statistics();
         void teams();
         void table();
+        void seasonForecast();
+        void quickSimCalibration();
         void nextMatch();
 };
 
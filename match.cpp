@@ -3,9 +3,15 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <QDataStream>
 #include <QDebug>
+#include <QSet>
 #include <algorithm>
+#include <array>
+#include <functional>
 #include "match/match.h"
+#include "match/match_events.h"
+#include "shared/random_stream.h"
 
 const QString Match::unknownReferee = QStringLiteral("<not assigned>");
 const QString Match::unknownVenue = QStringLiteral("neutral ground");
@@ -15,21 +21,13 @@ Match::Match(const uint32_t code, const QDateTime & datetime, Team * const hosts
              const bool storedInDb, const QPair<MatchType::ToPlayOff, void *> & playoffsRule):
     _code(code), _date(datetime.date()), _time(datetime.time()), _playoffsRule(playoffsRule), _teamHosts(hosts),
     _teamVisitors(visitors), _type(type), _referee(referee), _venue(venue), _timePlayed(MatchTime()),
-    _scoreHosts(new MatchScore()), _scoreVisitors(new MatchScore()), _played(played), _storedInDb(storedInDb) {}
+    _scoreHosts(new MatchScore()), _scoreVisitors(new MatchScore()), _played(played), _storedInDb(storedInDb),
+    _playerRecords(nullptr), _suspensionClock(0), _noOfSuspensions{0, 0} {}
 
 Match::~Match() {
 
-    for (auto it: this->_pointsHostsPlayers.values())
-        delete it;
-
-    for (auto it: this->_pointsVisitorsPlayers.values())
-        delete it;
-
-    for (auto it: this->_statsHostsPlayers.values())
-        delete it;
-
-    for (auto it: this->_statsVisitorsPlayers.values())
-        delete it;
+    // all players' statistics and points of the match are released at once
+    delete[] this->_playerRecords;
 
     switch (this->playoffsType()) {
 
@@ -112,7 +110,8 @@ Team * Match::winner(const TeamResults::ResultType result) const {
     return nullptr;
 }
 
-Referee * Match::drawReferee(const QVector<Referee *> & referees, const QVector<Referee *> & excluded) const {
+// referee is drawn from match's preparation stream (see RandomStream::forPreparationOf) => the same seed gives the same referee
+Referee * Match::drawReferee(const QVector<Referee *> & referees, const QVector<Referee *> & excluded, RandomStream & random) const {
 
     // referees can be either directly assigned for a given match (in db in Fixture table) or drawed from a pool
     // of referees who are appointed for currently played competition (in db in RefereeInCompetition table); because
@@ -126,7 +125,7 @@ Referee * Match::drawReferee(const QVector<Referee *> & referees, const QVector<
     if (eligibleReferees.empty())
         return nullptr;
 
-    const uint16_t pos = RandomValue::generateRandomInt<uint8_t>(0, eligibleReferees.size()-1);
+    const uint16_t pos = random.generateRandomInt<uint16_t>(0, eligibleReferees.size()-1);
 
     return eligibleReferees.at(pos);
 }
@@ -144,10 +143,7 @@ QString Match::venue() const {
 // returns true if no player of given team has been sin-binned so far (in this match)
 bool Match::noSuspensions(const MatchType::Location loc) const {
 
-    const uint8_t noOfSuspensions = std::count_if(this->sinBin().cbegin(), this->sinBin().cend(),
-                                    [&loc](const SinBin & sinBin) { return (sinBin.team() == loc); });
-
-    return !static_cast<bool>(noOfSuspensions);
+    return (this->_noOfSuspensions[static_cast<uint8_t>(loc)] == 0);
 }
 
 // returns true if no player of given team has been replaced (substituted) so far (in this match)
@@ -182,23 +178,49 @@ void Match::addSuspension(Player * const player, const uint8_t number, const Mat
     const SinBin sinBinProperties(player, number, team, type, suspensionAtMinute);
 
     this->_sinBin.push_back(sinBinProperties);
+    this->enqueueSuspension(this->_sinBin.size()-1);
+
+    return;
+}
+
+// every suspension is counted (for its team); only those with minutes remaining (i.e. not red cards) enter the queue
+// of active suspensions (min-heap ordered by time of return measured by suspension clock)
+void Match::enqueueSuspension(const int index) {
+
+    const SinBin & sinBin = this->_sinBin.at(index);
+    ++this->_noOfSuspensions[static_cast<uint8_t>(sinBin.team())];
+
+    if (sinBin.minutesRemaining() == 0)
+        return;
+
+    this->_activeSuspensions.push_back(qMakePair<uint16_t, int>(this->_suspensionClock + sinBin.minutesRemaining(), index));
+    std::push_heap(this->_activeSuspensions.begin(), this->_activeSuspensions.end(), std::greater<QPair<uint16_t, int>>());
 
     return;
 }
 
+// only active suspensions are visited (expired ones and red cards are not) and returning players are taken
+// from the top of the queue
 void Match::deductSuspensionMinutesRemaining(QVector<QPair<Player *, uint8_t>> & returningPlayers,
                                              uint8_t & update, const uint8_t minutes) {
 
-    for (QVector<SinBin>::iterator it = _sinBin.begin(); it != _sinBin.end(); ++it) {
+    this->_suspensionClock += minutes;
+
+    // minutes remaining are kept up to date for display (see suspensionInfo)
+    for (const auto & active: this->_activeSuspensions) {
 
-        // it is not necessary to introduce special logic for red cards because in such a case minutesRemaining = 0
-        const uint8_t minutesToDeduct = std::min(it->minutesRemaining(), minutes);
+        SinBin & sinBin = this->_sinBin[active.second];
+        sinBin.deductMinutesRemaining(std::min(sinBin.minutesRemaining(), minutes));
+    }
 
-        if (it->deductMinutesRemaining(minutesToDeduct)) {
+    while (!this->_activeSuspensions.isEmpty() && this->_activeSuspensions.constFirst().first <= this->_suspensionClock) {
 
-            returningPlayers.push_back(it->player());
-            update |= static_cast<uint8_t>(it->team())+1;
-        }
+        std::pop_heap(this->_activeSuspensions.begin(), this->_activeSuspensions.end(), std::greater<QPair<uint16_t, int>>());
+        const SinBin & sinBin = this->_sinBin.at(this->_activeSuspensions.constLast().second);
+        this->_activeSuspensions.removeLast();
+
+        returningPlayers.push_back(sinBin.player());
+        update |= static_cast<uint8_t>(sinBin.team())+1;
     }
     return;
 }
@@ -215,14 +237,69 @@ bool Match::addSubstitution(Player * const playerOut, Player * const PlayerIn, c
     return firstSubstitutionAtThisMinute;
 }
 
+// records of both teams are kept in one block (arena) which is allocated when the first record is needed (matches which
+// haven't been played yet don't take up any memory); slot of a player = his shirt number (unique within a team during
+// a match) => record is found by array index; linear search is used only if player's shirt number has changed since
+// return value: -1 if player has no record (and create = false) or if all slots of a team are taken already
+int16_t Match::playerSlot(const MatchType::Location loc, Player * const player, const bool create) {
+
+    if (loc != MatchType::Location::HOSTS && loc != MatchType::Location::VISITORS)
+        return -1;
+
+    if (this->_playerRecords == nullptr) {
+
+        if (!create)
+            return -1;
+        this->_playerRecords = new PlayerRecord[2 * slotsPerTeam];
+    }
+
+    PlayerRecord * const records = this->_playerRecords + static_cast<uint8_t>(loc) * slotsPerTeam;
+    const uint8_t shirtNo = player->shirtNo();
+
+    if (shirtNo < slotsPerTeam && records[shirtNo].player == player)
+        return (static_cast<uint8_t>(loc) * slotsPerTeam + shirtNo);
+
+    for (uint8_t slot = 0; slot < slotsPerTeam; ++slot)
+        if (records[slot].player == player)
+            return (static_cast<uint8_t>(loc) * slotsPerTeam + slot);
+
+    if (!create)
+        return -1;
+
+    // preferred slot is taken by another player (or doesn't exist) => first free slot is used
+    uint8_t slot = shirtNo;
+    if (!(shirtNo < slotsPerTeam && records[shirtNo].player == nullptr)) {
+
+        slot = 0;
+        while (slot < slotsPerTeam && records[slot].player != nullptr)
+            ++slot;
+
+        if (slot == slotsPerTeam) {
+
+            qDebug() << "No free slot for statistics of player " << player->fullName() << " (match " << this->_code << ").";
+            return -1;
+        }
+    }
+
+    records[slot].player = player;
+    return (static_cast<uint8_t>(loc) * slotsPerTeam + slot);
+}
+
+const Match::PlayerRecord * Match::playerRecord(const MatchType::Location loc, Player * const player) const {
+
+    const int16_t slot = const_cast<Match *>(this)->playerSlot(loc, player, false);
+    return (slot < 0) ? nullptr : &(this->_playerRecords[slot]);
+}
+
 // called for every player who makes points in a match (=> not for every player who plays!)
 void Match::addNewPointsRecordForPlayer(const MatchType::Location loc, Player * const player) {
 
-    if (loc == MatchType::Location::HOSTS)
-        this->_pointsHostsPlayers.insert(player, new PlayerPoints());
+    const int16_t slot = this->playerSlot(loc, player, true);
+    if (slot < 0)
+        return;
 
-    if (loc == MatchType::Location::VISITORS)
-        this->_pointsVisitorsPlayers.insert(player, new PlayerPoints());
+    this->_playerRecords[slot].points = PlayerPoints();
+    this->_playerRecords[slot].hasPoints = true;
 
     return;
 }
@@ -230,56 +307,55 @@ void Match::addNewPointsRecordForPlayer(const MatchType::Location loc, Player *
 // use during a match
 PlayerPoints * Match::playerPoints(const MatchType::Location loc, Player * const player) {
 
-    if (loc == MatchType::Location::HOSTS) {
-
-        if (!_pointsHostsPlayers.contains(player))
-            this->addNewPointsRecordForPlayer(loc, player);
-        return _pointsHostsPlayers[player];
-    }
-
-    if (loc == MatchType::Location::VISITORS) {
+    const int16_t slot = this->playerSlot(loc, player, true);
+    if (slot < 0)
+        return nullptr;
 
-        if (!_pointsVisitorsPlayers.contains(player))
-            this->addNewPointsRecordForPlayer(loc, player);
-        return _pointsVisitorsPlayers[player];
-    }
+    if (!this->_playerRecords[slot].hasPoints)
+        this->addNewPointsRecordForPlayer(loc, player);
 
-    return nullptr;
+    return &(this->_playerRecords[slot].points);
 }
 
 // use in any other situation
 PlayerPoints * Match::playerPoints_ReadOnly(const MatchType::Location loc, Player * const player) const {
 
-    if (loc == MatchType::Location::HOSTS)
-        return _pointsHostsPlayers.value(player, nullptr);
+    const PlayerRecord * const record = this->playerRecord(loc, player);
+    return (record == nullptr || !record->hasPoints) ? nullptr : const_cast<PlayerPoints *>(&(record->points));
+}
+
+// all players who have made points in the match
+QMap<Player *, PlayerPoints *> Match::allPlayersPoints(const MatchType::Location loc) const {
 
-    if (loc == MatchType::Location::VISITORS)
-        return _pointsVisitorsPlayers.value(player, nullptr);
+    QMap<Player *, PlayerPoints *> players;
+    if (this->_playerRecords == nullptr || (loc != MatchType::Location::HOSTS && loc != MatchType::Location::VISITORS))
+        return players;
 
-    return nullptr;
+    PlayerRecord * const records = this->_playerRecords + static_cast<uint8_t>(loc) * slotsPerTeam;
+    for (uint8_t slot = 0; slot < slotsPerTeam; ++slot)
+        if (records[slot].hasPoints)
+            players.insert(records[slot].player, &(records[slot].points));
+
+    return players;
 }
 
 // called for every player who plays in a match
 void Match::addNewStatsRecordForPlayer(const MatchType::Location loc, Player * const player) {
 
-    if (loc == MatchType::Location::HOSTS)
-        this->_statsHostsPlayers.insert(player, new PlayerStats());
+    const int16_t slot = this->playerSlot(loc, player, true);
+    if (slot < 0)
+        return;
 
-    if (loc == MatchType::Location::VISITORS)
-        this->_statsVisitorsPlayers.insert(player, new PlayerStats());
+    this->_playerRecords[slot].stats = PlayerStats();
+    this->_playerRecords[slot].hasStats = true;
 
     return;
 }
 
 PlayerStats * Match::playerStats(const MatchType::Location loc, Player * const player) {
 
-    if (loc == MatchType::Location::HOSTS)
-        return _statsHostsPlayers.value(player, nullptr);
-
-    if (loc == MatchType::Location::VISITORS)
-        return _statsVisitorsPlayers.value(player, nullptr);
-
-    return nullptr;
+    const int16_t slot = this->playerSlot(loc, player, false);
+    return (slot < 0 || !this->_playerRecords[slot].hasStats) ? nullptr : &(this->_playerRecords[slot].stats);
 }
 
 TeamResults::ResultType Match::resultTypeForTeam(const MatchType::Location loc) const {
@@ -335,3 +411,211 @@ double Match::playersOnPitchRatio(const MatchType::Location loc) const {
 
     return ((loc == MatchType::Location::HOSTS) ? ratio : (1/ratio));
 }
+
+Player * Match::playerByCode(const MatchType::Location loc, const uint32_t code) const {
+
+    const Team * const team = this->team(loc);
+    if (team == nullptr || code == 0)
+        return nullptr;
+
+    for (auto player: team->squad())
+        if (player->code() == code)
+            return player;
+
+    return nullptr;
+}
+
+// state of a match in progress (part of GamePlay's snapshot): score and players' statistics are not stored as such,
+// they are rebuilt from event log instead; only values which are recorded at the end of match (possession, territory
+// and minutes played) are stored separately; players are referred to by their codes
+void Match::writeState(QDataStream & stream) const {
+
+    this->_timePlayed.writeTo(stream);
+    this->events().writeTo(stream);
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+        stream << static_cast<quint16>(this->score(loc)->possession()) << static_cast<quint16>(this->score(loc)->territory());
+
+        QVector<QPair<uint32_t, uint16_t>> minutesPlayed;
+        for (auto player: this->team(loc)->squad()) {
+
+            const PlayerRecord * const record = this->playerRecord(loc, player);
+            if (record != nullptr && record->hasStats)
+                minutesPlayed.append(qMakePair(player->code(),
+                    static_cast<uint16_t>(record->stats.getStatsValue(StatsType::NumberOf::MINS_PLAYED))));
+        }
+
+        stream << static_cast<quint8>(minutesPlayed.size());
+        for (const auto & minutes: minutesPlayed)
+            stream << minutes.first << minutes.second;
+    }
+
+    stream << static_cast<quint8>(this->_sinBin.size());
+    for (const auto & sinBin: this->_sinBin)
+        stream << sinBin.player().first->code() << static_cast<quint8>(sinBin.player().second) << static_cast<quint8>(sinBin.team())
+               << static_cast<quint8>(sinBin.type()) << static_cast<quint8>(sinBin.minute())
+               << static_cast<quint8>(sinBin.minutesRemaining());
+
+    stream << static_cast<quint8>(this->_replacements.size());
+    for (const auto & substitution: this->_replacements)
+        stream << substitution.playerOut()->code() << substitution.playerIn()->code()
+               << static_cast<quint8>(substitution.team()) << static_cast<quint8>(substitution.minute());
+
+    return;
+}
+
+// match must not have been started yet (its score and players' records are built up from scratch)
+// return value: false if data is corrupted or doesn't belong to teams of this match (match is left untouched then:
+// everything is read and checked first, the match is changed only when the whole state is valid)
+bool Match::readState(QDataStream & stream) {
+
+    MatchTime timePlayed = this->_timePlayed;
+    MatchEventLog log;
+
+    if (!timePlayed.readFrom(stream) || !log.readFrom(stream))
+        return false;
+
+    // players' records are created when a player goes on pitch (at start of match or as a replacement);
+    // values recorded at the end of match can't be found in log of a match in progress
+    QSet<const Player *> playersWithStats;
+    for (const auto & record: log.records()) {
+
+        if (record.type == MatchEvent::Type::MINUTES_PLAYED || record.type == MatchEvent::Type::POSSESSION ||
+            record.type == MatchEvent::Type::TERRITORY)
+            return false;
+        if (record.type != MatchEvent::Type::PLAYER_STATS)
+            continue;
+
+        const Player * const player = this->playerByCode(static_cast<MatchType::Location>(record.team), record.player);
+        if (player == nullptr)
+            return false;
+        if (static_cast<StatsType::NumberOf>(record.outcome) == StatsType::NumberOf::GAMES_PLAYED)
+            playersWithStats.insert(player);
+        if (!playersWithStats.contains(player))
+            return false;
+    }
+
+    std::array<quint16, 2> possession = {}, territory = {};
+    std::array<QVector<QPair<Player *, quint16>>, 2> minutesPlayed;
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+
+        quint8 noOfPlayers = 0;
+        stream >> possession[i] >> territory[i] >> noOfPlayers;
+
+        for (uint8_t j = 0; j < noOfPlayers; ++j) {
+
+            quint32 code = 0;
+            quint16 minutes = 0;
+            stream >> code >> minutes;
+
+            Player * const player = this->playerByCode(loc, code);
+            if (player == nullptr || !playersWithStats.contains(player))
+                return false;
+            minutesPlayed[i].append(qMakePair(player, minutes));
+        }
+    }
+
+    quint8 noOfSuspensions = 0;
+    stream >> noOfSuspensions;
+
+    QVector<SinBin> sinBins;
+    for (uint8_t i = 0; i < noOfSuspensions; ++i) {
+
+        quint32 code = 0;
+        quint8 number = 0, team = 0, type = 0, minute = 0, minutesRemaining = 0;
+        stream >> code >> number >> team >> type >> minute >> minutesRemaining;
+
+        Player * const player = this->playerByCode(static_cast<MatchType::Location>(team), code);
+        if (player == nullptr)
+            return false;
+
+        SinBin sinBin(player, number, static_cast<MatchType::Location>(team),
+                      static_cast<MatchActionSubtype::MatchActivityType>(type), minute);
+        sinBin.deductMinutesRemaining(sinBin.minutesRemaining() - std::min(sinBin.minutesRemaining(), minutesRemaining));
+        sinBins.push_back(sinBin);
+    }
+
+    quint8 noOfReplacements = 0;
+    stream >> noOfReplacements;
+
+    QVector<Substitution> replacements;
+    for (uint8_t i = 0; i < noOfReplacements; ++i) {
+
+        quint32 codeOut = 0, codeIn = 0;
+        quint8 team = 0, minute = 0;
+        stream >> codeOut >> codeIn >> team >> minute;
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(team);
+        Player * const playerOut = this->playerByCode(loc, codeOut);
+        Player * const playerIn = this->playerByCode(loc, codeIn);
+        if (playerOut == nullptr || playerIn == nullptr)
+            return false;
+
+        replacements.push_back(Substitution(playerOut, playerIn, loc, minute));
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    // whole state is valid => it can be applied
+    this->_timePlayed = timePlayed;
+    this->events() = log;
+
+    // score and players' records are rebuilt by the same replay as the one of a stored match (records have been checked
+    // above and when log was read); players' records are created in the same order as in GamePlay
+    MatchReplay replay(this, this->events());
+    replay.rebuild();
+
+    for (const auto & record: log.records())
+        if (record.type == MatchEvent::Type::PLAYER_STATS &&
+            static_cast<StatsType::NumberOf>(record.outcome) == StatsType::NumberOf::GAMES_PLAYED)
+            this->addNewStatsRecordForPlayer(static_cast<MatchType::Location>(record.team),
+                                             this->playerByCode(static_cast<MatchType::Location>(record.team), record.player));
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+        *(this->score(loc)) = *(replay.score(i));
+
+        for (auto it = replay.playerStats(i).cbegin(); it != replay.playerStats(i).cend(); ++it)
+            *(this->playerStats(loc, this->playerByCode(loc, it.key()))) = *(it.value());
+
+        // points of a team (e.g. penalty try) aren't assigned to any player
+        for (auto it = replay.playerPoints(i).cbegin(); it != replay.playerPoints(i).cend(); ++it) {
+
+            Player * const player = this->playerByCode(loc, it.key());
+            if (player != nullptr)
+                *(this->playerPoints(loc, player)) = *(it.value());
+        }
+    }
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+
+        this->score(loc)->possession(possession[i]);
+        this->score(loc)->territory(territory[i]);
+        for (const auto & minutes: minutesPlayed[i])
+            this->playerStats(loc, minutes.first)->addMinutesPlayed(minutes.second);
+    }
+
+    this->_sinBin.clear();
+    this->_activeSuspensions.clear();
+    this->_suspensionClock = 0;
+    this->_noOfSuspensions[0] = this->_noOfSuspensions[1] = 0;
+
+    for (const auto & sinBin: sinBins) {
+
+        this->_sinBin.push_back(sinBin);
+        this->enqueueSuspension(this->_sinBin.size()-1);
+    }
+
+    this->_replacements = replacements;
+
+    return true;
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef CONDITION_BATCH_H
+#define CONDITION_BATCH_H
+
+#include <QVector>
+#include <array>
+#include <cstdint>
+#include "match/match.h"
+#include "player/player.h"
+#include "shared/random_stream.h"
+
+// time-dependent changes of players' condition (fatigue, morale) made for all players on pitch at once: values needed
+// are gathered into contiguous arrays first (one lookup per player), random numbers are drawn in one batch and decisions
+// are made by a plain loop over these arrays (no branches, no calls => vectorized by compiler); only then are changes
+// written back to players; threshold crossings which require further action (injury, substitution) are returned as events
+class ConditionBatch {
+
+    public:
+        static constexpr uint8_t maxPlayers = 32; // both teams on pitch
+
+        enum class Crossing: uint8_t {
+
+            EXHAUSTED,  // fatigue was at minimum already => player is injured
+            CRITICAL    // fatigue has dropped to critical level => player should be replaced
+        };
+
+        struct Event {
+
+            Player * player;
+            MatchType::Location team;
+            Crossing crossing;
+            uint8_t fatigue;        // new value (CRITICAL only)
+        };
+
+        ConditionBatch(): _size(0) {}
+
+        inline bool isEmpty() const { return (_size == 0); }
+        inline void clear() { _size = 0; return; }
+        void add(Player * const, const MatchType::Location);
+
+        // players added for fatigue check; events are appended in order in which the players were added
+        void changeFatigue(RandomStream &, QVector<Event> &);
+        // players added for change in morale (each player with probability of 25 %)
+        void changeMorale(RandomStream &, const bool, const uint8_t);
+
+    private:
+        void decide();
+
+        uint8_t _size;
+        std::array<Player *, maxPlayers> _players;
+        std::array<MatchType::Location, maxPlayers> _team;
+        std::array<uint8_t, maxPlayers> _probability;   // of change (in %)
+        std::array<uint8_t, maxPlayers> _draw;          // random number from <1, 100>
+        std::array<uint8_t, maxPlayers> _change;        // 1 = condition changes
+};
+
+#endif // CONDITION_BATCH_H
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef ENGINE_COUNTERS_H
+#define ENGINE_COUNTERS_H
+
+#include <QString>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+// always-on counters of what match engine (GamePlay) spends its steps on: actions and their outcomes, draws of players,
+// substitutions and time of every step (histogram); counters are shared by all matches (incl. those played in parallel)
+// and are incremented with relaxed atomics => cost of a counter is one uncontended atomic add
+class EngineCounters {
+
+    public:
+        static constexpr uint16_t numberOfTypes = std::numeric_limits<uint8_t>::max() + 1;
+        static constexpr uint8_t numberOfTimeBuckets = 16; // bucket i = step took less than 2^i microseconds (last: more)
+
+        enum Counter: uint8_t {
+
+            MATCHES, STEPS, RECEIVER_DRAWS, RECEIVER_NOT_FOUND, SPECIALIST_SELECTIONS,
+            SUBSTITUTIONS, INJURY_SUBSTITUTIONS, PENALTIES, NO_OF_COUNTERS
+        };
+
+        // copy of all counters at a given moment
+        struct Values {
+
+            std::array<uint64_t, NO_OF_COUNTERS> counters;
+            std::array<uint64_t, numberOfTypes> actions;   // MatchActionType::MatchActivityBaseType
+            std::array<uint64_t, numberOfTypes> outcomes;  // MatchActionSubtype::MatchActivityType
+            std::array<uint64_t, numberOfTimeBuckets> stepTimes;
+            uint64_t stepTimeTotal;                        // in nanoseconds
+        };
+
+        // measures time of one step (from construction to destruction)
+        class StepTimer {
+
+            public:
+                StepTimer(): _start(std::chrono::steady_clock::now()) {}
+                ~StepTimer() {
+
+                    const auto duration = std::chrono::steady_clock::now() - _start;
+                    EngineCounters::instance().stepTime(
+                        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+                }
+
+            private:
+                const std::chrono::steady_clock::time_point _start;
+        };
+
+        static inline EngineCounters & instance() { static EngineCounters counters; return counters; }
+
+        inline void increment(const Counter counter)
+            { _counters[counter].fetch_add(1, std::memory_order_relaxed); return; }
+        inline void action(const uint8_t type) { _actions[type].fetch_add(1, std::memory_order_relaxed); return; }
+        inline void outcome(const uint8_t type) { _outcomes[type].fetch_add(1, std::memory_order_relaxed); return; }
+
+        inline void stepTime(const uint64_t nanoseconds) {
+
+            uint8_t bucket = 0;
+            for (uint64_t microseconds = nanoseconds / 1000; microseconds > 0 && bucket < numberOfTimeBuckets-1; microseconds >>= 1)
+                ++bucket;
+
+            _counters[STEPS].fetch_add(1, std::memory_order_relaxed);
+            _stepTimes[bucket].fetch_add(1, std::memory_order_relaxed);
+            _stepTimeTotal.fetch_add(nanoseconds, std::memory_order_relaxed);
+            return;
+        }
+
+        Values values() const;
+        void reset();
+
+        static QString asHtml(const Values &);
+
+    private:
+        EngineCounters() { this->reset(); }
+        EngineCounters(const EngineCounters &) = delete;
+        EngineCounters & operator=(const EngineCounters &) = delete;
+
+        std::atomic<uint64_t> _counters[NO_OF_COUNTERS];
+        std::atomic<uint64_t> _actions[numberOfTypes];
+        std::atomic<uint64_t> _outcomes[numberOfTypes];
+        std::atomic<uint64_t> _stepTimes[numberOfTimeBuckets];
+        std::atomic<uint64_t> _stepTimeTotal;
+};
+
+#endif // ENGINE_COUNTERS_H
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef GAMEPLAY_OBSERVER_H
+#define GAMEPLAY_OBSERVER_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <cstdint>
+#include "match/match.h"
+#include "match/matchperiod.h"
+#include "player/player.h"
+
+// how (and whether) a match played by GamePlay is presented
+namespace MatchDisplay {
+
+    enum Type: uint8_t { NONE = 0, DETAIL = 1 /* MatchWidget */, PROGRESS = 2 /* FixturesWidget */ };
+}
+
+// GamePlay reports everything that happens during a match through this interface and asks it for manager's decisions;
+// GamePlay itself never touches widgets, message boxes or main window => with no observer attached (nullptr) a match
+// is played headless (all decisions are made automatically)
+// note: default implementations do nothing (notifications) or return the automatic choice (decisions)
+class GamePlayObserver {
+
+    public:
+        enum class Notification: uint8_t { INFORMATION, WARNING, CRITICAL };
+
+        virtual ~GamePlayObserver() {}
+
+        virtual MatchDisplay::Type display() const = 0;
+
+        // match progress (both displays)
+        virtual void matchStarted() {}
+        virtual void matchFinished() {}
+        virtual void dateTimeChanged() {}
+        virtual void timeRefreshed(const QString &, const uint16_t, const bool = true) {}
+        virtual void resetMatchProgress(const MatchPeriods * const, const MatchPeriod::TimePeriod, const bool = true) {}
+        virtual void updateScore(const MatchType::Location) {}
+        virtual MatchPeriod::TimePeriod playUntilAtLeastPeriod() const { return MatchPeriod::TimePeriod::UNDETERMINED; }
+
+        // match details (detailed display only)
+        virtual void updatePeriod(const QString &) {}
+        virtual void logRecord(const QString &) const {}
+        virtual bool extendedLog() const { return false; }
+        virtual QString currentScore() const { return QString(); }
+        virtual QString pointsInfoForLog(const uint8_t) const { return QString(); }
+        virtual QString dominationStatsForLog(const double, const uint8_t, const bool = false) const { return QString(); }
+        virtual void updateStatisticsUI(const MatchType::Location, const QString &, const QString &, const bool = true) const {}
+        virtual void displayPoints(const QMap<PointEvent, QStringList> &, const MatchType::Location) const {}
+        virtual void updatePackWeight() const {}
+        virtual void updatePlayer(const QString &, const MatchType::Location) const {}
+        virtual void possessionChanged(const MatchType::Location) const {}
+        virtual void phasesChanged(const MatchType::Location, const uint8_t) const {}
+        virtual void ballPositionChanged(const int8_t) const {}
+        virtual void bonusPointGained(const MatchType::Location) const {}
+        virtual void timeStoppedMessageBox(const QString &, const QStringList & = QStringList()) {}
+        virtual void notify(const Notification, const QString &, const QString &) const {}
+        virtual bool diagnosticData(const QString &) const { return true; } // false = stop diagnostic mode
+
+        // manager's decisions (asked for in case of my team only)
+        virtual bool sideOverBall() const { return false; }
+        virtual Player * selectPlayerForAction(const QString &, const QMap<uint32_t, Player *> &, bool * const selected) const
+            { *selected = false; return nullptr; }
+        virtual QString selectActionAfterPenalty(const QString &, const QStringList & options) const { return options.first(); }
+        virtual uint8_t conversionDistance(const QString &, const uint8_t value, const uint8_t, const uint8_t,
+                                           bool * const) const { return value; }
+        virtual bool substituteTiredPlayer(const QString &) const { return true; }
+        virtual QString playerForSubstitution(Player * const) const { return QString(); }
+        virtual QString selectPlayerForSubstitution(const QStringList &, const bool, bool * const selected) const
+            { *selected = false; return QString(); }
+        virtual bool substitutionRequested() const { return false; }
+        virtual void substitutionRequestHandled() {}
+};
+
+#endif // GAMEPLAY_OBSERVER_H
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef MATCH_BRANCHING_H
+#define MATCH_BRANCHING_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <cstdint>
+#include "match/gameplay.h"
+#include "match/match.h"
+#include "settings/config.h"
+#include "shared/datetime.h"
+#include "team.h"
+
+// what-if analysis: current state of a match in progress is forked into alternative continuations (branches) which
+// differ in one decision of my team; every branch is played to the end (headless, by GamePlay) many times and
+// branches are compared by my team's probability of winning; state is forked once (snapshot of gameplay + copies of
+// both teams) and shared by all rollouts (snapshot is implicitly shared => it's never copied), every rollout restores
+// its own match from it => rollouts can be played in parallel and the match itself isn't affected
+class MatchBranching {
+
+    public:
+        static constexpr uint16_t defaultNumberOfRollouts = 64;    // per branch
+        static constexpr uint16_t defaultSubstitutionDelay = 600;  // in seconds
+
+        enum class Decision: uint8_t {
+
+            CONTINUE,               // no change (baseline)
+            SUBSTITUTE_NOW,
+            SUBSTITUTE_LATER,       // after defaultSubstitutionDelay
+            PENALTY_KICK_AT_GOAL,   // next penalty awarded to my team
+            PENALTY_KICK_TO_TOUCH
+        };
+
+        struct Branch {
+
+            Decision decision;
+            uint32_t playerOut = 0; // players' codes (substitutions only)
+            uint32_t playerIn = 0;
+        };
+
+        // outcome of a single rollout (one continuation of match)
+        struct Rollout {
+
+            uint16_t branch;
+            bool played;            // false if branch couldn't be played (e.g. substitution isn't possible anymore)
+            TeamResults::ResultType result;
+        };
+
+        // sum of all rollouts: [branch][win/draw/loss]
+        typedef QVector<std::array<uint32_t, 3>> Summary;
+
+        // single rollout for QtConcurrent::mappedReduced (functor must define result_type)
+        struct RolloutFunctor {
+
+            typedef Rollout result_type;
+
+            explicit RolloutFunctor(const MatchBranching * const branching): _branching(branching) {}
+            inline Rollout operator()(const uint32_t rollout) const { return _branching->play(rollout); }
+
+            const MatchBranching * _branching;
+        };
+
+        MatchBranching() = delete;
+        MatchBranching(Settings * const, const DateTime &, Match * const, Team * const, const GamePlay * const,
+                       const QVector<Branch> &);
+        ~MatchBranching();
+
+        inline int numberOfBranches() const { return _branches.size(); }
+        static QString description(const Branch &, const Team * const);
+
+        Rollout play(const uint32_t) const;
+        static void add(Summary &, const Rollout &);
+
+        static double winProbability(const Summary &, const int);
+        QString summaryAsHtml(const Summary &) const;
+
+    private:
+        Settings * _settings;
+        DateTime _dateTime;
+        Match * _match;
+        MatchType::Location _myTeam;
+        QVector<Branch> _branches;
+
+        QByteArray _snapshot;
+        Team * _teams[2];   // copies of both teams at the moment of fork
+        QString _forkedAt;  // match time
+};
+
+#endif // MATCH_BRANCHING_H
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef MATCH_EVENTS_H
+#define MATCH_EVENTS_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include "match/gameplay_observer.h"
+#include "match/matchscore.h"
+#include "player/player_points.h"
+#include "player/player_stats.h"
+
+class Match;
+
+namespace MatchEvent {
+
+    // every change of match score (team statistics) or of player's statistics made by GamePlay has its own event type
+    enum class Type: uint8_t {
+
+        TRY, CONVERSION, PENALTY_GOAL, DROP_GOAL, SHOOT_OUT,                        // points (value = goals in shoot-out)
+        PASS, TACKLE, LINEOUT, SCRUM,                                               // outcome = MatchScore::Passes/Tackles/...
+        RUN, KICK, CARRY,                                                           // value = metres
+        PENALTY_INFRINGEMENT, HANDLING_ERROR, OFFLOAD, YELLOW_CARD, RED_CARD,       // team statistics
+        PLAYER_STATS,                                                               // outcome = StatsType::NumberOf
+        MINUTES_PLAYED, POSSESSION, TERRITORY                                       // totals at the end of match (value)
+    };
+    constexpr uint8_t numberOfTypes = static_cast<uint8_t>(Type::TERRITORY) + 1;
+
+    // one event = 12 bytes (when stored: 11 bytes before compression)
+    struct Record {
+
+        uint16_t second;  // time played (in seconds) when event has occurred
+        Type type;
+        uint8_t team;     // MatchType::Location
+        uint32_t player;  // player's code (0 = team event)
+        uint16_t value;
+        uint8_t outcome;
+    };
+}
+
+// compact binary log of everything that has happened in a match (appended to by GamePlay during the match);
+// score and statistics of a match can be rebuilt from it (see MatchReplay) => stored logs take up little space
+class MatchEventLog {
+
+    public:
+        MatchEventLog() {}
+        ~MatchEventLog() {}
+
+        inline void record(const uint16_t second, const MatchEvent::Type type, const uint8_t team, const uint32_t player = 0,
+                           const uint16_t value = 0, const uint8_t outcome = 0)
+            { _records.append({ second, type, team, player, value, outcome }); return; }
+
+        inline const QVector<MatchEvent::Record> & records() const { return _records; }
+        inline bool isEmpty() const { return _records.isEmpty(); }
+        inline void clear() { _records.clear(); return; }
+
+        QByteArray serialize() const;
+        bool deserialize(const QByteArray &);
+
+        // raw (uncompressed) records => used in snapshot of a match in progress where speed matters more than size
+        void writeTo(QDataStream &) const;
+        bool readFrom(QDataStream &);
+
+        // archive = one file per session, logs of individual matches are appended to it (key = match's code)
+        static const QString archiveFileName;
+        bool appendToArchive(const QString &, const uint32_t) const;
+        bool loadFromArchive(const QString &, const uint32_t);
+
+    private:
+        static bool isValid(const MatchEvent::Record &);
+
+        static constexpr uint32_t formatVersion = 1;
+        static constexpr uint8_t storedRecordSize = 11;     // bytes per record in stream (see writeTo)
+        static constexpr uint32_t maxNumberOfRecords = 1 << 20;
+
+        QVector<MatchEvent::Record> _records;
+};
+
+// rebuilds score and players' statistics of a match from its event log (without playing the match again)
+// and presents them via GamePlayObserver (i.e. in MatchWidget); rebuilt values are kept apart from the match itself
+class MatchReplay {
+
+    public:
+        MatchReplay() = delete;
+        MatchReplay(Match * const, const MatchEventLog &);
+        ~MatchReplay();
+
+        void rebuild();
+        void replay(GamePlayObserver * const);
+        void display(GamePlayObserver * const) const;
+
+        inline const MatchScore * score(const uint8_t team) const { return &(_score[team]); }
+        inline const QMap<uint32_t, PlayerStats *> & playerStats(const uint8_t team) const { return _playerStats[team]; }
+        inline const QMap<uint32_t, PlayerPoints *> & playerPoints(const uint8_t team) const { return _playerPoints[team]; }
+
+    private:
+        void apply(const MatchEvent::Record &);
+        Player * player(const uint8_t, const uint32_t) const;
+        QString eventForLog(const MatchEvent::Record &) const;
+        void updateStatisticsUI(GamePlayObserver * const, const MatchType::Location) const;
+        void displayPoints(GamePlayObserver * const, const MatchType::Location) const;
+
+        PlayerStats * stats(const uint8_t, const uint32_t);
+        PlayerPoints * points(const uint8_t, const uint32_t);
+
+        Match * _match;
+        const MatchEventLog & _log;
+
+        MatchScore _score[2];
+        QMap<uint32_t, PlayerStats *> _playerStats[2];   // key = player's code
+        QMap<uint32_t, PlayerPoints *> _playerPoints[2]; // key = player's code
+};
+
+#endif // MATCH_EVENTS_H
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef PROBABILITY_TABLE_H
+#define PROBABILITY_TABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+// probabilities of match activities adjusted by difference between rankings of both teams (see GamePlay::probability);
+// index = team in possession (MatchType::Location), perspective (in possession/opponent) and activity type;
+// rankings are set at kick-off, every value is calculated only once (on its first use) and then just looked up
+class ProbabilityTable {
+
+    public:
+        static constexpr uint16_t numberOfTypes = std::numeric_limits<uint8_t>::max() + 1;
+        static constexpr uint8_t maxRankingDiff = 20;
+
+        ProbabilityTable() { this->invalidate(); }
+        ~ProbabilityTable() {}
+
+        // has to be called again whenever team's ranking (or other input of adjustment) changes during a match
+        inline void build(const uint8_t hostsRanking, const uint8_t visitorsRanking) {
+
+            const int16_t rankingDiff = static_cast<int16_t>(visitorsRanking) - static_cast<int16_t>(hostsRanking);
+            const int16_t cappedDiff = std::min<int16_t>(std::abs(rankingDiff), maxRankingDiff);
+
+            // the better the ranking of team in possession (the lower the number) the higher the probability
+            _rankingAdjustment[0] = static_cast<int8_t>((rankingDiff < 0) ? -cappedDiff : cappedDiff);
+            _rankingAdjustment[1] = -_rankingAdjustment[0];
+
+            this->invalidate();
+            return;
+        }
+
+        inline void invalidate() { std::memset(_adjusted, 0, sizeof(_adjusted)); return; }
+
+        // 0 = value hasn't been calculated yet (valid values are always within <1, 99>)
+        inline uint8_t & at(const uint8_t teamInPossession, const bool opponent, const uint8_t type)
+            { return _adjusted[teamInPossession][static_cast<uint8_t>(opponent)][type]; }
+
+        inline uint8_t adjust(const uint8_t baseProbability, const uint8_t teamInPossession, const bool opponent) const {
+
+            const int16_t adjustment = (!opponent) ? _rankingAdjustment[teamInPossession] : -_rankingAdjustment[teamInPossession];
+            return static_cast<uint8_t>(std::min<int16_t>(std::max<int16_t>(baseProbability + adjustment, 1), 99));
+        }
+
+    private:
+        int8_t _rankingAdjustment[2] = { 0, 0 };
+        uint8_t _adjusted[2][2][numberOfTypes];
+};
+
+#endif // PROBABILITY_TABLE_H
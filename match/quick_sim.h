@@ -0,0 +1,134 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef QUICK_SIM_H
+#define QUICK_SIM_H
+
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include "match/match.h"
+#include "match/match_events.h"
+#include "match/matchperiod.h"
+#include "shared/alias_table.h"
+#include "shared/datetime.h"
+#include "shared/random_stream.h"
+#include "team.h"
+
+// alternative to GamePlay for matches which nobody watches (other teams' matches played in the background): final score
+// and statistics are drawn from a statistical model instead of being played action by action; match score, players'
+// statistics (totals and current match), event log, team results and match time are updated the same way as by GamePlay
+class QuickSim {
+
+    public:
+        enum class Engine: uint8_t { GAMEPLAY, QUICK_SIM };
+
+        // parameters of statistical model (counts are per team and match, rates are in <0, 1>)
+        struct Model {
+
+            double tries = 3.0;
+            double penaltyGoals = 1.8;
+            double dropGoals = 0.1;
+            double conversionRate = 0.7;           // adjusted by kicker's skill (the same way as in GamePlay)
+            double homeAdvantage = 1.1;
+            double rankingWeight = 0.02;           // per ranking position
+            double yellowCards = 0.5;
+            double redCards = 0.05;
+            double passes = 140.0;
+            double passesCompletedRate = 0.9;
+            double tackles = 120.0;
+            double tacklesCompletedRate = 0.88;
+            double carries = 90.0;
+            double metresRun = 380.0;
+            double metresKicked = 550.0;
+            double metresPerKick = 35.0;
+            double lineouts = 12.0;
+            double lineoutsWonRate = 0.85;
+            double scrums = 8.0;
+            double scrumsWonRate = 0.9;
+            double handlingErrors = 10.0;
+            double offloads = 8.0;
+            double penaltyInfringements = 10.0;
+            double substitutions = 5.0;
+        };
+
+        QuickSim() = delete;
+        QuickSim(DateTime &, Match * const, const Model & = Model());
+        ~QuickSim() {}
+
+        // engine used for a given match (matches of my team are always played by GamePlay)
+        static Engine engine(Match * const, Team * const);
+        static inline Engine & backgroundEngine() { static Engine engine = Engine::GAMEPLAY; return engine; }
+
+        // model used for matches played in the background (fitted by QuickSimCalibration and stored in a file);
+        // parameters missing in the file keep their default values
+        static inline Model & backgroundModel() { static Model model; return model; }
+        static const QString modelFileName;
+        static const QVector<QPair<QString, double Model::*>> parameters; // name of every parameter in model file
+        static Model loadModel(const QString &);
+        static bool saveModel(const Model &, const QString &);
+
+        void playMatch();
+
+    private:
+        // one scoring or disciplinary event (drawn in advance, applied in chronological order)
+        struct Event {
+
+            uint16_t second;
+            MatchEvent::Type type;
+            MatchType::Location team;
+        };
+
+        // players of a team on pitch before and after substitutions
+        struct Lineup {
+
+            QVector<Player *> players;
+            AliasTable<Player *> tryScorers;
+            AliasTable<Player *> tacklers;
+            AliasTable<Player *> ballCarriers;
+            Player * kicker = nullptr;
+        };
+
+        double expectedTries(const MatchType::Location) const;
+        double possessionShare(const MatchType::Location) const;
+        Lineup lineup(const MatchType::Location) const;
+        Lineup & lineupAt(const MatchType::Location, const uint16_t);
+
+        void startOfMatch();
+        void drawEvents(QVector<Event> &);
+        void playUntil(const uint16_t, QVector<Event>::const_iterator &, const QVector<Event>::const_iterator &);
+        void advanceTo(const uint16_t);
+        void substitutions(const MatchType::Location);
+        void applyEvent(const Event &);
+        void teamStatistics(const MatchType::Location);
+        void minutesPlayed(const MatchType::Location);
+        void kickingCompetition();
+        void endOfMatch();
+
+        void changeInMorale(Player * const, const bool);
+        void updateStatistics(const MatchType::Location, const StatsType::NumberOf, Player * const);
+        void recordEvent(const MatchEvent::Type, const MatchType::Location, Player * const = nullptr,
+                         const uint16_t = 0, const uint8_t = 0) const;
+
+        uint32_t poisson(const double);
+        bool chance(const double);
+
+        DateTime & _dateTime;
+        Match * _match;
+        Model _model;
+
+        RandomStream _random;
+        MatchPeriods _periods;
+
+        uint16_t _second;                      // regular time played (in seconds)
+        uint16_t _substitutionSecond[2];       // time of (all) substitutions of a team
+        bool _substituted[2];
+        Lineup _lineups[2][2];                 // [team][before/after substitutions]
+        QMap<Player *, QPair<uint16_t, uint16_t>> _timeOnPitch[2];  // [team] player -> (from, to) in seconds
+};
+
+#endif // QUICK_SIM_H
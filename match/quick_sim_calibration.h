@@ -0,0 +1,94 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef QUICK_SIM_CALIBRATION_H
+#define QUICK_SIM_CALIBRATION_H
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <cstdint>
+#include "match/match.h"
+#include "match/quick_sim.h"
+#include "settings/config.h"
+#include "shared/datetime.h"
+#include "team.h"
+
+// fits parameters of QuickSim::Model to what GamePlay actually produces: matches of given pairings of teams are played
+// (headless, by GamePlay) many times and the model is fitted from their scores and statistics; every run plays with
+// its own copies of both teams => session isn't affected and runs can be done in parallel
+// note: should be run again whenever match settings (probabilities of match activities) change
+class QuickSimCalibration {
+
+    public:
+        static constexpr uint16_t defaultNumberOfRunsPerPairing = 100;
+
+        // statistics of a team in one match (totals per match, rates are calculated from totals when model is fitted)
+        enum Stat: uint8_t {
+
+            TRIES, CONVERSIONS, PENALTY_GOALS, DROP_GOALS, YELLOW_CARDS, RED_CARDS,
+            PASSES, PASSES_COMPLETED, TACKLES, TACKLES_COMPLETED, CARRIES, METRES_RUN, METRES_KICKED, KICKS,
+            LINEOUTS, LINEOUTS_WON, SCRUMS, SCRUMS_WON, HANDLING_ERRORS, OFFLOADS, PENALTY_INFRINGEMENTS,
+            SUBSTITUTIONS, KICKER_SKILL, NO_OF_STATS
+        };
+        typedef std::array<double, Stat::NO_OF_STATS> Stats;
+
+        // outcome of a single run (one match)
+        struct Run {
+
+            uint16_t pairing;
+            bool played;      // false if squad of either team couldn't be selected
+            Stats stats[2];   // [hosts/visitors]
+        };
+
+        // sum of all runs
+        struct Summary {
+
+            Stats totals = {};
+            QVector<std::array<double, 2>> tries; // [pairing][hosts/visitors]
+            QVector<uint32_t> runs;               // [pairing]
+            uint32_t teamMatches = 0;
+        };
+
+        // single run for QtConcurrent::mappedReduced (functor must define result_type)
+        struct RunFunctor {
+
+            typedef Run result_type;
+
+            explicit RunFunctor(const QuickSimCalibration * const calibration): _calibration(calibration) {}
+            inline Run operator()(const uint32_t run) const { return _calibration->play(run); }
+
+            const QuickSimCalibration * _calibration;
+        };
+
+        QuickSimCalibration() = delete;
+        QuickSimCalibration(Settings * const, const DateTime &, const QVector<QPair<Team *, Team *>> &);
+        ~QuickSimCalibration() {}
+
+        // distinct pairings of regular part of season
+        static QVector<QPair<Team *, Team *>> pairings(const QVector<Match *> * const);
+
+        inline int numberOfPairings() const { return _pairings.size(); }
+
+        Run play(const uint32_t) const;
+        static void add(Summary &, const Run &);
+
+        QuickSim::Model fit(const Summary &) const;
+        static QString modelAsHtml(const QuickSim::Model &, const uint32_t);
+
+    private:
+        static constexpr uint32_t codeOffset = 0xCA000000; // codes of calibration matches (don't collide with fixtures)
+        static constexpr uint32_t selectionCodeOffset = 0xCB000000; // codes of streams used for selection of players
+
+        Stats stats(Match * const, const MatchType::Location) const;
+        int16_t rankingDiff(const int) const;
+
+        Settings * _settings;
+        DateTime _dateTime;
+        QVector<QPair<Team *, Team *>> _pairings;
+};
+
+#endif // QUICK_SIM_CALIBRATION_H
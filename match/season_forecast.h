@@ -0,0 +1,116 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef SEASON_FORECAST_H
+#define SEASON_FORECAST_H
+
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "match/match.h"
+#include "match/quick_sim.h"
+#include "team.h"
+
+// Monte Carlo forecast of final standings: remaining fixtures are played (by the statistical model of QuickSim, not by
+// GamePlay) repeatedly and outcomes of all runs are summed up; everything a single run needs is copied from current
+// session when the forecast is created (teams are copied by value, only standings of copies are changed by a run) => runs
+// don't touch any Team/Match object of the session and can be done in parallel; final tables and play-offs' draw
+// follow the same rules as the competition itself (sortTable, Playoffs::qualifiedTeam/advancingTeam)
+class SeasonForecast {
+
+    public:
+        static constexpr uint16_t defaultNumberOfRuns = 10000;
+
+        // outcome of a single run (season played till the end)
+        struct Run {
+
+            QVector<uint8_t> positions; // final position in group (index = team)
+            QVector<bool> playoffs;     // qualified for play-offs (index = team)
+            int16_t champion = -1;      // index of team which won the competition
+        };
+
+        // sum of all runs
+        struct Summary {
+
+            QVector<QVector<uint32_t>> positions; // [team][position in group]
+            QVector<uint32_t> playoffs;
+            QVector<uint32_t> titles;
+            uint32_t runs = 0;
+        };
+
+        // single run for QtConcurrent::mappedReduced (functor must define result_type)
+        struct RunFunctor {
+
+            typedef Run result_type;
+
+            explicit RunFunctor(const SeasonForecast * const forecast): _forecast(forecast) {}
+            inline Run operator()(const uint32_t run) const { return _forecast->play(run); }
+
+            const SeasonForecast * _forecast;
+        };
+
+        SeasonForecast() = delete;
+        SeasonForecast(const QVector<Team *> &, const QVector<Match *> * const, const uint64_t = 0,
+                       const QuickSim::Model & = QuickSim::Model());
+        ~SeasonForecast() {}
+
+        inline bool hasPlayoffs() const { return !_playoffs.isEmpty(); }
+
+        Run play(const uint32_t) const;
+        static void add(Summary &, const Run &);
+
+        QString summaryAsHtml(const Summary &, Team * const) const;
+
+    private:
+        struct Score {
+
+            uint8_t tries;
+            uint8_t conversions;
+            uint8_t penalties;
+            uint8_t dropGoals;
+
+            uint16_t points() const;
+        };
+
+        struct Fixture {
+
+            int16_t hosts;
+            int16_t visitors;
+        };
+
+        struct PlayoffsFixture {
+
+            uint32_t code;
+            MatchType::ToPlayOff type;
+            int16_t teams[2];                   // team assigned already (-1 = not assigned yet)
+            int16_t winner;                     // match played already (-1 = not played yet)
+            int16_t loser;
+            QPair<QString, uint8_t> ranking[2]; // FROM_REGULAR: group and position in group
+            QPair<uint32_t, bool> fromMatch[2]; // FROM_PLAYOFFS: code of previous match and winner/loser of it
+            bool isFinal;                       // winner of this match wins the competition
+        };
+
+        Score score(std::mt19937 &, const int16_t, const int16_t, const bool) const;
+        double expectedTries(const int16_t, const int16_t, const bool) const;
+        void playMatch(std::mt19937 &, std::vector<Team> &, const Fixture &) const;
+        bool hostsWin(std::mt19937 &, const int16_t, const int16_t) const;
+
+        QVector<Team *> _teams;
+        QVector<QString> _groups;        // index = team
+        QVector<uint8_t> _rankings;      // index = team
+        std::vector<Team> _standings;    // copies of teams with current standings (index = team; a copy is made for each run)
+        QVector<double> _attack;         // average number of tries scored so far (index = team)
+        QVector<double> _defence;        // average number of tries conceded so far (index = team)
+
+        QVector<Fixture> _fixtures;       // regular part of season (remaining matches only)
+        QVector<PlayoffsFixture> _playoffs;
+
+        uint64_t _seed;
+        QuickSim::Model _model;
+};
+
+#endif // SEASON_FORECAST_H
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QDateTime>
+#include <QStringBuilder>
+#include "match/match_branching.h"
+
+// fork is made here (in the main thread) => rollouts (played in other threads) don't touch the match in progress at all
+MatchBranching::MatchBranching(Settings * const settings, const DateTime & dateTime, Match * const match,
+                               Team * const myTeam, const GamePlay * const play, const QVector<Branch> & branches):
+    _settings(settings), _dateTime(dateTime), _match(match), _branches(branches), _snapshot(play->snapshot()),
+    _forkedAt(match->timePlayed().timePlayed()) {
+
+    this->_myTeam = (match->team(MatchType::Location::HOSTS) == myTeam)
+                  ? MatchType::Location::HOSTS : MatchType::Location::VISITORS;
+
+    for (uint8_t i = 0; i < 2; ++i)
+        this->_teams[i] = match->team(static_cast<MatchType::Location>(i))->clone();
+}
+
+MatchBranching::~MatchBranching() {
+
+    for (auto team: this->_teams) {
+
+        for (auto player: team->squad())
+            delete player;
+        delete team;
+    }
+}
+
+QString MatchBranching::description(const Branch & branch, const Team * const team) {
+
+    auto playerName = [&team](const uint32_t code) -> QString {
+
+        for (auto player: team->squad())
+            if (player->code() == code)
+                return player->fullName();
+        return QString();
+    };
+
+    const QString players = QStringLiteral(" (") % playerName(branch.playerIn) % QStringLiteral(" for ") %
+                            playerName(branch.playerOut) % QStringLiteral(")");
+
+    switch (branch.decision) {
+
+        case Decision::CONTINUE: return QStringLiteral("no change");
+        case Decision::SUBSTITUTE_NOW: return (QStringLiteral("substitution now") % players);
+        case Decision::SUBSTITUTE_LATER:
+            return (QStringLiteral("substitution in ") % QString::number(defaultSubstitutionDelay / 60) %
+                    QStringLiteral(" minutes") % players);
+        case Decision::PENALTY_KICK_AT_GOAL: return QStringLiteral("next penalty: kick at goal");
+        case Decision::PENALTY_KICK_TO_TOUCH: return QStringLiteral("next penalty: kick into touch");
+    }
+
+    return QString();
+}
+
+// rollouts are assigned to branches in turns: rollout / branches = number of continuation (the same in every branch)
+MatchBranching::Rollout MatchBranching::play(const uint32_t rollout) const {
+
+    Rollout result;
+    result.branch = static_cast<uint16_t>(rollout % _branches.size());
+    result.played = false;
+    result.result = TeamResults::ResultType::DRAW;
+
+    const Branch & branch = _branches.at(result.branch);
+    Team * const hosts = _teams[0]->clone();
+    Team * const visitors = _teams[1]->clone();
+
+    DateTime dateTime = _dateTime;
+    Match match(_match->code(), QDateTime(_match->date(), _match->time()), hosts, visitors, _match->type(), nullptr,
+                _match->venue(), false, false);
+
+    GamePlay play(_settings, dateTime, &match, match.team(_myTeam), nullptr);
+
+    // state of play at the moment of fork (incl. restart kick pending after a score or an offload in progress) is restored
+    // and kept by playUntil/playMatch (play is resumed in the middle of a period => nothing is reset, see GamePlay::resume)
+    if (play.restore(_snapshot)) {
+
+        // continuations with the same number share random numbers in all branches (common random numbers) => difference
+        // between branches is caused by the decision itself rather than by different luck
+        play.reseed((static_cast<uint64_t>(_match->code()) << 32) | (rollout / _branches.size()));
+
+        // decision is made only if match is still in progress and both players are still available; rollout in which
+        // substitution can't be made isn't counted (it would be the same as the baseline)
+        bool decisionMade = true;
+
+        switch (branch.decision) {
+
+            case Decision::SUBSTITUTE_LATER:
+                if (!(decisionMade = play.playUntil(match.timePlayedInSeconds() + defaultSubstitutionDelay)))
+                    break;
+                // fall through
+            case Decision::SUBSTITUTE_NOW:
+                decisionMade = play.substitute(match.playerByCode(_myTeam, branch.playerOut),
+                                               match.playerByCode(_myTeam, branch.playerIn), _myTeam);
+                break;
+            case Decision::PENALTY_KICK_AT_GOAL: play.decideNextPenalty(GamePlay::PenaltyAction::KICK_AT_GOAL); break;
+            case Decision::PENALTY_KICK_TO_TOUCH: play.decideNextPenalty(GamePlay::PenaltyAction::KICK_TO_TOUCH); break;
+            case Decision::CONTINUE: break;
+        }
+
+        if (decisionMade) {
+
+            play.playMatch();
+
+            result.played = true;
+            result.result = match.resultTypeForTeam(_myTeam);
+        }
+    }
+
+    for (auto team: { hosts, visitors }) {
+
+        for (auto player: team->squad())
+            delete player;
+        delete team;
+    }
+
+    return result;
+}
+
+void MatchBranching::add(Summary & summary, const Rollout & rollout) {
+
+    if (!rollout.played)
+        return;
+
+    if (summary.size() <= rollout.branch)
+        summary.resize(rollout.branch + 1);
+
+    switch (rollout.result) {
+
+        case TeamResults::ResultType::WIN: ++summary[rollout.branch][0]; break;
+        case TeamResults::ResultType::DRAW: ++summary[rollout.branch][1]; break;
+        default: ++summary[rollout.branch][2];
+    }
+
+    return;
+}
+
+// draw counts as half a win
+double MatchBranching::winProbability(const Summary & summary, const int branch) {
+
+    if (branch >= summary.size())
+        return 0.0;
+
+    const uint32_t rollouts = summary.at(branch)[0] + summary.at(branch)[1] + summary.at(branch)[2];
+    return ((rollouts == 0) ? 0.0 : (summary.at(branch)[0] + 0.5 * summary.at(branch)[1]) / rollouts);
+}
+
+// first branch is the baseline => differences are relative to it
+QString MatchBranching::summaryAsHtml(const Summary & summary) const {
+
+    if (summary.isEmpty())
+        return QString();
+
+    const double baseline = MatchBranching::winProbability(summary, 0);
+    const Team * const team = this->_teams[static_cast<uint8_t>(this->_myTeam)];
+
+    QString html = QStringLiteral("<p>Win probability of ") % team->name() % QStringLiteral(" at ") %
+                   this->_forkedAt % QStringLiteral(":</p><table cellspacing=\"0\" cellpadding=\"3\">") %
+                   QStringLiteral("<tr><th align=\"left\">Decision</th><th>Matches</th><th>W</th><th>D</th><th>L</th>") %
+                   QStringLiteral("<th>Win %</th><th>Change</th></tr>");
+
+    for (int i = 0; i < this->_branches.size() && i < summary.size(); ++i) {
+
+        const std::array<uint32_t, 3> & results = summary.at(i);
+        const double probability = MatchBranching::winProbability(summary, i);
+        const QString change = (i == 0) ? QStringLiteral("-")
+                             : QString(((probability >= baseline) ? QStringLiteral("+") : QString()) %
+                                       QString::number(100.0 * (probability - baseline), 'f', 1));
+
+        html += QStringLiteral("<tr><td>") % MatchBranching::description(this->_branches.at(i), team) %
+                QStringLiteral("</td><td align=\"right\">") % QString::number(results[0] + results[1] + results[2]) %
+                QStringLiteral("</td><td align=\"right\">") % QString::number(results[0]) %
+                QStringLiteral("</td><td align=\"right\">") % QString::number(results[1]) %
+                QStringLiteral("</td><td align=\"right\">") % QString::number(results[2]) %
+                QStringLiteral("</td><td align=\"right\">") % QString::number(100.0 * probability, 'f', 1) %
+                QStringLiteral("</td><td align=\"right\">") % change % QStringLiteral("</td></tr>");
+    }
+
+    return (html + QStringLiteral("</table>"));
+}
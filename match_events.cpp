@@ -0,0 +1,388 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QDataStream>
+#include <QFile>
+#include <QStringBuilder>
+#include <algorithm>
+#include <array>
+#include "match/match.h"
+#include "match/match_events.h"
+#include "shared/texts.h"
+
+const QString MatchEventLog::archiveFileName = QStringLiteral("match_events.dat");
+
+namespace {
+
+    // statistics which PlayerStats stores as such (i.e. which can be incremented, see PlayerStats::setStatsValue)
+    const std::array<StatsType::NumberOf, 18> storedPlayerStats = {
+
+        StatsType::NumberOf::GAMES_PLAYED, StatsType::NumberOf::GAMES_PLAYED_SUB, StatsType::NumberOf::MINS_PLAYED,
+        StatsType::NumberOf::TACKLES_MADE, StatsType::NumberOf::TACKLES_COMPLETED, StatsType::NumberOf::TACKLES_RECEIVED,
+        StatsType::NumberOf::METRES_RUN, StatsType::NumberOf::METRES_KICKED, StatsType::NumberOf::CARRIES,
+        StatsType::NumberOf::PASSES_MADE, StatsType::NumberOf::PASSES_COMPLETED, StatsType::NumberOf::OFFLOADS,
+        StatsType::NumberOf::HANDLING_ERRORS, StatsType::NumberOf::YELLOW_CARDS, StatsType::NumberOf::RED_CARDS,
+        StatsType::NumberOf::PENALTIES_CAUSED, StatsType::NumberOf::HIGH_TACKLES, StatsType::NumberOf::DANGEROUS_TACKLES
+    };
+}
+
+QByteArray MatchEventLog::serialize() const {
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream << MatchEventLog::formatVersion;
+    this->writeTo(stream);
+
+    // records are very similar to each other => compression ratio is high
+    return qCompress(data);
+}
+
+// return value: false if data is corrupted or in unknown format (log is left empty)
+bool MatchEventLog::deserialize(const QByteArray & compressedData) {
+
+    this->_records.clear();
+
+    const QByteArray data = qUncompress(compressedData);
+    QDataStream stream(data);
+
+    quint32 version = 0;
+    stream >> version;
+    if (stream.status() != QDataStream::Ok || version != MatchEventLog::formatVersion)
+        return false;
+
+    return this->readFrom(stream);
+}
+
+void MatchEventLog::writeTo(QDataStream & stream) const {
+
+    stream << static_cast<quint32>(this->_records.size());
+
+    for (const auto & record: this->_records)
+        stream << record.second << static_cast<quint8>(record.type) << record.team << record.player
+               << record.value << record.outcome;
+
+    return;
+}
+
+// team and type of event (and statistics of player) are used as indices when log is replayed => they must be in range
+bool MatchEventLog::isValid(const MatchEvent::Record & record) {
+
+    if (record.team > 1 || static_cast<uint8_t>(record.type) >= MatchEvent::numberOfTypes)
+        return false;
+
+    if (record.type == MatchEvent::Type::PLAYER_STATS)
+        return (std::find(storedPlayerStats.cbegin(), storedPlayerStats.cend(),
+                          static_cast<StatsType::NumberOf>(record.outcome)) != storedPlayerStats.cend());
+
+    return true;
+}
+
+// return value: false if data is corrupted (log is left empty); number of records is checked against data actually
+// available before any memory is allocated (truncated or corrupted data can't cause a huge allocation)
+// and every record is checked before it's accepted (see isValid)
+bool MatchEventLog::readFrom(QDataStream & stream) {
+
+    this->_records.clear();
+
+    quint32 noOfRecords = 0;
+    stream >> noOfRecords;
+    if (stream.status() != QDataStream::Ok || noOfRecords > MatchEventLog::maxNumberOfRecords)
+        return false;
+
+    const QIODevice * const device = stream.device();
+    if (device != nullptr && !device->isSequential() &&
+        static_cast<qint64>(noOfRecords) * MatchEventLog::storedRecordSize > device->size() - device->pos())
+        return false;
+
+    this->_records.reserve(noOfRecords);
+    for (quint32 i = 0; i < noOfRecords; ++i) {
+
+        MatchEvent::Record record;
+        quint8 type;
+
+        stream >> record.second >> type >> record.team >> record.player >> record.value >> record.outcome;
+        record.type = static_cast<MatchEvent::Type>(type);
+
+        if (stream.status() != QDataStream::Ok || !MatchEventLog::isValid(record))
+            break;
+
+        this->_records.append(record);
+    }
+
+    if (stream.status() != QDataStream::Ok || static_cast<quint32>(this->_records.size()) != noOfRecords) {
+
+        this->_records.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool MatchEventLog::appendToArchive(const QString & fileName, const uint32_t code) const {
+
+    QFile archive(fileName);
+    if (!archive.open(QIODevice::WriteOnly | QIODevice::Append))
+        return false;
+
+    QDataStream stream(&archive);
+    stream << code << this->serialize();
+
+    return (stream.status() == QDataStream::Ok);
+}
+
+// if a match has been stored more than once, the most recent log is loaded
+bool MatchEventLog::loadFromArchive(const QString & fileName, const uint32_t code) {
+
+    QFile archive(fileName);
+    if (!archive.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&archive);
+    QByteArray matchLog;
+
+    while (!stream.atEnd()) {
+
+        quint32 matchCode;
+        QByteArray data;
+
+        stream >> matchCode >> data;
+        if (stream.status() != QDataStream::Ok)
+            break;
+
+        if (matchCode == code)
+            matchLog = data;
+    }
+
+    return (!matchLog.isEmpty() && this->deserialize(matchLog));
+}
+
+MatchReplay::MatchReplay(Match * const match, const MatchEventLog & log): _match(match), _log(log) {}
+
+MatchReplay::~MatchReplay() {
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        for (auto it: this->_playerStats[i].values())
+            delete it;
+
+        for (auto it: this->_playerPoints[i].values())
+            delete it;
+    }
+}
+
+PlayerStats * MatchReplay::stats(const uint8_t team, const uint32_t code) {
+
+    if (!this->_playerStats[team].contains(code))
+        this->_playerStats[team].insert(code, new PlayerStats());
+
+    return this->_playerStats[team][code];
+}
+
+PlayerPoints * MatchReplay::points(const uint8_t team, const uint32_t code) {
+
+    if (!this->_playerPoints[team].contains(code))
+        this->_playerPoints[team].insert(code, new PlayerPoints());
+
+    return this->_playerPoints[team][code];
+}
+
+Player * MatchReplay::player(const uint8_t team, const uint32_t code) const {
+
+    const Team * const teamOfPlayer = this->_match->team(static_cast<MatchType::Location>(team));
+    if (teamOfPlayer == nullptr)
+        return nullptr;
+
+    for (auto player: teamOfPlayer->squad())
+        if (player->code() == code)
+            return player;
+
+    return nullptr;
+}
+
+// the same functions as in GamePlay are called (in the same order) => rebuilt values are equal to original ones
+void MatchReplay::apply(const MatchEvent::Record & record) {
+
+    MatchScore & score = this->_score[record.team];
+
+    switch (record.type) {
+
+        case MatchEvent::Type::TRY:
+            score.tryScored(); this->points(record.team, record.player)->tryScored(); break;
+        case MatchEvent::Type::CONVERSION:
+            score.conversionScored(); this->points(record.team, record.player)->conversionScored(); break;
+        case MatchEvent::Type::PENALTY_GOAL:
+            score.penaltiesScored(); this->points(record.team, record.player)->penaltyScored(); break;
+        case MatchEvent::Type::DROP_GOAL:
+            score.dropScored(); this->points(record.team, record.player)->dropGoalScored(); break;
+        case MatchEvent::Type::SHOOT_OUT: score.shootOutGoalsScored(record.value); break;
+
+        case MatchEvent::Type::PASS: score.passAttempted(static_cast<MatchScore::Passes>(record.outcome)); break;
+        case MatchEvent::Type::TACKLE: score.tackleAttempted(static_cast<MatchScore::Tackles>(record.outcome)); break;
+        case MatchEvent::Type::LINEOUT: score.lineoutThrown(static_cast<MatchScore::Lineouts>(record.outcome)); break;
+        case MatchEvent::Type::SCRUM: score.scrumThrown(static_cast<MatchScore::Scrums>(record.outcome)); break;
+
+        case MatchEvent::Type::RUN: score.run(record.value); break;
+        case MatchEvent::Type::KICK: score.kick(record.value); break;
+        case MatchEvent::Type::CARRY: score.carries(); break;
+
+        case MatchEvent::Type::PENALTY_INFRINGEMENT: score.penaltyInfringements(); break;
+        case MatchEvent::Type::HANDLING_ERROR: score.handlingErrors(); break;
+        case MatchEvent::Type::OFFLOAD: score.offloads(); break;
+        case MatchEvent::Type::YELLOW_CARD: score.yellowCards(); break;
+        case MatchEvent::Type::RED_CARD: score.redCards(); break;
+
+        case MatchEvent::Type::PLAYER_STATS:
+            this->stats(record.team, record.player)->incrementStatsValue(static_cast<StatsType::NumberOf>(record.outcome)); break;
+        case MatchEvent::Type::MINUTES_PLAYED:
+            this->stats(record.team, record.player)->addMinutesPlayed(record.value); break;
+        case MatchEvent::Type::POSSESSION: score.possession(record.value); break;
+        case MatchEvent::Type::TERRITORY: score.territory(record.value); break;
+    }
+
+    return;
+}
+
+void MatchReplay::rebuild() {
+
+    for (const auto & record: this->_log.records())
+        this->apply(record);
+
+    return;
+}
+
+// only events worth mentioning in match log (points and cards) are described, empty string is returned for the rest
+QString MatchReplay::eventForLog(const MatchEvent::Record & record) const {
+
+    QString event;
+
+    switch (record.type) {
+
+        case MatchEvent::Type::TRY: event = QStringLiteral("try"); break;
+        case MatchEvent::Type::CONVERSION: event = QStringLiteral("conversion"); break;
+        case MatchEvent::Type::PENALTY_GOAL: event = QStringLiteral("penalty goal"); break;
+        case MatchEvent::Type::DROP_GOAL: event = QStringLiteral("drop goal"); break;
+        case MatchEvent::Type::YELLOW_CARD: event = QStringLiteral("yellow card"); break;
+        case MatchEvent::Type::RED_CARD: event = QStringLiteral("red card"); break;
+        default: return QString();
+    }
+
+    const Player * const player = this->player(record.team, record.player);
+    const QString playerName = (player != nullptr) ? player->fullName() : MatchScore::unknownValue;
+
+    return (QString::number(record.second / 60 + 1) % QStringLiteral("' ") % event % QStringLiteral(": ") % playerName %
+            string_functions.wrapInBrackets(this->_match->team(static_cast<MatchType::Location>(record.team))->name()));
+}
+
+void MatchReplay::updateStatisticsUI(GamePlayObserver * const observer, const MatchType::Location team) const {
+
+    const MatchScore & score = this->_score[team];
+    const MatchScore & opponentScore = this->_score[(team == MatchType::Location::HOSTS) ? 1 : 0];
+    const uint16_t timePlayed = std::max<uint16_t>(this->_match->timePlayed().timePlayedInSecondsRaw(), 1);
+
+    const QList<QPair<QString, QString>> labels = {
+
+        { QStringLiteral("PointsLabel"), QString::number(score.points()) },
+        { QStringLiteral("TriesLabel"), QString::number(score.points(PointEvent::TRY)) },
+        { QStringLiteral("ConversionsLabel"), QString::number(score.points(PointEvent::CONVERSION)) },
+        { QStringLiteral("PenaltiesLabel"), QString::number(score.points(PointEvent::PENALTY)) },
+        { QStringLiteral("DropGoalsLabel"), QString::number(score.points(PointEvent::DROPGOAL)) },
+        { QStringLiteral("PossessionLabel"), string_functions.formatNumber<double>(score.possession() * 100.0 / timePlayed) },
+        { QStringLiteral("TerritoryLabel"), string_functions.formatNumber<double>(score.territory() * 100.0 / timePlayed) },
+        { QStringLiteral("MetresMadeByRunningLabel"), QString::number(score.stats<uint16_t>(StatsType::NumberOf::METRES_RUN)) },
+        { QStringLiteral("MetresMadeByKickingLabel"), QString::number(score.stats<uint16_t>(StatsType::NumberOf::METRES_KICKED)) },
+        { QStringLiteral("CarriesLabel"), QString::number(score.stats<uint16_t>(StatsType::NumberOf::CARRIES)) },
+        { QStringLiteral("PassesMadeLabel"), QString::number(score.passes(MatchScore::Passes::ATTEMPTED)) },
+        { QStringLiteral("PassesCompletedLabel"), QString::number(score.passes(MatchScore::Passes::COMPLETED)) },
+        { QStringLiteral("PassesMissedLabel"), QString::number(score.passes(MatchScore::Passes::MISSED)) },
+        { QStringLiteral("PassesSuccessRateLabel"), score.passesSuccessRate() },
+        { QStringLiteral("OffloadsLabel"), QString::number(score.stats<uint8_t>(StatsType::NumberOf::OFFLOADS)) },
+        { QStringLiteral("HandlingErrorsLabel"), QString::number(score.stats<uint8_t>(StatsType::NumberOf::HANDLING_ERRORS)) },
+        { QStringLiteral("TacklesMadeLabel"), QString::number(score.tackles(MatchScore::Tackles::ATTEMPTED)) },
+        { QStringLiteral("TacklesCompletedLabel"), QString::number(score.tackles(MatchScore::Tackles::COMPLETED)) },
+        { QStringLiteral("TacklesMissedLabel"), QString::number(score.tackles(MatchScore::Tackles::MISSED)) },
+        { QStringLiteral("TacklesSuccessRateLabel"), score.tacklesSuccessRate() },
+        { QStringLiteral("LineoutsThrownLabel"), QString::number(score.lineouts(MatchScore::Lineouts::THROWN)) },
+        { QStringLiteral("LineoutsWonLabel"), QString::number(score.lineouts(MatchScore::Lineouts::WON)) },
+        { QStringLiteral("LineoutsStolenLabel"), QString::number(opponentScore.lineouts(MatchScore::Lineouts::LOST)) },
+        { QStringLiteral("LineoutsSuccessRateLabel"), score.lineoutsSuccessRate() },
+        { QStringLiteral("ScrumsWonLabel"), QString::number(score.scrums(MatchScore::Scrums::WON)) },
+        { QStringLiteral("ScrumsLostLabel"), QString::number(score.scrums(MatchScore::Scrums::LOST)) },
+        { QStringLiteral("PenaltyInfringementsLabel"),
+          QString::number(score.stats<uint8_t>(StatsType::NumberOf::PENALTIES_CAUSED)) },
+        { QStringLiteral("YellowCardsLabel"), QString::number(score.stats<uint8_t>(StatsType::NumberOf::YELLOW_CARDS)) },
+        { QStringLiteral("RedCardsLabel"), QString::number(score.stats<uint8_t>(StatsType::NumberOf::RED_CARDS)) }
+    };
+
+    for (const auto & label: labels)
+        observer->updateStatisticsUI(team, label.first, label.second, false);
+
+    return;
+}
+
+// the same format as in GamePlay::refreshPointsList
+void MatchReplay::displayPoints(GamePlayObserver * const observer, const MatchType::Location team) const {
+
+    const QList<QPair<PointEvent, StatsType::NumberOf>> events = {
+
+        { PointEvent::TRY, StatsType::NumberOf::TRIES }, { PointEvent::CONVERSION, StatsType::NumberOf::CONVERSIONS },
+        { PointEvent::PENALTY, StatsType::NumberOf::PENALTIES }, { PointEvent::DROPGOAL, StatsType::NumberOf::DROPGOALS }
+    };
+
+    QMap<PointEvent, QStringList> pointsAndPlayers;
+
+    for (auto it = this->_playerPoints[team].cbegin(); it != this->_playerPoints[team].cend(); ++it) {
+
+        const Player * const player = this->player(team, it.key());
+        if (player == nullptr)
+            continue;
+
+        for (const auto & event: events) {
+
+            const uint16_t count = it.value()->getPointsValue(event.second);
+            if (count == 0)
+                continue;
+
+            const QString number = (!(count > 1)) ? QString() : string_functions.wrapInBrackets(QString::number(count));
+            pointsAndPlayers[event.first].append(player->abridgedFullName() + number);
+        }
+    }
+
+    observer->displayPoints(pointsAndPlayers, team);
+    return;
+}
+
+void MatchReplay::replay(GamePlayObserver * const observer) {
+
+    for (const auto & record: this->_log.records()) {
+
+        this->apply(record);
+
+        const QString logMessage = this->eventForLog(record);
+        if (observer != nullptr && !logMessage.isEmpty())
+            observer->logRecord(logMessage);
+    }
+
+    if (observer != nullptr)
+        this->display(observer);
+
+    return;
+}
+
+// displays rebuilt score and statistics (state after the last event) at once
+void MatchReplay::display(GamePlayObserver * const observer) const {
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location team = static_cast<MatchType::Location>(i);
+
+        this->updateStatisticsUI(observer, team);
+        this->displayPoints(observer, team);
+        observer->updateScore(team);
+    }
+
+    observer->logRecord(observer->currentScore());
+    return;
+}
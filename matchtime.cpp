@@ -3,6 +3,7 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <QDataStream>
 #include "match/matchtime.h"
 #include "shared/constants.h"
 #include "shared/html.h"
@@ -31,7 +32,8 @@ void MatchTime::switchTimePeriodTo(const MatchPeriod::TimePeriod nextPeriod) {
     _currentTimePeriod = (nextPeriod != MatchPeriod::TimePeriod::UNDETERMINED) ? nextPeriod
                        : static_cast<MatchPeriod::TimePeriod>(static_cast<int8_t>(_currentTimePeriod)+1);
 
-    // add new period to list of played periods
+    // add new period to list of played periods (time of a period which is entered again is discarded)
+    _timePlayedInSecondsRaw -= _timePeriodLengths.value(_currentTimePeriod, 0);
     _timePeriodLengths.insert(_currentTimePeriod, 0);
 
     return;
@@ -48,14 +50,11 @@ MatchPeriod::TimePeriod MatchTime::lastPeriodPlayed() const {
     return *(--(--_timePeriodLengths.keyEnd()));
 }
 
-// needed for calculation of possession time ratio and territory time ratio
+// needed for calculation of possession time ratio and territory time ratio (i.e. after every game action)
+// note: sum of lengths of all periods is kept up to date whenever time is added => there's no need to iterate over periods
 uint16_t MatchTime::timePlayedInSecondsRaw() const {
 
-    uint16_t timeInSeconds = 0;
-    for (auto period: _timePeriodLengths.values())
-        timeInSeconds += period;
-
-    return timeInSeconds;
+    return _timePlayedInSecondsRaw;
 }
 
 uint16_t MatchTime::timePlayedInSecondsInPeriod() const {
@@ -114,6 +113,7 @@ void MatchTime::addTime(const uint16_t seconds) {
     if (_timePeriodLengths.contains(_currentTimePeriod))
         _timePeriodLengths[_currentTimePeriod] += seconds;
     else _timePeriodLengths.insert(_currentTimePeriod, seconds);
+    _timePlayedInSecondsRaw += seconds;
 
     return;
 }
@@ -127,8 +127,10 @@ void MatchTime::setTimeForInterval(const uint16_t seconds) {
             this->lastPeriodPlayed() : static_cast<MatchPeriod::TimePeriod>(static_cast<int8_t>(_currentTimePeriod)-1);
         _timePeriodLengths[previousPeriod] += _timePeriodLengths[_currentTimePeriod];
     }
+    else _timePlayedInSecondsRaw -= _timePeriodLengths.value(_currentTimePeriod, 0);
 
     _timePeriodLengths[_currentTimePeriod] = seconds;
+    _timePlayedInSecondsRaw += seconds;
 
     return;
 }
@@ -152,3 +154,47 @@ void MatchTime::addSeconds(const uint8_t seconds) {
 
     return;
 }
+
+void MatchTime::writeTo(QDataStream & stream) const {
+
+    stream << static_cast<qint8>(_currentTimePeriod) << static_cast<quint8>(_timePeriodLengths.size());
+    for (auto it = _timePeriodLengths.cbegin(); it != _timePeriodLengths.cend(); ++it)
+        stream << static_cast<qint8>(it.key()) << static_cast<quint16>(it.value());
+
+    stream << static_cast<quint16>(_timePlayedInSecondsRaw) << static_cast<quint16>(_minutesPlayed)
+           << static_cast<quint8>(_secondsPlayed) << static_cast<quint16>(_lastIncrement);
+
+    return;
+}
+
+bool MatchTime::readFrom(QDataStream & stream) {
+
+    qint8 currentTimePeriod = 0;
+    quint8 noOfPeriods = 0;
+    stream >> currentTimePeriod >> noOfPeriods;
+
+    QMap<MatchPeriod::TimePeriod, uint16_t> timePeriodLengths;
+    for (uint8_t i = 0; i < noOfPeriods; ++i) {
+
+        qint8 period = 0;
+        quint16 length = 0;
+        stream >> period >> length;
+        timePeriodLengths.insert(static_cast<MatchPeriod::TimePeriod>(period), length);
+    }
+
+    quint16 timePlayedInSecondsRaw = 0, minutesPlayed = 0, lastIncrement = 0;
+    quint8 secondsPlayed = 0;
+    stream >> timePlayedInSecondsRaw >> minutesPlayed >> secondsPlayed >> lastIncrement;
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    _currentTimePeriod = static_cast<MatchPeriod::TimePeriod>(currentTimePeriod);
+    _timePeriodLengths = timePeriodLengths;
+    _timePlayedInSecondsRaw = timePlayedInSecondsRaw;
+    _minutesPlayed = minutesPlayed;
+    _secondsPlayed = secondsPlayed;
+    _lastIncrement = lastIncrement;
+
+    return true;
+}
@@ -3,19 +3,29 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <QFile>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QShortcut>
+#include <QtConcurrent>
+#include <numeric>
 #include "matchwidget.h"
 #include "match/match.h"
+#include "match/match_events.h"
 #include "shared/constants.h"
+#include "shared/handle.h"
 #include "shared/html.h"
 #include "shared/messages.h"
 #include "shared/texts.h"
+#include "ui/custom/ui_inputdialog.h"
 #include "ui/custom/ui_messagebox.h"
 
 MatchWidget::MatchWidget(QWidget * parent, Match * match, Match * nextMatch, MatchType::Type * competitionPeriod,
                          Team * const myTeam, Settings * const settings, DateTime & systemDateAndTime):
     QWidget(parent), ui(new Ui_MatchWidget), _settings(settings), _dateTime(systemDateAndTime),
     _match(match), _nextMatch(nextMatch), _competitionPeriod(competitionPeriod), _myTeam(myTeam),
-    _resumePlay(ResumePlay::NO_ACTION), _play(nullptr) {
+    _resumePlay(ResumePlay::NO_ACTION), _play(nullptr), _refresh(new RefreshCoordinator(this)), _branching(nullptr),
+    _branchingWatcher(new BranchingWatcher(this)) {
 
     this->setObjectName(on::widgets["match"]);
 
@@ -26,11 +36,29 @@ MatchWidget::MatchWidget(QWidget * parent, Match * match, Match * nextMatch, Mat
     connect(ui->timePlayedLabel, &DiagnosticLabel::leftClicked, this, &MatchWidget::playMatch);
     connect(ui->timePlayedLabel, &DiagnosticLabel::rightClicked, this, &MatchWidget::playMatchInDiagnosticMode);
 
+    QShortcut * const finishMatchShortCut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+End")), this);
+    connect(finishMatchShortCut, &QShortcut::activated, this, &MatchWidget::finishMatch);
+
+    QShortcut * const whatIfShortCut = new QShortcut(QKeySequence(QStringLiteral("Ctrl+W")), this);
+    connect(whatIfShortCut, &QShortcut::activated, this, &MatchWidget::whatIfAnalysis);
+    connect(this->_branchingWatcher, &BranchingWatcher::finished, this, &MatchWidget::whatIfAnalysisFinished);
+
+    connect(this, SIGNAL(timeChanged()), Handle::getMainWindowHandle(), SLOT(updateDateAndTimeLabel()));
+
     html_functions.dummyCallToSuppressCompilerWarning();
 }
 
 MatchWidget::~MatchWidget() {
 
+    // rollouts still being played use settings and copies of teams owned by branching => they must end first
+    if (this->_branchingWatcher->isRunning()) {
+
+        disconnect(this->_branchingWatcher, &BranchingWatcher::finished, this, &MatchWidget::whatIfAnalysisFinished);
+        this->_branchingWatcher->cancel();
+        this->_branchingWatcher->waitForFinished();
+    }
+    delete this->_branching;
+
     // if next match's start time is less (earlier) than current time, time is rewound back
     if (_nextMatch != nullptr && // current match was not the last
         _nextMatch->date() == _dateTime.systemDate() && _nextMatch->time() < _dateTime.systemTime())
@@ -60,6 +88,9 @@ QLabel * MatchWidget::findWidgetByObjectName(const QString & objectName, const M
 
 void MatchWidget::timeStoppedMessageBox(const QString & key, const QStringList & insertedTexts) {
 
+    // current state of the match must be displayed before time is stopped
+    this->_refresh->flush();
+
     this->_resumePlay = ResumePlay::NO_ACTION;
     QString * clickedButtonObjectName = new QString();
     const QString timePlayed = _match->timePlayed().timePlayed();
@@ -76,16 +107,69 @@ void MatchWidget::timeStoppedMessageBox(const QString & key, const QStringList &
     return;
 }
 
+void MatchWidget::notify(const Notification type, const QString & title, const QString & text) const {
+
+    this->_refresh->flush();
+
+    switch (type) {
+
+        case Notification::WARNING: QMessageBox::warning(nullptr, title, text); break;
+        case Notification::CRITICAL: QMessageBox::critical(nullptr, title, text); break;
+        case Notification::INFORMATION: // fall through
+        default: QMessageBox::information(nullptr, title, text);
+    }
+    return;
+}
+
+// return value: false if diagnostic mode should be switched off
+bool MatchWidget::diagnosticData(const QString & diagnosticData) const {
+
+    this->_refresh->flush();
+
+    const QMessageBox::StandardButton result =
+        QMessageBox::warning(nullptr, QStringLiteral("Diagnostic data"), diagnosticData, QMessageBox::Ok | QMessageBox::Cancel);
+
+    return (result != QMessageBox::Cancel);
+}
+
+// note: changes of widgets updated after every game action are applied by RefreshCoordinator (at most 30 times per second)
+void MatchWidget::timeRefreshed(const QString & timePlayed, const uint16_t secondsPlayed, const bool) {
+
+    QLabel * const label = ui->timePlayedLabel;
+    QProgressBar * const progress = ui->matchProgressProgressBar;
+
+    this->_refresh->schedule(label, [label, timePlayed]() { label->setText(timePlayed); });
+    this->_refresh->schedule(progress, [progress, secondsPlayed]() { progress->setValue(secondsPlayed); });
+
+    return;
+}
+
+void MatchWidget::resetMatchProgress(const MatchPeriods * const periods, const MatchPeriod::TimePeriod period, const bool) {
+
+    QProgressBar * const progress = ui->matchProgressProgressBar;
+    if (progress->maximum() != periods->maximumValue(period)) {
+
+        // reset progress bar (pending change of value belongs to previous period)
+        this->_refresh->schedule(progress, [progress]() { progress->setValue(0); });
+        progress->setMaximum(periods->maximumValue(period));
+    }
+
+    return;
+}
+
+void MatchWidget::updatePeriod(const QString & periodDescription) {
+
+    ui->updatePeriod(periodDescription);
+    return;
+}
+
 void MatchWidget::updateStatisticsUI(const MatchType::Location team, const QString & statsLabel,
-                                     const QString & newValue, const bool immediateRepaint) const {
+                                     const QString & newValue, const bool) const {
 
     const QString prefix = (team == MatchType::Location::HOSTS) ? on::shared.hostsPrefix : on::shared.visitorsPrefix;
 
     QLabel * const updateLabel = this->findWidgetByObjectName(this->labelName(prefix, statsLabel), team);
-    updateLabel->setText(newValue);
-
-    if (immediateRepaint)
-        updateLabel->repaint();
+    this->_refresh->schedule(updateLabel, [updateLabel, newValue]() { updateLabel->setText(newValue); });
 
     return;
 }
@@ -150,7 +234,16 @@ void MatchWidget::displayPoints(const QMap<PointEvent, QStringList> & players, c
         }
     }
 
-    window->repaint();
+    return;
+}
+
+void MatchWidget::bonusPointGained(const MatchType::Location team) const {
+
+    const QString prefix = (team == MatchType::Location::HOSTS) ? on::shared.hostsPrefix : on::shared.visitorsPrefix;
+    const QString labelName = prefix + QStringLiteral("BonusPointLabel");
+    QLabel * const bonusPointLabel = this->findChild<QLabel *>(labelName, Qt::FindDirectChildrenOnly);
+
+    bonusPointLabel->setStyleSheet(ss::shared.style(ss::matchwidget.BonusPointStyleEnabled));
 
     return;
 }
@@ -181,9 +274,8 @@ void MatchWidget::logRecord(const QString & text) const {
     if (this->_settings->logging() == LogLevel::NONE)
         return;
 
-    const QString newLogRow = this->_match->timePlayed().timePlayed() + QStringLiteral(" ") + text;
-    ui->logWindowTextEdit->append(newLogRow);
-    ui->logWindowTextEdit->repaint();
+    const QString newLogRow = this->_match->timePlayed().timePlayed() % QChar(' ') % text;
+    this->_refresh->append(ui->logWindowTextEdit, newLogRow);
 
     return;
 }
@@ -223,24 +315,133 @@ void MatchWidget::updatePackWeight() const {
 
 void MatchWidget::updatePlayer(const QString & playerInPossession, const MatchType::Location loc) const {
 
-    if (loc == MatchType::Location::HOSTS) {
+    QLabel * const hostsLabel = this->ui->hostsPlayerInPossessionLabel;
+    QLabel * const visitorsLabel = this->ui->visitorsPlayerInPossessionLabel;
 
-        this->ui->hostsPlayerInPossessionLabel->setText(playerInPossession);
-        this->ui->visitorsPlayerInPossessionLabel->clear();
-    };
+    const QString hostsText = (loc == MatchType::Location::HOSTS) ? playerInPossession : QString();
+    const QString visitorsText = (loc == MatchType::Location::VISITORS) ? playerInPossession : QString();
+
+    this->_refresh->schedule(hostsLabel, [hostsLabel, hostsText]() { hostsLabel->setText(hostsText); });
+    this->_refresh->schedule(visitorsLabel, [visitorsLabel, visitorsText]() { visitorsLabel->setText(visitorsText); });
+
+    return;
+}
 
-    if (loc == MatchType::Location::VISITORS) {
+// tag team in possession of the ball (with icon)
+void MatchWidget::possessionChanged(const MatchType::Location loc) const {
 
-        this->ui->visitorsPlayerInPossessionLabel->setText(playerInPossession);
-        this->ui->hostsPlayerInPossessionLabel->clear();
+    ui->hostsInPossessionLabel->setEnabled(loc == MatchType::Location::HOSTS);
+    ui->visitorsInPossessionLabel->setEnabled(loc == MatchType::Location::VISITORS);
+
+    return;
+}
+
+// noOfPhases == 0 => phases are reset (labels are hidden)
+void MatchWidget::phasesChanged(const MatchType::Location loc, const uint8_t noOfPhases) const {
+
+    if (noOfPhases == 0) {
+
+        for (auto label: { ui->hostsNoOfPhasesLabel, ui->visitorsNoOfPhasesLabel })
+            this->_refresh->schedule(label, [label]() { label->setVisible(false); });
+        return;
     }
 
-    this->ui->hostsPlayerInPossessionLabel->repaint();
-    this->ui->visitorsPlayerInPossessionLabel->repaint();
+    QLabel * const label = (loc == MatchType::Location::HOSTS) ? ui->hostsNoOfPhasesLabel : ui->visitorsNoOfPhasesLabel;
+    const QString text = QStringLiteral("Phase: ") + QString::number(noOfPhases);
+
+    this->_refresh->schedule(label, [label, text]() { label->setText(text); label->setVisible(true); });
 
     return;
 }
 
+void MatchWidget::ballPositionChanged(const int8_t distanceFromHalfwayLine) const {
+
+    QProgressBar * const hostsProgress = ui->ballPositionHostsProgressBar;
+    QProgressBar * const visitorsProgress = ui->ballPositionVisitorsProgressBar;
+
+    // ball is always displayed in one half of the pitch only (the other progress bar is empty)
+    const uint8_t hostsValue = (distanceFromHalfwayLine < 0) ? 0 :
+        std::min<uint8_t>(static_cast<uint8_t>(distanceFromHalfwayLine), groundDimensions.fromGoalLineToHalfwayLine);
+    const uint8_t visitorsValue = (distanceFromHalfwayLine > 0) ? 0 :
+        std::min<uint8_t>(static_cast<uint8_t>(std::abs(distanceFromHalfwayLine)), groundDimensions.fromGoalLineToHalfwayLine);
+
+    this->_refresh->schedule(hostsProgress, [hostsProgress, hostsValue]() { hostsProgress->setValue(hostsValue); });
+    this->_refresh->schedule(visitorsProgress, [visitorsProgress, visitorsValue]() { visitorsProgress->setValue(visitorsValue); });
+
+    return;
+}
+
+bool MatchWidget::sideOverBall() const {
+
+    this->_refresh->flush();
+
+    const QMessageBox::StandardButton sideOrBall = QMessageBox::question(nullptr, QStringLiteral("Draw won."),
+        QStringLiteral("Would you prefer to choose side (Yes) over ball (No)?"),
+        QMessageBox::StandardButtons(QMessageBox::Yes|QMessageBox::No));
+
+    return (sideOrBall == QMessageBox::Yes);
+}
+
+Player * MatchWidget::selectPlayerForAction(const QString & dialogText, const QMap<uint32_t, Player *> & players,
+                                            bool * const selected) const {
+
+    this->_refresh->flush();
+
+    QStringList playersForSelection;
+    for (auto player: players) {
+
+        const QString playerDescription =
+            player->fullName() % string_functions.wrapInBrackets(QString::number(player->shirtNo())) %
+            QStringLiteral("- ") % player->position()->currentPosition();
+        playersForSelection.append(playerDescription);
+    }
+
+    const QString selectedPlayer = QInputDialog::getItem(nullptr, QStringLiteral("Select player"),
+                                                         dialogText, playersForSelection, 0, false, selected);
+
+    for (auto player: players)
+        if (selectedPlayer.contains(player->fullName()) && selectedPlayer.contains(QString::number(player->shirtNo())))
+            return player;
+
+    *selected = false;
+    return nullptr;
+}
+
+QString MatchWidget::selectActionAfterPenalty(const QString & dialogText, const QStringList & options) const {
+
+    this->_refresh->flush();
+    return QInputDialog::getItem(nullptr, QStringLiteral("Select action after penalty infringement"), dialogText, options);
+}
+
+uint8_t MatchWidget::conversionDistance(const QString & dialogText, const uint8_t value, const uint8_t minValue,
+                                        const uint8_t maxValue, bool * const execute) const {
+
+    this->_refresh->flush();
+    return QInputDialog::getInt(nullptr, QStringLiteral("Conversion"), dialogText, value, minValue, maxValue, 1, execute);
+}
+
+bool MatchWidget::substituteTiredPlayer(const QString & dialogText) const {
+
+    this->_refresh->flush();
+
+    const QMessageBox::StandardButton substitution =
+        QMessageBox::warning(nullptr, QStringLiteral("Player's fatigue very low."), dialogText);
+
+    return (substitution == QMessageBox::StandardButton::Ok);
+}
+
+// playerIn = false => phase 1 (player going out), playerIn = true => phase 2 (player going in)
+QString MatchWidget::selectPlayerForSubstitution(const QStringList & players, const bool playerIn, bool * const selected) const {
+
+    this->_refresh->flush();
+
+    const QString title = (!playerIn) ? QStringLiteral("Substitution (phase 1)") : QStringLiteral("Substitution (phase 2)");
+    const QString label = (!playerIn) ? QStringLiteral("Select player for substitution (out):")
+                                      : QStringLiteral("Select player for substitution (in):");
+
+    return InputDialog::getItem(nullptr, title, label, players, selected, 400, QStringLiteral("transfer.png"));
+}
+
 // [slot]
 void MatchWidget::playMatchInDiagnosticMode() {
 
@@ -252,10 +453,136 @@ void MatchWidget::playMatchInDiagnosticMode() {
 // [slot]
 void MatchWidget::playMatch() {
 
-    if (this->_play == nullptr) {
-        this->_play = new GamePlay(this, _settings, _dateTime, _match, _myTeam);
+    // match played already => it's not played again, its event log is replayed instead (if available)
+    if (this->_play == nullptr && this->_match->played()) {
+
+        if (this->_match->events().isEmpty())
+            this->_match->events().loadFromArchive(MatchEventLog::archiveFileName, this->_match->code());
+
+        MatchReplay replay(this->_match, this->_match->events());
+        replay.replay(this);
+        return;
     }
-    this->_play->playMatch();
+
+    if (this->_play == nullptr)
+        this->createGamePlay();
+
+    // match runs step by step (one step per timer tick) until end of current period
+    this->_play->start();
+
+    return;
+}
+
+// [slot]
+// sim to final whistle: the rest of the match (started or not) is played at once, only its final state is displayed
+void MatchWidget::finishMatch() {
+
+    if (this->_play == nullptr && this->_match->played())
+        return;
+
+    if (this->_play == nullptr)
+        this->createGamePlay();
+
+    // pending changes would overwrite final state otherwise
+    this->_refresh->flush();
+    this->_play->finish();
+
+    return;
+}
+
+// match which has been paused earlier (and whose snapshot has been saved) continues from where it was paused
+void MatchWidget::createGamePlay() {
+
+    this->_play = new GamePlay(_settings, _dateTime, _match, _myTeam, this);
+
+    // no snapshot of this match (or it can't be restored) => match starts from scratch with a new gameplay
+    if (!this->_play->loadSnapshot(GamePlay::snapshotFileName)) {
+
+        delete this->_play;
+        this->_play = new GamePlay(_settings, _dateTime, _match, _myTeam, this);
+    }
+
+    connect(this->_play, &GamePlay::stopped, this, &MatchWidget::autosave);
+    return;
+}
+
+// [slot]
+// autosave: snapshot of the match is taken whenever play stops (end of period or pause), it's removed at full-time
+void MatchWidget::autosave() const {
+
+    if (this->_match->currentPeriod() == MatchPeriod::TimePeriod::FULL_TIME)
+        QFile::remove(GamePlay::snapshotFileName);
+    else
+        this->_play->saveSnapshot(GamePlay::snapshotFileName);
+
+    return;
+}
+
+// [slot]
+// what-if analysis: my team's chances of winning if the match continues as it is or if a decision is made now (next
+// penalty kicked at goal or into touch, substitution now or later); branches are played in the background
+void MatchWidget::whatIfAnalysis() {
+
+    // analysis in progress => another one can't be started until it's finished
+    if (this->_branching != nullptr || this->_play == nullptr ||
+        this->_match->currentPeriod() == MatchPeriod::TimePeriod::WARM_UP ||
+        this->_match->currentPeriod() == MatchPeriod::TimePeriod::FULL_TIME)
+        return;
+
+    QVector<MatchBranching::Branch> branches = {
+
+        { MatchBranching::Decision::CONTINUE },
+        { MatchBranching::Decision::PENALTY_KICK_AT_GOAL },
+        { MatchBranching::Decision::PENALTY_KICK_TO_TOUCH }
+    };
+
+    // substitution is optional (dialog can be cancelled)
+    QMap<QString, Player *> playersOnPitch;
+    QMap<QString, Player *> playersOnBench;
+
+    for (auto player: this->_myTeam->squad()) {
+
+        if (player->isOnPitch() && player->isHealthy())
+            playersOnPitch.insert(this->playerForSubstitution(player), player);
+        if (player->isOnBench() && player->isHealthy())
+            playersOnBench.insert(this->playerForSubstitution(player), player);
+    }
+
+    bool selected = false;
+    const QString playerOut = this->selectPlayerForSubstitution(playersOnPitch.keys(), false, &selected);
+
+    if (selected && !playersOnBench.isEmpty()) {
+
+        const QString playerIn = this->selectPlayerForSubstitution(playersOnBench.keys(), true, &selected);
+        if (selected) {
+
+            branches.push_back({ MatchBranching::Decision::SUBSTITUTE_NOW, playersOnPitch[playerOut]->code(),
+                                 playersOnBench[playerIn]->code() });
+            branches.push_back({ MatchBranching::Decision::SUBSTITUTE_LATER, playersOnPitch[playerOut]->code(),
+                                 playersOnBench[playerIn]->code() });
+        }
+    }
+
+    this->_branching =
+        new MatchBranching(this->_settings, this->_dateTime, this->_match, this->_myTeam, this->_play, branches);
+
+    QVector<uint32_t> rollouts(MatchBranching::defaultNumberOfRollouts * branches.size());
+    std::iota(rollouts.begin(), rollouts.end(), 0);
+
+    this->_branchingWatcher->setFuture(QtConcurrent::mappedReduced(rollouts, MatchBranching::RolloutFunctor(this->_branching),
+                                                                   &MatchBranching::add));
+    return;
+}
+
+// [slot]
+void MatchWidget::whatIfAnalysisFinished() {
+
+    if (!this->_branchingWatcher->isCanceled())
+        QMessageBox::information(this, QStringLiteral("What if..."),
+                                 this->_branching->summaryAsHtml(this->_branchingWatcher->result()));
+
+    delete this->_branching;
+    this->_branching = nullptr;
 
     return;
 }
@@ -6,20 +6,24 @@
 #ifndef MATCHWIDGET_H
 #define MATCHWIDGET_H
 
+#include <QFutureWatcher>
 #include <QLabel>
 #include <QString>
 #include <QStringList>
 #include <QWidget>
 #include <cmath>
 #include "match/gameplay.h"
+#include "match/gameplay_observer.h"
+#include "match/match_branching.h"
 #include "settings/config.h"
 #include "shared/datetime.h"
+#include "shared/refresh_coordinator.h"
 #include "team.h"
 #include "ui/widgets/ui_matchwidget.h"
 
 class Match;
 
-class MatchWidget: public QWidget {
+class MatchWidget: public QWidget, public GamePlayObserver {
 
    Q_OBJECT
 
@@ -31,23 +35,48 @@ class MatchWidget: public QWidget {
         explicit MatchWidget(QWidget *, Match *, Match *, MatchType::Type *, Team * const, Settings * const, DateTime &);
         ~MatchWidget();
 
-        void timeStoppedMessageBox(const QString &, const QStringList & = QStringList());
+        // GamePlayObserver: match progress
+        inline MatchDisplay::Type display() const override { return MatchDisplay::DETAIL; }
+        inline void dateTimeChanged() override { emit timeChanged(); return; }
+        void timeRefreshed(const QString &, const uint16_t, const bool = true) override;
+        void resetMatchProgress(const MatchPeriods * const, const MatchPeriod::TimePeriod, const bool = true) override;
 
-        void updateStatisticsUI(const MatchType::Location, const QString &, const QString &, const bool = true) const;
+        // GamePlayObserver: match details
+        void timeStoppedMessageBox(const QString &, const QStringList & = QStringList()) override;
+        void notify(const Notification, const QString &, const QString &) const override;
+        bool diagnosticData(const QString &) const override;
 
-        QString currentScore() const;
-        void displayPoints(const QMap<PointEvent, QStringList> &, const MatchType::Location) const;
+        void updatePeriod(const QString &) override;
+        void updateStatisticsUI(const MatchType::Location, const QString &, const QString &, const bool = true) const override;
 
-        QString playerForSubstitution(Player * const) const;
+        QString currentScore() const override;
+        void displayPoints(const QMap<PointEvent, QStringList> &, const MatchType::Location) const override;
+        void bonusPointGained(const MatchType::Location) const override;
 
-        inline bool extendedLog() const { return (_settings->logging() == LogLevel::EXTENDED); }
-        inline QString pointsInfoForLog(const uint8_t noOfPoints) const
-            { return QStringLiteral(" (") + QString::number(noOfPoints) + QStringLiteral(" points)"); }
-        QString dominationStatsForLog(const double, const uint8_t, const bool = false) const;
-        void logRecord(const QString &) const;
+        QString playerForSubstitution(Player * const) const override;
 
-        void updatePackWeight() const;
-        void updatePlayer(const QString &, const MatchType::Location) const;
+        inline bool extendedLog() const override { return (_settings->logging() == LogLevel::EXTENDED); }
+        inline QString pointsInfoForLog(const uint8_t noOfPoints) const override
+            { return QStringLiteral(" (") + QString::number(noOfPoints) + QStringLiteral(" points)"); }
+        QString dominationStatsForLog(const double, const uint8_t, const bool = false) const override;
+        void logRecord(const QString &) const override;
+
+        void updatePackWeight() const override;
+        void updatePlayer(const QString &, const MatchType::Location) const override;
+        void possessionChanged(const MatchType::Location) const override;
+        void phasesChanged(const MatchType::Location, const uint8_t) const override;
+        void ballPositionChanged(const int8_t) const override;
+
+        // GamePlayObserver: manager's decisions
+        bool sideOverBall() const override;
+        Player * selectPlayerForAction(const QString &, const QMap<uint32_t, Player *> &, bool * const) const override;
+        QString selectActionAfterPenalty(const QString &, const QStringList &) const override;
+        uint8_t conversionDistance(const QString &, const uint8_t, const uint8_t, const uint8_t, bool * const) const override;
+        bool substituteTiredPlayer(const QString &) const override;
+        QString selectPlayerForSubstitution(const QStringList &, const bool, bool * const) const override;
+
+        inline bool substitutionRequested() const override { return (_resumePlay == ResumePlay::SUBSTITUTION); }
+        inline void substitutionRequestHandled() override { _resumePlay = ResumePlay::NO_ACTION; return; }
 
         inline void nextAction(const ResumePlay nextAction) { _resumePlay = nextAction; return; }
         inline ResumePlay resumePlay() const { return _resumePlay; }
@@ -55,8 +84,11 @@ class MatchWidget: public QWidget {
         Ui_MatchWidget * ui;
 
     private:
+        typedef QFutureWatcher<MatchBranching::Summary> BranchingWatcher;
+
         QString labelName(const QString &, const QString &) const;
         QLabel * findWidgetByObjectName(const QString &, const MatchType::Location) const;
+        void createGamePlay();
 
         Settings * _settings;
         DateTime & _dateTime;
@@ -69,9 +101,22 @@ class MatchWidget: public QWidget {
         ResumePlay _resumePlay;
         GamePlay * _play;
 
+        RefreshCoordinator * _refresh;
+
+        // what-if analysis in progress (at most one at a time); rollouts are played on global thread pool
+        const MatchBranching * _branching;
+        BranchingWatcher * _branchingWatcher;
+
+    signals:
+        void timeChanged();
+
     private slots:
         void playMatchInDiagnosticMode();
         void playMatch();
+        void finishMatch();
+        void autosave() const;
+        void whatIfAnalysis();
+        void whatIfAnalysisFinished();
 };
 
 #endif // MATCHWIDGET_H
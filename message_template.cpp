@@ -0,0 +1,78 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QHash>
+#include <QStringBuilder>
+#include "shared/message_template.h"
+#include "shared/messages.h"
+
+// inserted texts are replaced by characters from private use area => the message is obtained from Messages (in exactly
+// the same way as by displayWithReplace) and then split at these characters
+static inline QChar placeholder(const uint8_t index) { return QChar(0xE000 + index); }
+
+MessageTemplate::MessageTemplate(const QString & group, const QString & key): _literalLength(0) {
+
+    QStringList placeholders;
+    for (uint8_t i = 0; i < maxInsertedTexts; ++i)
+        placeholders.append(QString(placeholder(i)));
+
+    const QString text = message.displayWithReplace(group, key, placeholders);
+
+    int start = 0;
+    for (int i = 0; i < text.size(); ++i) {
+
+        const ushort index = text.at(i).unicode() - placeholder(0).unicode();
+        if (index >= maxInsertedTexts)
+            continue;
+
+        if (i > start)
+            this->_segments.append({ text.mid(start, i-start), -1 });
+        this->_segments.append({ QString(), static_cast<int8_t>(index) });
+        start = i+1;
+    }
+    if (start < text.size())
+        this->_segments.append({ text.mid(start), -1 });
+
+    for (const auto & segment: this->_segments)
+        this->_literalLength += segment.text.size();
+}
+
+const MessageTemplate & MessageTemplate::find(const QString & group, const QString & key) {
+
+    static QHash<QString, MessageTemplate> templates;
+
+    const QString id = group % QChar('/') % key;
+    auto it = templates.find(id);
+    if (it == templates.end())
+        it = templates.insert(id, MessageTemplate(group, key));
+
+    return it.value();
+}
+
+// buffer isn't cleared (text is appended to its current content)
+void MessageTemplate::appendTo(QString & buffer, const QStringList & insertedTexts) const {
+
+    int length = buffer.size() + this->_literalLength;
+    for (const auto & text: insertedTexts)
+        length += text.size();
+    buffer.reserve(length);
+
+    for (const auto & segment: this->_segments) {
+
+        if (segment.insertedText < 0)
+            buffer.append(segment.text);
+        else if (segment.insertedText < insertedTexts.size())
+            buffer.append(insertedTexts.at(segment.insertedText));
+    }
+
+    return;
+}
+
+QString MessageTemplate::format(const QStringList & insertedTexts) const {
+
+    QString text;
+    this->appendTo(text, insertedTexts);
+    return text;
+}
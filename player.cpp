@@ -3,7 +3,9 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <QDataStream>
 #include "player/player.h"
+#include "player/position_types.h"
 
 const QString Player::preferenceDescription = QStringLiteral("/preferenceDescription");
 
@@ -30,6 +32,58 @@ Player::~Player() {
     delete _position;
 }
 
+// deep copy (player can be used in a match which must not affect the original, e.g. calibration of QuickSim)
+Player * Player::clone() const {
+
+    Player * const player = new Player(*this);
+
+    player->_position = new PlayerPosition(*(this->_position));
+    player->_attributes = new PlayerAttributes(*(this->_attributes));
+    player->_condition = this->_condition->clone();
+    player->_stats = new PlayerStats(*(this->_stats));
+    player->_points = new PlayerPoints(*(this->_points));
+
+    return player;
+}
+
+// everything about a player which can change during a match (except statistics which are rebuilt from match's event log):
+// number on pitch (0 = on bench, sin-binned or substituted), assigned position, preferences and condition
+void Player::writeMatchState(QDataStream & stream) const {
+
+    stream << static_cast<quint8>(this->_noOnPitch) << static_cast<quint8>(this->_position->currentPositionNo())
+           << static_cast<qint16>(this->_preferredFor);
+    this->_condition->writeTo(stream);
+
+    return;
+}
+
+// state is only read here, it is applied separately (snapshot is applied only when it has been read as a whole)
+bool Player::readMatchState(QDataStream & stream, MatchState & state) {
+
+    quint8 noOnPitch = 0, positionCode = 0;
+    qint16 preferredFor = 0;
+
+    stream >> noOnPitch >> positionCode >> preferredFor;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    state.noOnPitch = noOnPitch;
+    state.positionCode = positionCode;
+    state.preferredFor = preferredFor;
+
+    return PlayerCondition::readFrom(stream, state.decreaseInCondition);
+}
+
+void Player::applyMatchState(const MatchState & state) {
+
+    this->_noOnPitch = state.noOnPitch;
+    this->_position->assignNewPlayerPosition(playerPosition_index.findPlayerPositionByCode(state.positionCode));
+    this->_preferredFor = state.preferredFor;
+    this->_condition->applyDecreases(state.decreaseInCondition);
+
+    return;
+}
+
 uint8_t Player::age(const QDate & currentDate) const {
 
     if (!_birthDate.isValid() || _birthDate >= currentDate)
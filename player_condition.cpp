@@ -3,22 +3,31 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <QDataStream>
 #include <algorithm>
 #include "player/player_condition.h"
+#include "shared/random_stream.h"
 
-PlayerCondition::PlayerCondition(): changeCondition(nullptr), _fatigue(maxValue), _fitness(maxValue),
-                                    _health(maxValue), _morale(maxValue), _form(maxValue) {
+PlayerCondition::PlayerCondition(): changeCondition(nullptr) {
+
+    this->_value.fill(maxValue);
     this->fullCondition();
     this->generateCurrentForm();
 }
 
-PlayerCondition::PlayerCondition(const std::array<uint8_t, 4> & conditions, const uint8_t form):
-    _fatigue(conditions[0]), _fitness(conditions[1]), _health(conditions[2]), _morale(conditions[3]), _form(form) {
+PlayerCondition::PlayerCondition(const std::array<uint8_t, 4> & conditions, const uint8_t form) {
+
+    this->_value.fill(0);
+    this->_value[static_cast<uint8_t>(player::Conditions::FATIGUE)] = conditions[0];
+    this->_value[static_cast<uint8_t>(player::Conditions::FITNESS)] = conditions[1];
+    this->_value[static_cast<uint8_t>(player::Conditions::HEALTH)] = conditions[2];
+    this->_value[static_cast<uint8_t>(player::Conditions::MORALE)] = conditions[3];
+    this->_value[static_cast<uint8_t>(player::Conditions::FORM)] = form;
 
     this->fullCondition();
 
     const uint8_t formMaxValue = (this->currentState() == player::HealthStatus::HEALTHY) ? maxValue : maxValue/2;
-    if (this->_form == 0)
+    if (form == 0)
         generateCurrentForm(formMaxValue);
 }
 
@@ -33,9 +42,8 @@ void PlayerCondition::generateCurrentForm(const uint8_t upperLimit) {
 
 void PlayerCondition::fullCondition() {
 
-    this->_decreaseInCondition.clear();
-    for (uint8_t i = 0; i < static_cast<uint8_t>(player::Conditions::OVERALL); ++i)
-        this->_decreaseInCondition.insert(static_cast<player::Conditions>(i), 0);
+    this->_decreaseInCondition.fill(0);
+    this->_overall = this->overallCondition(ConditionWeights());
 
     return;
 }
@@ -109,15 +117,22 @@ PlayerHealth * PlayerCondition::liveHealthStatus() const {
     return (status != this->_healthStatus_list.end()) ? *(status) : nullptr;
 }
 
+// random == nullptr => shared generator (RandomValue) is used; during a match the match's own stream is passed in
 void PlayerCondition::newHealthIssue(const QDate & currentDate, const player::HealthStatus fromStatus,
-                                                                const player::HealthStatus toStatus) {
+                                     const player::HealthStatus toStatus, RandomStream * const random) {
+
+    auto randomInt = [random](const uint16_t from, const uint16_t to) -> uint16_t {
+
+        return (random != nullptr) ? random->generateRandomInt<uint16_t>(from, to)
+                                   : RandomValue::generateRandomInt<uint16_t>(from, to);
+    };
 
     const uint16_t from = (fromStatus == PlayerHealth::_timeOfAbsenceCategories.at(0).causeOfAbsence() ||
                            fromStatus == player::HealthStatus::UNKNOWN) ? 1 :
         PlayerHealth::absenceSumOfProbabilities(static_cast<player::HealthStatus>(static_cast<uint8_t>(fromStatus)-1))+1;
     const uint16_t to = PlayerHealth::absenceSumOfProbabilities(toStatus);
 
-    int16_t healthIssueProbability = static_cast<int16_t>(RandomValue::generateRandomInt<uint16_t>(from, to));
+    int16_t healthIssueProbability = static_cast<int16_t>(randomInt(from, to));
     player::HealthStatus healthIssue = player::HealthStatus::UNKNOWN;
 
     for (auto issue: PlayerHealth::_timeOfAbsenceCategories) {
@@ -126,8 +141,8 @@ void PlayerCondition::newHealthIssue(const QDate & currentDate, const player::He
             { healthIssue = issue.causeOfAbsence(); break; }
     }
 
-    const uint8_t days = RandomValue::generateRandomInt(PlayerHealth::absenceTimePeriod(healthIssue).first,
-                                                        PlayerHealth::absenceTimePeriod(healthIssue).second);
+    const uint8_t days = randomInt(PlayerHealth::absenceTimePeriod(healthIssue).first,
+                                   PlayerHealth::absenceTimePeriod(healthIssue).second);
     const QDate endDate = (days <= 60) ? currentDate.addDays(days) : QDate();
 
     PlayerHealth * const newHealthIssue = new PlayerHealth(currentDate, endDate, healthIssue);
@@ -167,6 +182,17 @@ void PlayerCondition::invalidateHealthIssue() {
     return;
 }
 
+// health records are referenced by pointers => copy gets its own records (copied condition must not change the original)
+PlayerCondition * PlayerCondition::clone() const {
+
+    PlayerCondition * const condition = new PlayerCondition(*this);
+
+    for (auto & it: condition->_healthStatus_list)
+        it = new PlayerHealth(*it);
+
+    return condition;
+}
+
 const QVector<PlayerHealth *> & PlayerCondition::completeHealthStatusHistory(uint16_t & totalNumberOfDays) const {
 
     for (auto it: _healthStatus_list)
@@ -178,51 +204,83 @@ const QVector<PlayerHealth *> & PlayerCondition::completeHealthStatusHistory(uin
 // original = true: returns original value, original = false (default): returns current value
 uint16_t PlayerCondition::getValue(const player::Conditions condition, const bool original) const {
 
-    uint16_t value = 0;
-
-    switch (condition) {
-
-        case player::Conditions::FATIGUE: value = _fatigue; break;
-        case player::Conditions::FITNESS: value = _fitness; break;
-        case player::Conditions::FORM: value = _form; break;
-        case player::Conditions::HEALTH: value = _health; break;
-        case player::Conditions::MORALE: value = _morale; break;
-        case player::Conditions::OVERALL: value = this->overallCondition(ConditionWeights()); break;
-        default: value = 0;
-    }
+    const uint8_t i = static_cast<uint8_t>(condition);
+    if (i >= noOfConditions)
+        return 0;
 
-    return (value - ((!original) ? this->_decreaseInCondition.value(condition, 0) : 0));
+    // overall condition (with default weights) is computed whenever any condition changes, not here => const getter
+    // doesn't write anything and concurrent readers of the same player don't race
+    const uint16_t value = (condition == player::Conditions::OVERALL) ? this->_overall : this->_value[i];
+    return (value - ((!original) ? this->_decreaseInCondition[i] : 0));
 }
 
 uint16_t PlayerCondition::overallCondition(const ConditionWeights & conditions) const {
 
+    auto current = [this](const player::Conditions condition) -> uint16_t {
+
+        const uint8_t i = static_cast<uint8_t>(condition);
+        return (this->_value[i] - this->_decreaseInCondition[i]);
+    };
+
     const uint16_t total =
-        this->getValue(player::Conditions::FATIGUE) * conditions.conditionWeight(player::Conditions::FATIGUE) +
-        this->getValue(player::Conditions::FITNESS) * conditions.conditionWeight(player::Conditions::FITNESS) +
-        this->getValue(player::Conditions::FORM) * conditions.conditionWeight(player::Conditions::FORM) +
-        this->getValue(player::Conditions::HEALTH) * conditions.conditionWeight(player::Conditions::HEALTH) +
-        this->getValue(player::Conditions::MORALE) * conditions.conditionWeight(player::Conditions::MORALE);
+        current(player::Conditions::FATIGUE) * conditions.conditionWeight(player::Conditions::FATIGUE) +
+        current(player::Conditions::FITNESS) * conditions.conditionWeight(player::Conditions::FITNESS) +
+        current(player::Conditions::FORM) * conditions.conditionWeight(player::Conditions::FORM) +
+        current(player::Conditions::HEALTH) * conditions.conditionWeight(player::Conditions::HEALTH) +
+        current(player::Conditions::MORALE) * conditions.conditionWeight(player::Conditions::MORALE);
 
     return total;
 }
 
 void PlayerCondition::increaseCondition(const player::Conditions condition, const uint8_t value) {
 
-    if (value == 0 || !_decreaseInCondition.contains(condition))
+    const uint8_t i = static_cast<uint8_t>(condition);
+    if (value == 0 || i >= noOfConditions)
         return;
 
-    _decreaseInCondition[condition] -= std::min<uint8_t>(value, _decreaseInCondition[condition]);
+    _decreaseInCondition[i] -= std::min<uint8_t>(value, _decreaseInCondition[i]);
+    _overall = this->overallCondition(ConditionWeights());
 
     return;
 }
 
 void PlayerCondition::decreaseCondition(const player::Conditions condition, const uint8_t value) {
 
-    if (value == 0 || (_decreaseInCondition.contains(condition) && _decreaseInCondition[condition] == maxValue - minValue))
+    const uint8_t i = static_cast<uint8_t>(condition);
+    if (value == 0 || i >= noOfConditions || _decreaseInCondition[i] == maxValue - minValue)
         return;
 
-    // operator[] updates existing condition/value or constructs (inserts) new condition/value
-    _decreaseInCondition[condition] += std::min<uint8_t>(value, maxValue - minValue - _decreaseInCondition[condition]);
+    _decreaseInCondition[i] += std::min<uint8_t>(value, maxValue - minValue - _decreaseInCondition[i]);
+    _overall = this->overallCondition(ConditionWeights());
+
+    return;
+}
+
+// only decreases in condition change during a match (base values are the same) => only they are part of match snapshot
+void PlayerCondition::writeTo(QDataStream & stream) const {
+
+    for (const auto decrease: this->_decreaseInCondition)
+        stream << static_cast<quint8>(decrease);
+
+    return;
+}
+
+bool PlayerCondition::readFrom(QDataStream & stream, Decreases & decreases) {
+
+    for (auto & decrease: decreases) {
+
+        quint8 value = 0;
+        stream >> value;
+        decrease = value;
+    }
+
+    return (stream.status() == QDataStream::Ok);
+}
+
+void PlayerCondition::applyDecreases(const Decreases & decreases) {
+
+    this->_decreaseInCondition = decreases;
+    _overall = this->overallCondition(ConditionWeights());
 
     return;
 }
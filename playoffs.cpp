@@ -14,6 +14,34 @@ QVector<Match *>::iterator Playoffs::from_match(const MatchType::ToPlayOff playO
     { return !match->played() && match->type() == MatchType::Type::PLAYOFFS && match->playoffsType() == playOffType; }));
 }
 
+// draw rule: team in given position (ranking) of its group's final table; tables are ordered the same way as league
+// table and they are built on first use (teams of one group are taken from teams, table is kept in tables)
+// note: SeasonForecast applies the same rule to copies of teams holding standings of a simulated season
+// return value: nullptr if there's no such position in group
+Team * Playoffs::qualifiedTeam(const QPair<QString, uint8_t> & ranking, const QVector<Team *> & teams,
+                               QMap<QString, QVector<Team *>> & tables) {
+
+    QVector<Team *> & teamsInGroup = tables[ranking.first]; // if current group is missing => create it
+    const uint8_t position = ranking.second - 1;
+
+    if (teamsInGroup.isEmpty()) {
+
+        for (auto team: teams)
+            if (team->group() == ranking.first)
+                teamsInGroup.push_back(team);
+        std::sort(teamsInGroup.begin(), teamsInGroup.end(), sortTable);
+    }
+
+    return (position < teamsInGroup.size()) ? teamsInGroup.at(position) : nullptr;
+}
+
+// draw rule: team advancing from previous play-offs' match (code of that match) is either its winner or its loser
+// note: shared with SeasonForecast the same way as qualifiedTeam
+QPair<uint32_t, TeamResults::ResultType> Playoffs::advancingTeam(const QPair<uint32_t, bool> & fromMatch) {
+
+    return qMakePair(fromMatch.first, static_cast<TeamResults::ResultType>(fromMatch.second));
+}
+
 bool Playoffs::drawPlayoffs(const QVector<Team *> & teams, QVector<Match *>::iterator * fromMatch) const {
 
     uint8_t teamsAssignedToPlayoffMatches = 0;
@@ -36,21 +64,12 @@ bool Playoffs::drawPlayoffs(const QVector<Team *> & teams, QVector<Match *>::ite
             for (uint8_t i = 0; i < 2; ++i) {
 
                 const MatchType::Location loc = static_cast<MatchType::Location>(i);
-                const QString & group = rule->ranking(loc).first;
 
                 if (match->team(loc) == nullptr) {
 
-                    QVector<Team *> & teamsInGroup = teamsInGroups[group]; // if current group is missing => create it
-                    const uint8_t & ranking = rule->ranking(loc).second - 1;
-
-                    if (teamsInGroup.isEmpty()) {
-
-                        for (auto team: teams)
-                            if (team->group() == group)
-                                teamsInGroup.push_back(team);
-                        std::sort(teamsInGroup.begin(), teamsInGroup.end(), sortTable);
-                    }
-                    teamsAssignedToPlayoffMatches += static_cast<uint8_t>(match->setTeam(loc, teamsInGroup[ranking]));
+                    Team * const team = Playoffs::qualifiedTeam(rule->ranking(loc), teams, teamsInGroups);
+                    if (team != nullptr)
+                        teamsAssignedToPlayoffMatches += static_cast<uint8_t>(match->setTeam(loc, team));
                 }
             }
         }
@@ -74,12 +93,13 @@ void Playoffs::assignTeamsForPlayoffsMatches(QVector<Match *>::iterator * fromMa
 
                 const MatchType::Location loc = static_cast<MatchType::Location>(i);
 
+                const QPair<uint32_t, TeamResults::ResultType> fromMatch = Playoffs::advancingTeam(rule->teamFromMatch(loc));
+
                 Match * const * sourceMatch = std::find_if(_fixtures->cbegin(), _fixtures->cend(),
-                    [&rule, loc](Match * const it) -> bool { return it->code() == rule->teamFromMatch(loc).first; });
-                TeamResults::ResultType result = static_cast<TeamResults::ResultType>(rule->teamFromMatch(loc).second);
+                    [&fromMatch](Match * const it) -> bool { return it->code() == fromMatch.first; });
 
-                if ((*sourceMatch)->winner(result) != nullptr)
-                    (*match)->setTeam(loc, (*sourceMatch)->winner(result));
+                if ((*sourceMatch)->winner(fromMatch.second) != nullptr)
+                    (*match)->setTeam(loc, (*sourceMatch)->winner(fromMatch.second));
             }
         }
     }
@@ -0,0 +1,707 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QSettings>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include "match/quick_sim.h"
+#include "player/position_types.h"
+#include "shared/constants.h"
+
+const QString QuickSim::modelFileName = QStringLiteral("quick_sim.ini");
+
+const QVector<QPair<QString, double QuickSim::Model::*>> QuickSim::parameters {
+
+    { QStringLiteral("tries"), &Model::tries },
+    { QStringLiteral("penaltyGoals"), &Model::penaltyGoals },
+    { QStringLiteral("dropGoals"), &Model::dropGoals },
+    { QStringLiteral("conversionRate"), &Model::conversionRate },
+    { QStringLiteral("homeAdvantage"), &Model::homeAdvantage },
+    { QStringLiteral("rankingWeight"), &Model::rankingWeight },
+    { QStringLiteral("yellowCards"), &Model::yellowCards },
+    { QStringLiteral("redCards"), &Model::redCards },
+    { QStringLiteral("passes"), &Model::passes },
+    { QStringLiteral("passesCompletedRate"), &Model::passesCompletedRate },
+    { QStringLiteral("tackles"), &Model::tackles },
+    { QStringLiteral("tacklesCompletedRate"), &Model::tacklesCompletedRate },
+    { QStringLiteral("carries"), &Model::carries },
+    { QStringLiteral("metresRun"), &Model::metresRun },
+    { QStringLiteral("metresKicked"), &Model::metresKicked },
+    { QStringLiteral("metresPerKick"), &Model::metresPerKick },
+    { QStringLiteral("lineouts"), &Model::lineouts },
+    { QStringLiteral("lineoutsWonRate"), &Model::lineoutsWonRate },
+    { QStringLiteral("scrums"), &Model::scrums },
+    { QStringLiteral("scrumsWonRate"), &Model::scrumsWonRate },
+    { QStringLiteral("handlingErrors"), &Model::handlingErrors },
+    { QStringLiteral("offloads"), &Model::offloads },
+    { QStringLiteral("penaltyInfringements"), &Model::penaltyInfringements },
+    { QStringLiteral("substitutions"), &Model::substitutions }
+};
+
+QuickSim::QuickSim(DateTime & dateTime, Match * const match, const Model & model):
+    _dateTime(dateTime), _match(match), _model(model), _random(RandomStream::forCode(match->code())), _second(0),
+    _substitutionSecond{0,0}, _substituted{false,false} {}
+
+QuickSim::Engine QuickSim::engine(Match * const match, Team * const myTeam) {
+
+    if (myTeam != nullptr && match->isTeamInPlay(myTeam))
+        return Engine::GAMEPLAY;
+
+    return QuickSim::backgroundEngine();
+}
+
+QuickSim::Model QuickSim::loadModel(const QString & fileName) {
+
+    Model model;
+    QSettings file(fileName, QSettings::IniFormat);
+
+    file.beginGroup(QStringLiteral("model"));
+    for (const auto & parameter: QuickSim::parameters)
+        model.*(parameter.second) = file.value(parameter.first, model.*(parameter.second)).toDouble();
+    file.endGroup();
+
+    return model;
+}
+
+bool QuickSim::saveModel(const Model & model, const QString & fileName) {
+
+    QSettings file(fileName, QSettings::IniFormat);
+
+    file.beginGroup(QStringLiteral("model"));
+    for (const auto & parameter: QuickSim::parameters)
+        file.setValue(parameter.first, model.*(parameter.second));
+    file.endGroup();
+
+    file.sync();
+    return (file.status() == QSettings::NoError);
+}
+
+uint32_t QuickSim::poisson(const double mean) {
+
+    if (!(mean > 0.0))
+        return 0;
+
+    std::poisson_distribution<uint32_t> distribution(mean);
+    return distribution(this->_random);
+}
+
+bool QuickSim::chance(const double probability) {
+
+    std::bernoulli_distribution distribution(std::min(std::max(probability, 0.0), 1.0));
+    return distribution(this->_random);
+}
+
+// the better the ranking of a team (the lower the number) the more tries it scores; difference between rankings
+// is capped the same way as in ProbabilityTable
+double QuickSim::expectedTries(const MatchType::Location loc) const {
+
+    const MatchType::Location opponent = (loc == MatchType::Location::HOSTS)
+        ? MatchType::Location::VISITORS : MatchType::Location::HOSTS;
+
+    const int16_t rankingDiff = static_cast<int16_t>(this->_match->team(opponent)->ranking()) -
+                                static_cast<int16_t>(this->_match->team(loc)->ranking());
+    const int16_t cappedDiff = std::min<int16_t>(std::max<int16_t>(rankingDiff, -20), 20);
+
+    const double homeAdvantage = (loc == MatchType::Location::HOSTS) ? this->_model.homeAdvantage : 1.0;
+    return (this->_model.tries * std::exp(this->_model.rankingWeight * cappedDiff) * homeAdvantage);
+}
+
+// share of possession (and territory) follows share of expected tries (but only halfway)
+double QuickSim::possessionShare(const MatchType::Location loc) const {
+
+    const MatchType::Location opponent = (loc == MatchType::Location::HOSTS)
+        ? MatchType::Location::VISITORS : MatchType::Location::HOSTS;
+
+    const double tries = this->expectedTries(loc);
+    return (0.5 + (tries / (tries + this->expectedTries(opponent)) - 0.5) / 2);
+}
+
+QuickSim::Lineup QuickSim::lineup(const MatchType::Location loc) const {
+
+    Lineup lineup;
+    QVector<QPair<Player *, double>> tryScorers, tacklers, ballCarriers;
+    Player * bestKicker = nullptr;
+
+    for (auto player: this->_match->team(loc)->squad()) {
+
+        if (!player->isOnPitch())
+            continue;
+
+        lineup.players.append(player);
+        tryScorers.append(qMakePair(player, 1.0 + player->attribute(player::Attributes::SPEED) +
+                                    player->attribute(player::Attributes::AGILITY) + player->attribute(player::Attributes::HANDLING)));
+        tacklers.append(qMakePair(player, 1.0 + player->attribute(player::Attributes::TACKLING) +
+                                  player->attribute(player::Attributes::STRENGTH)));
+        ballCarriers.append(qMakePair(player, 1.0 + player->attribute(player::Attributes::STRENGTH) +
+                                      player->attribute(player::Attributes::SPEED)));
+
+        // preferred kicker takes precedence over the best one
+        if (lineup.kicker == nullptr && player->isPreferredFor(player::PreferredForAction::CONVERSION))
+            lineup.kicker = player;
+        if (bestKicker == nullptr ||
+            player->attribute(player::Attributes::KICKING) > bestKicker->attribute(player::Attributes::KICKING))
+            bestKicker = player;
+    }
+
+    if (lineup.kicker == nullptr)
+        lineup.kicker = bestKicker;
+
+    lineup.tryScorers.build(tryScorers);
+    lineup.tacklers.build(tacklers);
+    lineup.ballCarriers.build(ballCarriers);
+
+    return lineup;
+}
+
+QuickSim::Lineup & QuickSim::lineupAt(const MatchType::Location loc, const uint16_t second) {
+
+    return this->_lineups[loc][second >= this->_substitutionSecond[loc]];
+}
+
+// the same as in GamePlay::startOfMatch
+void QuickSim::startOfMatch() {
+
+    // set players No. 1-15 of both teams as being on pitch
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+        for (auto player: this->_match->team(loc)->squad()) {
+
+            player->includePlayerIntoStartingXV();
+            if (player->isOnPitch()) {
+
+                this->_match->addNewStatsRecordForPlayer(loc, player);
+                this->updateStatistics(loc, StatsType::NumberOf::GAMES_PLAYED, player);
+                this->_timeOnPitch[i].insert(player, qMakePair<uint16_t, uint16_t>(0, UINT16_MAX));
+            }
+        }
+        this->_match->team(loc)->lineupChanged();
+
+        // lineup after substitutions is the same until substitutions are made
+        this->_lineups[i][0] = this->lineup(loc);
+        this->_lineups[i][1] = this->_lineups[i][0];
+        this->_substitutionSecond[i] = this->_random.generateRandomInt<uint16_t>(50*60, 70*60);
+    }
+
+    return;
+}
+
+// scoring and disciplinary events of both teams (sorted by time of event)
+void QuickSim::drawEvents(QVector<Event> & events) {
+
+    const uint16_t regularTime = this->_periods.length(MatchPeriod::TimePeriod::FIRST_HALF_TIME, 60) +
+                                 this->_periods.length(MatchPeriod::TimePeriod::SECOND_HALF_TIME, 60);
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+
+        // penalty goals are more likely for better team as well
+        const double strength = this->expectedTries(loc) / this->_model.tries;
+        const QList<QPair<MatchEvent::Type, uint32_t>> counts = {
+
+            { MatchEvent::Type::TRY, this->poisson(this->expectedTries(loc)) },
+            { MatchEvent::Type::PENALTY_GOAL, this->poisson(this->_model.penaltyGoals * strength) },
+            { MatchEvent::Type::DROP_GOAL, this->poisson(this->_model.dropGoals * strength) },
+            { MatchEvent::Type::YELLOW_CARD, this->poisson(this->_model.yellowCards) },
+            { MatchEvent::Type::RED_CARD, this->poisson(this->_model.redCards) }
+        };
+
+        for (const auto & count: counts)
+            for (uint32_t j = 0; j < count.second; ++j)
+                events.append({ this->_random.generateRandomInt<uint16_t>(0, regularTime-1), count.first, loc });
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event & first, const Event & second) { return (first.second < second.second); });
+    return;
+}
+
+void QuickSim::playUntil(const uint16_t second, QVector<Event>::const_iterator & event,
+                         const QVector<Event>::const_iterator & end) {
+
+    for (; event != end && event->second < second; ++event) {
+
+        this->advanceTo(event->second);
+        this->applyEvent(*event);
+    }
+
+    this->advanceTo(second);
+    return;
+}
+
+// substitutions due within the time added are made (in order of their time)
+void QuickSim::advanceTo(const uint16_t second) {
+
+    while (true) {
+
+        int8_t next = -1;
+        for (uint8_t i = 0; i < 2; ++i)
+            if (!this->_substituted[i] && this->_substitutionSecond[i] <= second &&
+                (next < 0 || this->_substitutionSecond[i] < this->_substitutionSecond[next]))
+                next = static_cast<int8_t>(i);
+
+        if (next < 0)
+            break;
+
+        if (this->_substitutionSecond[next] > this->_second) {
+
+            this->_match->timePlayed().addTime(this->_substitutionSecond[next] - this->_second);
+            this->_second = this->_substitutionSecond[next];
+        }
+
+        this->substitutions(static_cast<MatchType::Location>(next));
+        this->_substituted[next] = true;
+    }
+
+    if (second > this->_second) {
+
+        this->_match->timePlayed().addTime(second - this->_second);
+        this->_second = second;
+    }
+
+    return;
+}
+
+// all substitutions of a team are made at once; every player coming off the bench replaces tired(est) player
+// of the same position base type (as in GamePlay::isEligibleForSubstitution)
+void QuickSim::substitutions(const MatchType::Location loc) {
+
+    Team * const team = this->_match->team(loc);
+    uint8_t substitutionsMade = 0;
+
+    for (auto playerIn: team->squad()) {
+
+        if (substitutionsMade >= std::round(this->_model.substitutions))
+            break;
+        if (!playerIn->isOnBench() || !playerIn->isHealthy() || this->_match->playerStats(loc, playerIn) != nullptr)
+            continue;
+
+        const PlayerPosition_index_item::PositionBaseType baseType =
+            playerPosition_index.findPositionBaseTypeByType(playerIn->position()->positionType());
+
+        Player * playerOut = nullptr;
+        for (auto player: team->squad())
+            if (player->isOnPitch() && this->_timeOnPitch[loc].value(player).first == 0 &&
+                playerPosition_index.findPositionBaseTypeByType(player->position()->positionType()) == baseType &&
+                (playerOut == nullptr || player->condition(player::Conditions::FATIGUE) <
+                 playerOut->condition(player::Conditions::FATIGUE)))
+                playerOut = player;
+
+        if (playerOut == nullptr)
+            continue;
+
+        // the same as in GamePlay::switchPlayers
+        playerIn->introducePlayer(playerOut->noOnPitch());
+        playerIn->position()->assignNewPlayerPosition(playerOut->position()->playerPosition());
+        this->_match->addNewStatsRecordForPlayer(loc, playerIn);
+        playerOut->transferPreferences(playerIn, player::PreferredForAction::KICK_OFF, player::PreferredForAction::CONVERSION);
+
+        this->updateStatistics(loc, StatsType::NumberOf::GAMES_PLAYED, playerIn);
+        this->updateStatistics(loc, StatsType::NumberOf::GAMES_PLAYED_SUB, playerIn);
+
+        playerOut->withdrawPlayer();
+        this->_match->addSubstitution(playerOut, playerIn, loc);
+
+        this->_timeOnPitch[loc][playerOut].second = this->_second;
+        this->_timeOnPitch[loc].insert(playerIn, qMakePair<uint16_t, uint16_t>(this->_second, UINT16_MAX));
+        ++substitutionsMade;
+    }
+
+    if (substitutionsMade > 0) {
+
+        team->lineupChanged();
+        this->_lineups[loc][1] = this->lineup(loc);
+    }
+
+    return;
+}
+
+void QuickSim::applyEvent(const Event & event) {
+
+    Lineup & lineup = this->lineupAt(event.team, event.second);
+    MatchScore * const score = this->_match->score(event.team);
+
+    switch (event.type) {
+
+        case MatchEvent::Type::TRY: {
+
+            Player * const scorer = lineup.tryScorers.sample(this->_random);
+            score->tryScored();
+            scorer->points()->tryScored();
+            this->_match->playerPoints(event.team, scorer)->tryScored();
+            this->recordEvent(MatchEvent::Type::TRY, event.team, scorer);
+
+            for (auto player: lineup.players)
+                this->changeInMorale(player, true);
+
+            // conversion (kicker's skill is taken into account the same way as in GamePlay::kickAtGoalProbability)
+            const double playerSkillProbability =
+                0.8 + (lineup.kicker->attribute(player::Attributes::KICKING) / static_cast<double>(50));
+
+            if (this->chance(this->_model.conversionRate * playerSkillProbability)) {
+
+                score->conversionScored();
+                lineup.kicker->points()->conversionScored();
+                this->_match->playerPoints(event.team, lineup.kicker)->conversionScored();
+                this->recordEvent(MatchEvent::Type::CONVERSION, event.team, lineup.kicker);
+                this->changeInMorale(lineup.kicker, true);
+            }
+            break;
+        }
+        case MatchEvent::Type::PENALTY_GOAL:
+            score->penaltiesScored();
+            lineup.kicker->points()->penaltyScored();
+            this->_match->playerPoints(event.team, lineup.kicker)->penaltyScored();
+            this->recordEvent(MatchEvent::Type::PENALTY_GOAL, event.team, lineup.kicker);
+            this->changeInMorale(lineup.kicker, true);
+            break;
+        case MatchEvent::Type::DROP_GOAL: {
+
+            Player * const scorer = lineup.tryScorers.sample(this->_random);
+            score->dropScored();
+            scorer->points()->dropGoalScored();
+            this->_match->playerPoints(event.team, scorer)->dropGoalScored();
+            this->recordEvent(MatchEvent::Type::DROP_GOAL, event.team, scorer);
+            this->changeInMorale(scorer, true);
+            break;
+        }
+        // cards are recorded only (player isn't withdrawn from play)
+        case MatchEvent::Type::YELLOW_CARD: {
+
+            Player * const player = lineup.tacklers.sample(this->_random);
+            score->yellowCards();
+            this->recordEvent(MatchEvent::Type::YELLOW_CARD, event.team, player);
+            this->updateStatistics(event.team, StatsType::NumberOf::YELLOW_CARDS, player);
+            break;
+        }
+        case MatchEvent::Type::RED_CARD: {
+
+            Player * const player = lineup.tacklers.sample(this->_random);
+            score->redCards();
+            this->recordEvent(MatchEvent::Type::RED_CARD, event.team, player);
+            this->updateStatistics(event.team, StatsType::NumberOf::RED_CARDS, player);
+            break;
+        }
+        default: ;
+    }
+
+    return;
+}
+
+// team statistics (and players' statistics they consist of) are spread over players who were on pitch at random time
+void QuickSim::teamStatistics(const MatchType::Location loc) {
+
+    const MatchType::Location opponent = (loc == MatchType::Location::HOSTS)
+        ? MatchType::Location::VISITORS : MatchType::Location::HOSTS;
+    MatchScore * const score = this->_match->score(loc);
+
+    const double share = this->possessionShare(loc);
+    const double attack = share * 2;          // 1.0 = even match
+    const double defence = (1.0 - share) * 2;
+
+    auto randomLineup = [this, loc]() -> Lineup & {
+
+        return this->lineupAt(loc, this->_random.generateRandomInt<uint16_t>(0, this->_second-1));
+    };
+    auto randomPlayer = [this](const Lineup & lineup) -> Player * {
+
+        return lineup.players.at(this->_random.generateRandomInt<int>(0, lineup.players.size()-1));
+    };
+
+    // passes (team in possession)
+    for (uint32_t i = this->poisson(this->_model.passes * attack); i > 0; --i) {
+
+        Player * const player = randomPlayer(randomLineup());
+        const MatchScore::Passes pass = static_cast<MatchScore::Passes>(this->chance(this->_model.passesCompletedRate));
+
+        score->passAttempted(pass);
+        this->recordEvent(MatchEvent::Type::PASS, loc, nullptr, 0, static_cast<uint8_t>(pass));
+        this->updateStatistics(loc, StatsType::NumberOf::PASSES_MADE, player);
+        if (pass == MatchScore::Passes::COMPLETED)
+            this->updateStatistics(loc, StatsType::NumberOf::PASSES_COMPLETED, player);
+    }
+
+    // carries and metres made by running
+    const uint32_t carries = this->poisson(this->_model.carries * attack);
+    for (uint32_t i = 0; i < carries; ++i) {
+
+        Player * const player = randomLineup().ballCarriers.sample(this->_random);
+        const uint8_t metresMade = static_cast<uint8_t>(std::min<uint32_t>(
+            this->poisson(this->_model.metresRun / this->_model.carries), UINT8_MAX));
+
+        score->carries();
+        this->recordEvent(MatchEvent::Type::CARRY, loc);
+        this->updateStatistics(loc, StatsType::NumberOf::CARRIES, player);
+
+        player->stats()->addMetresRun(metresMade);
+        score->run(metresMade);
+        this->recordEvent(MatchEvent::Type::RUN, loc, player, metresMade);
+    }
+
+    // metres made by kicking
+    for (uint32_t i = this->poisson(this->_model.metresKicked / this->_model.metresPerKick); i > 0; --i) {
+
+        Player * const player = randomLineup().kicker;
+        const uint8_t metresMade = static_cast<uint8_t>(std::min<uint32_t>(this->poisson(this->_model.metresPerKick), UINT8_MAX));
+
+        player->stats()->addMetresKicked(metresMade);
+        score->kick(metresMade);
+        this->recordEvent(MatchEvent::Type::KICK, loc, player, metresMade);
+    }
+
+    // tackles (team not in possession); tackled player is one of opponent's ball carriers
+    for (uint32_t i = this->poisson(this->_model.tackles * defence); i > 0; --i) {
+
+        const uint16_t second = this->_random.generateRandomInt<uint16_t>(0, this->_second-1);
+        Player * const tacklingPlayer = this->lineupAt(loc, second).tacklers.sample(this->_random);
+        Player * const tackledPlayer = this->lineupAt(opponent, second).ballCarriers.sample(this->_random);
+        const MatchScore::Tackles tackle = static_cast<MatchScore::Tackles>(this->chance(this->_model.tacklesCompletedRate));
+
+        score->tackleAttempted(tackle);
+        this->recordEvent(MatchEvent::Type::TACKLE, loc, nullptr, 0, static_cast<uint8_t>(tackle));
+        this->updateStatistics(opponent, StatsType::NumberOf::TACKLES_RECEIVED, tackledPlayer);
+        this->updateStatistics(loc, StatsType::NumberOf::TACKLES_MADE, tacklingPlayer);
+        if (tackle == MatchScore::Tackles::COMPLETED)
+            this->updateStatistics(loc, StatsType::NumberOf::TACKLES_COMPLETED, tacklingPlayer);
+    }
+
+    // lineouts thrown in by team
+    for (uint32_t i = this->poisson(this->_model.lineouts); i > 0; --i) {
+
+        const MatchScore::Lineouts lineout = static_cast<MatchScore::Lineouts>(this->chance(this->_model.lineoutsWonRate));
+        score->lineoutThrown(lineout);
+        this->recordEvent(MatchEvent::Type::LINEOUT, loc, nullptr, 0, static_cast<uint8_t>(lineout));
+    }
+
+    // scrums fed by team (recorded for both teams as in GamePlay::scrum)
+    for (uint32_t i = this->poisson(this->_model.scrums); i > 0; --i) {
+
+        const bool won = this->chance(this->_model.scrumsWonRate);
+        const MatchScore::Scrums scrum = (won) ? MatchScore::Scrums::WON : MatchScore::Scrums::LOST;
+        const MatchScore::Scrums opponentsScrum = (won) ? MatchScore::Scrums::LOST : MatchScore::Scrums::WON;
+
+        score->scrumThrown(scrum);
+        this->recordEvent(MatchEvent::Type::SCRUM, loc, nullptr, 0, static_cast<uint8_t>(scrum));
+        this->_match->score(opponent)->scrumThrown(opponentsScrum);
+        this->recordEvent(MatchEvent::Type::SCRUM, opponent, nullptr, 0, static_cast<uint8_t>(opponentsScrum));
+    }
+
+    for (uint32_t i = this->poisson(this->_model.handlingErrors); i > 0; --i) {
+
+        score->handlingErrors();
+        this->recordEvent(MatchEvent::Type::HANDLING_ERROR, loc);
+        this->updateStatistics(loc, StatsType::NumberOf::HANDLING_ERRORS, randomPlayer(randomLineup()));
+    }
+
+    for (uint32_t i = this->poisson(this->_model.offloads * attack); i > 0; --i) {
+
+        score->offloads();
+        this->recordEvent(MatchEvent::Type::OFFLOAD, loc);
+        this->updateStatistics(loc, StatsType::NumberOf::OFFLOADS, randomLineup().ballCarriers.sample(this->_random));
+    }
+
+    for (uint32_t i = this->poisson(this->_model.penaltyInfringements * defence); i > 0; --i) {
+
+        score->penaltyInfringements();
+        this->recordEvent(MatchEvent::Type::PENALTY_INFRINGEMENT, loc);
+        this->updateStatistics(loc, StatsType::NumberOf::PENALTIES_CAUSED, randomLineup().tacklers.sample(this->_random));
+    }
+
+    // possession and territory (time of both is added at once)
+    score->possession(static_cast<uint16_t>(std::round(this->_second * share)));
+    score->territory(static_cast<uint16_t>(std::round(this->_second * share)));
+
+    return;
+}
+
+// minutes played and fatigue (decreased once per every 10 minutes played as in GamePlay::changeInFatigue,
+// but player at minimum level of fatigue isn't declared injured)
+void QuickSim::minutesPlayed(const MatchType::Location loc) {
+
+    for (auto it = this->_timeOnPitch[loc].cbegin(); it != this->_timeOnPitch[loc].cend(); ++it) {
+
+        Player * const player = it.key();
+        const uint16_t secondsOnPitch = std::min(it.value().second, this->_second) - it.value().first;
+        const uint8_t minutes = static_cast<uint8_t>(std::round(secondsOnPitch / 60.0));
+
+        player->stats()->addMinutesPlayed(minutes);
+        this->_match->playerStats(loc, player)->addMinutesPlayed(minutes);
+
+        for (uint8_t i = 0; i < minutes / 10; ++i) {
+
+            const uint8_t probabilityOfDecrease = 72 - player->attribute(player::Attributes::ENDURANCE) * 2;
+            if (player->condition(player::Conditions::FATIGUE) > PlayerCondition::minValue &&
+                this->_random.generateRandomBool(probabilityOfDecrease))
+                player->condition()->decreaseCondition(player::Conditions::FATIGUE, 1);
+        }
+    }
+
+    return;
+}
+
+// the same as in GamePlay::kickingCompetition
+void QuickSim::kickingCompetition() {
+
+    const uint8_t & noOfPlayers = numberOfPlayers.NoOfPlayersForKickingCompetition;
+    uint8_t maxNumberOfGoals = noOfPlayers;
+    std::array<uint8_t, 2> goalsInShootOut = {0,0};
+
+    for (uint8_t team = 0; team < 2; ++team) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(team);
+        QVector<uint8_t> bestKicking;
+
+        for (auto player: this->_match->team(loc)->squad())
+            if (player->isOnPitch())
+                bestKicking.append(player->attribute(player::Attributes::KICKING));
+        std::sort(bestKicking.begin(), bestKicking.end());
+
+        const int bestKickingSize =  std::min(static_cast<int>(noOfPlayers), bestKicking.size());
+        const uint8_t sumKicking = std::accumulate(bestKicking.crbegin(), bestKicking.crbegin() + bestKickingSize, 0);
+        maxNumberOfGoals = static_cast<uint8_t>((sumKicking + 9.9) / 10);
+        goalsInShootOut[team] = this->_random.generateRandomInt<uint8_t>(0, maxNumberOfGoals);
+    }
+
+    while (goalsInShootOut.at(0) == goalsInShootOut.at(1))
+        goalsInShootOut[1] = this->_random.generateRandomInt<uint8_t>(0, maxNumberOfGoals);
+
+    this->_match->score(MatchType::Location::HOSTS)->shootOutGoalsScored(goalsInShootOut.at(0));
+    this->_match->score(MatchType::Location::VISITORS)->shootOutGoalsScored(goalsInShootOut.at(1));
+    this->recordEvent(MatchEvent::Type::SHOOT_OUT, MatchType::Location::HOSTS, nullptr, goalsInShootOut.at(0));
+    this->recordEvent(MatchEvent::Type::SHOOT_OUT, MatchType::Location::VISITORS, nullptr, goalsInShootOut.at(1));
+
+    this->_match->timePlayed().addTime(this->_periods.length(this->_match->currentPeriod(), 60));
+
+    return;
+}
+
+// the same as in GamePlay::endOfMatch
+void QuickSim::endOfMatch() {
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const MatchType::Location loc = static_cast<MatchType::Location>(i);
+
+        // values accumulated during whole match are recorded only once (as totals)
+        for (auto player: this->_match->team(loc)->squad())
+            if (this->_match->playerStats(loc, player) != nullptr)
+                this->recordEvent(MatchEvent::Type::MINUTES_PLAYED, loc, player,
+                                  this->_match->playerStats(loc, player)->getStatsValue(StatsType::NumberOf::MINS_PLAYED));
+        this->recordEvent(MatchEvent::Type::POSSESSION, loc, nullptr, this->_match->score(loc)->possession());
+        this->recordEvent(MatchEvent::Type::TERRITORY, loc, nullptr, this->_match->score(loc)->territory());
+
+        this->_match->team(loc)->cleanPitch();
+
+        if (this->_match->type() == MatchType::Type::REGULAR) {
+
+            // update teams' results (win/draw/loss)
+            const bool tryBonusPoint = this->_match->score(loc)->bonusPointTry();
+            const bool diffBonusPoint = this->_match->diffBonusPoint(loc);
+            const TeamResults::ResultType resultType = this->_match->resultTypeForTeam(loc);
+
+            this->_match->team(loc)->results().updateResults(resultType, tryBonusPoint, diffBonusPoint);
+
+            // update teams' points (tries, conversions, ...)
+            const uint16_t pointsAgainst = (loc == MatchType::Location::HOSTS)
+                ? this->_match->score(MatchType::Location::VISITORS)->points()
+                : this->_match->score(MatchType::Location::HOSTS)->points();
+            const uint8_t triesAgainst = (loc == MatchType::Location::HOSTS)
+                ? this->_match->score(MatchType::Location::VISITORS)->points(PointEvent::TRY)
+                : this->_match->score(MatchType::Location::HOSTS)->points(PointEvent::TRY);
+
+            this->_match->team(loc)->scoredPoints().updateFromMatchScore(this->_match->score(loc), pointsAgainst, triesAgainst);
+        }
+    }
+
+    this->_match->matchFinished();
+    return;
+}
+
+// the same as in GamePlay::changeInMorale
+void QuickSim::changeInMorale(Player * const player, const bool increase) {
+
+    if (this->_random.generateRandomBool(25)) {
+
+        PlayerCondition * const pc = player->condition();
+        pc->changeCondition = (increase) ? &PlayerCondition::increaseCondition : &PlayerCondition::decreaseCondition;
+
+        (pc->*(pc->changeCondition))(player::Conditions::MORALE, 1);
+    }
+
+    return;
+}
+
+void QuickSim::updateStatistics(const MatchType::Location loc, const StatsType::NumberOf stats, Player * const player) {
+
+    player->stats()->incrementStatsValue(stats);
+    this->_match->playerStats(loc, player)->incrementStatsValue(stats);
+    this->recordEvent(MatchEvent::Type::PLAYER_STATS, loc, player, 0, static_cast<uint8_t>(stats));
+
+    return;
+}
+
+void QuickSim::recordEvent(const MatchEvent::Type type, const MatchType::Location team, Player * const player,
+                           const uint16_t value, const uint8_t outcome) const {
+
+    this->_match->events().record(this->_match->timePlayedInSeconds(), type, static_cast<uint8_t>(team),
+                                  (player != nullptr) ? player->code() : 0, value, outcome);
+    return;
+}
+
+// regular time is played at once (no extra-time); drawn play-off match is decided by kicking competition
+void QuickSim::playMatch() {
+
+    if (this->_match->currentPeriod() != MatchPeriod::TimePeriod::WARM_UP)
+        return;
+
+    this->startOfMatch();
+
+    QVector<Event> events;
+    this->drawEvents(events);
+    QVector<Event>::const_iterator event = events.cbegin();
+
+    const uint16_t halfTime = this->_periods.length(MatchPeriod::TimePeriod::FIRST_HALF_TIME, 60);
+    const uint16_t regularTime = halfTime + this->_periods.length(MatchPeriod::TimePeriod::SECOND_HALF_TIME, 60);
+
+    // first half-time
+    this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::FIRST_HALF_TIME);
+    this->playUntil(halfTime, event, events.cend());
+    this->_dateTime.refreshSystemDateAndTime(this->_match->timePlayed().timePlayedInPeriod(this->_match->currentPeriod()));
+
+    // half-time interval (the same as in GamePlay::step)
+    this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::HALF_TIME_INTERVAL);
+    const uint16_t intervalLength = this->_periods.length(MatchPeriod::TimePeriod::HALF_TIME_INTERVAL, 60);
+    this->_match->timePlayed().setTimeForInterval(intervalLength);
+    this->_dateTime.refreshSystemDateAndTime(intervalLength, 60);
+    this->_match->timePlayed().resetTime(this->_periods.timePlayed(MatchPeriod::TimePeriod::HALF_TIME_INTERVAL));
+
+    // second half-time
+    this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::SECOND_HALF_TIME);
+    this->playUntil(regularTime, event, events.cend());
+    this->_dateTime.refreshSystemDateAndTime(this->_match->timePlayed().timePlayedInPeriod(this->_match->currentPeriod()));
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        this->teamStatistics(static_cast<MatchType::Location>(i));
+        this->minutesPlayed(static_cast<MatchType::Location>(i));
+    }
+
+    if (this->_match->type() == MatchType::Type::PLAYOFFS &&
+        this->_match->resultTypeForTeam(MatchType::Location::HOSTS) == TeamResults::ResultType::DRAW) {
+
+        this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::KICKING_COMPETITION);
+        this->kickingCompetition();
+        this->_dateTime.refreshSystemDateAndTime(this->_periods.length(this->_match->currentPeriod(), 60));
+    }
+
+    this->_match->timePlayed().switchTimePeriodTo(MatchPeriod::TimePeriod::FULL_TIME);
+    this->endOfMatch();
+
+    return;
+}
@@ -0,0 +1,275 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QDateTime>
+#include <QStringBuilder>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "match/gameplay.h"
+#include "match/match_events.h"
+#include "match/quick_sim_calibration.h"
+#include "settings/matchsettings.h"
+
+QuickSimCalibration::QuickSimCalibration(Settings * const settings, const DateTime & dateTime,
+                                         const QVector<QPair<Team *, Team *>> & pairings):
+    _settings(settings), _dateTime(dateTime), _pairings(pairings) {}
+
+QVector<QPair<Team *, Team *>> QuickSimCalibration::pairings(const QVector<Match *> * const fixtures) {
+
+    QVector<QPair<Team *, Team *>> pairings;
+
+    for (auto match: *fixtures) {
+
+        if (match->type() != MatchType::Type::REGULAR)
+            continue;
+
+        const QPair<Team *, Team *> pairing =
+            qMakePair(match->team(MatchType::Location::HOSTS), match->team(MatchType::Location::VISITORS));
+        if (pairing.first != nullptr && pairing.second != nullptr && !pairings.contains(pairing))
+            pairings.push_back(pairing);
+    }
+
+    return pairings;
+}
+
+// difference between rankings from hosts' point of view (capped the same way as in QuickSim::expectedTries)
+int16_t QuickSimCalibration::rankingDiff(const int pairing) const {
+
+    const int16_t rankingDiff = static_cast<int16_t>(_pairings.at(pairing).second->ranking()) -
+                                static_cast<int16_t>(_pairings.at(pairing).first->ranking());
+
+    return std::min<int16_t>(std::max<int16_t>(rankingDiff, -20), 20);
+}
+
+QuickSimCalibration::Stats QuickSimCalibration::stats(Match * const match, const MatchType::Location loc) const {
+
+    const MatchScore * const score = match->score(loc);
+    Stats stats = {};
+
+    stats[TRIES] = score->points(PointEvent::TRY);
+    stats[CONVERSIONS] = score->points(PointEvent::CONVERSION);
+    stats[PENALTY_GOALS] = score->points(PointEvent::PENALTY);
+    stats[DROP_GOALS] = score->points(PointEvent::DROPGOAL);
+    stats[YELLOW_CARDS] = score->stats<uint8_t>(StatsType::NumberOf::YELLOW_CARDS);
+    stats[RED_CARDS] = score->stats<uint8_t>(StatsType::NumberOf::RED_CARDS);
+    stats[PASSES] = score->passes(MatchScore::Passes::ATTEMPTED);
+    stats[PASSES_COMPLETED] = score->passes(MatchScore::Passes::COMPLETED);
+    stats[TACKLES] = score->tackles(MatchScore::Tackles::ATTEMPTED);
+    stats[TACKLES_COMPLETED] = score->tackles(MatchScore::Tackles::COMPLETED);
+    stats[CARRIES] = score->stats<uint16_t>(StatsType::NumberOf::CARRIES);
+    stats[METRES_RUN] = score->stats<uint16_t>(StatsType::NumberOf::METRES_RUN);
+    stats[METRES_KICKED] = score->stats<uint16_t>(StatsType::NumberOf::METRES_KICKED);
+    stats[LINEOUTS] = score->lineouts(MatchScore::Lineouts::THROWN);
+    stats[LINEOUTS_WON] = score->lineouts(MatchScore::Lineouts::WON);
+    stats[HANDLING_ERRORS] = score->stats<uint8_t>(StatsType::NumberOf::HANDLING_ERRORS);
+    stats[OFFLOADS] = score->stats<uint8_t>(StatsType::NumberOf::OFFLOADS);
+    stats[PENALTY_INFRINGEMENTS] = score->stats<uint8_t>(StatsType::NumberOf::PENALTIES_CAUSED);
+
+    // match score doesn't tell which team fed a scrum and how many kicks were made => event log is used instead
+    // (GamePlay::scrum records result of team which fed the scrum first and result of its opponent right after it)
+    bool feedingTeam = true;
+    for (const auto & record: match->events().records()) {
+
+        if (record.type == MatchEvent::Type::KICK && record.team == static_cast<uint8_t>(loc))
+            ++stats[KICKS];
+
+        if (record.type != MatchEvent::Type::SCRUM)
+            continue;
+
+        if (feedingTeam && record.team == static_cast<uint8_t>(loc)) {
+
+            ++stats[SCRUMS];
+            if (static_cast<MatchScore::Scrums>(record.outcome) == MatchScore::Scrums::WON)
+                ++stats[SCRUMS_WON];
+        }
+        feedingTeam = !feedingTeam;
+    }
+
+    // kicker is selected the same way as in QuickSim::lineup (from players who have played the match)
+    Player * kicker = nullptr;
+    Player * bestKicker = nullptr;
+    for (auto player: match->team(loc)->squad()) {
+
+        const PlayerStats * const playerStats = match->playerStats(loc, player);
+        if (playerStats == nullptr)
+            continue;
+
+        if (playerStats->getStatsValue(StatsType::NumberOf::GAMES_PLAYED_SUB) > 0) {
+
+            ++stats[SUBSTITUTIONS];
+            continue;
+        }
+
+        if (kicker == nullptr && player->isPreferredFor(player::PreferredForAction::CONVERSION))
+            kicker = player;
+        if (bestKicker == nullptr ||
+            player->attribute(player::Attributes::KICKING) > bestKicker->attribute(player::Attributes::KICKING))
+            bestKicker = player;
+    }
+    if (kicker == nullptr)
+        kicker = bestKicker;
+    if (kicker != nullptr)
+        stats[KICKER_SKILL] = 0.8 + (kicker->attribute(player::Attributes::KICKING) / static_cast<double>(50));
+
+    return stats;
+}
+
+// every run plays with its own copies of both teams (and of system date/time) => runs don't affect session
+// nor each other; match's code (= seed of its random stream) is derived from number of run and so is the stream used
+// for selection of players (shared generator mustn't be used from worker threads)
+QuickSimCalibration::Run QuickSimCalibration::play(const uint32_t run) const {
+
+    Run result;
+    result.pairing = static_cast<uint16_t>(run % _pairings.size());
+    result.played = false;
+
+    Team * const hosts = _pairings.at(result.pairing).first->clone();
+    Team * const visitors = _pairings.at(result.pairing).second->clone();
+
+    RandomStream selection = RandomStream::forCode(selectionCodeOffset + run);
+    if (hosts->selectPlayersForNextMatch(_settings->playerConditions(), &selection) &&
+        visitors->selectPlayersForNextMatch(_settings->playerConditions(), &selection)) {
+
+        hosts->selectSubstitutes(_settings->playerConditions());
+        visitors->selectSubstitutes(_settings->playerConditions());
+
+        DateTime dateTime = _dateTime;
+        Match match(codeOffset + run, QDateTime(dateTime.systemDate(), dateTime.systemTime()), hosts, visitors,
+                    MatchType::Type::REGULAR, nullptr, hosts->venue(), false, false);
+
+        GamePlay play(_settings, dateTime, &match, nullptr, nullptr);
+        play.playMatch();
+
+        result.stats[0] = this->stats(&match, MatchType::Location::HOSTS);
+        result.stats[1] = this->stats(&match, MatchType::Location::VISITORS);
+        result.played = true;
+    }
+
+    for (auto team: { hosts, visitors }) {
+
+        for (auto player: team->squad())
+            delete player;
+        delete team;
+    }
+
+    return result;
+}
+
+void QuickSimCalibration::add(Summary & summary, const Run & run) {
+
+    if (!run.played)
+        return;
+
+    if (summary.tries.size() <= run.pairing) {
+
+        summary.tries.resize(run.pairing + 1);
+        summary.runs.resize(run.pairing + 1);
+    }
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        for (uint8_t j = 0; j < Stat::NO_OF_STATS; ++j)
+            summary.totals[j] += run.stats[i].at(j);
+        summary.tries[run.pairing][i] += run.stats[i].at(TRIES);
+    }
+    ++summary.runs[run.pairing];
+    summary.teamMatches += 2;
+
+    return;
+}
+
+// counts are averages per team and match, rates are ratios of totals; tries, home advantage and ranking weight are
+// fitted from average tries of every pairing: ln(hosts' tries) - ln(visitors' tries) = ln(home advantage) +
+// 2 * ranking weight * ranking difference (least squares) and ln(hosts' tries) + ln(visitors' tries) =
+// 2 * ln(tries) + ln(home advantage); parameters which can't be fitted (e.g. division by zero) keep their values
+QuickSim::Model QuickSimCalibration::fit(const Summary & summary) const {
+
+    QuickSim::Model model;
+    if (summary.teamMatches == 0)
+        return model;
+
+    const Stats & totals = summary.totals;
+    auto average = [&summary, &totals](const Stat stat) { return (totals.at(stat) / summary.teamMatches); };
+    auto ratio = [&totals](const Stat stat, const Stat base, const double value) {
+        return (totals.at(base) > 0.0) ? (totals.at(stat) / totals.at(base)) : value; };
+
+    // tries
+    QVector<double> rankingDiffs, differences, sums;
+    for (int i = 0; i < summary.runs.size(); ++i) {
+
+        if (summary.runs.at(i) == 0 || !(summary.tries.at(i).at(0) > 0.0) || !(summary.tries.at(i).at(1) > 0.0))
+            continue;
+
+        const double hostsTries = std::log(summary.tries.at(i).at(0) / summary.runs.at(i));
+        const double visitorsTries = std::log(summary.tries.at(i).at(1) / summary.runs.at(i));
+
+        rankingDiffs.push_back(this->rankingDiff(i));
+        differences.push_back(hostsTries - visitorsTries);
+        sums.push_back(hostsTries + visitorsTries);
+    }
+
+    if (!rankingDiffs.isEmpty()) {
+
+        const double n = rankingDiffs.size();
+        const double meanDiff = std::accumulate(rankingDiffs.cbegin(), rankingDiffs.cend(), 0.0) / n;
+        const double meanDifference = std::accumulate(differences.cbegin(), differences.cend(), 0.0) / n;
+        const double meanSum = std::accumulate(sums.cbegin(), sums.cend(), 0.0) / n;
+
+        double covariance = 0.0, variance = 0.0;
+        for (int i = 0; i < rankingDiffs.size(); ++i) {
+
+            covariance += (rankingDiffs.at(i) - meanDiff) * (differences.at(i) - meanDifference);
+            variance += (rankingDiffs.at(i) - meanDiff) * (rankingDiffs.at(i) - meanDiff);
+        }
+
+        // all pairings have the same ranking difference => ranking weight can't be fitted
+        if (variance > 0.0)
+            model.rankingWeight = covariance / variance / 2;
+
+        const double logHomeAdvantage = meanDifference - 2 * model.rankingWeight * meanDiff;
+        model.homeAdvantage = std::exp(logHomeAdvantage);
+        model.tries = std::exp((meanSum - logHomeAdvantage) / 2);
+    }
+
+    model.penaltyGoals = average(PENALTY_GOALS);
+    model.dropGoals = average(DROP_GOALS);
+    if (totals.at(KICKER_SKILL) > 0.0)
+        model.conversionRate = ratio(CONVERSIONS, TRIES, model.conversionRate) / average(KICKER_SKILL);
+    model.yellowCards = average(YELLOW_CARDS);
+    model.redCards = average(RED_CARDS);
+
+    model.passes = average(PASSES);
+    model.passesCompletedRate = ratio(PASSES_COMPLETED, PASSES, model.passesCompletedRate);
+    model.tackles = average(TACKLES);
+    model.tacklesCompletedRate = ratio(TACKLES_COMPLETED, TACKLES, model.tacklesCompletedRate);
+    model.carries = average(CARRIES);
+    model.metresRun = average(METRES_RUN);
+    model.metresKicked = average(METRES_KICKED);
+    model.metresPerKick = ratio(METRES_KICKED, KICKS, model.metresPerKick);
+
+    model.lineouts = average(LINEOUTS);
+    model.lineoutsWonRate = ratio(LINEOUTS_WON, LINEOUTS, model.lineoutsWonRate);
+    model.scrums = average(SCRUMS);
+    model.scrumsWonRate = ratio(SCRUMS_WON, SCRUMS, model.scrumsWonRate);
+
+    model.handlingErrors = average(HANDLING_ERRORS);
+    model.offloads = average(OFFLOADS);
+    model.penaltyInfringements = average(PENALTY_INFRINGEMENTS);
+    model.substitutions = average(SUBSTITUTIONS);
+
+    return model;
+}
+
+QString QuickSimCalibration::modelAsHtml(const QuickSim::Model & model, const uint32_t matches) {
+
+    QString html = QStringLiteral("Model fitted from ") % QString::number(matches) % QStringLiteral(" matches:<br><br><table>");
+
+    for (const auto & parameter: QuickSim::parameters)
+        html += QStringLiteral("<tr><td>") % parameter.first % QStringLiteral("</td><td align=\"right\">") %
+                QString::number(model.*(parameter.second), 'f', 3) % QStringLiteral("</td></tr>");
+
+    return (html + QStringLiteral("</table>"));
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <algorithm>
+#include "shared/refresh_coordinator.h"
+
+RefreshCoordinator::RefreshCoordinator(QObject * const parent, const uint8_t framesPerSecond):
+    QObject(parent), _frameTimer(new QTimer(this)) {
+
+    this->_frameTimer->setSingleShot(true);
+    this->_frameTimer->setInterval(1000 / std::max<uint8_t>(framesPerSecond, 1));
+    connect(this->_frameTimer, &QTimer::timeout, this, &RefreshCoordinator::flush);
+}
+
+// first change within a frame starts the frame (timer isn't running while there's nothing to be applied)
+void RefreshCoordinator::startFrame() {
+
+    if (!this->_frameTimer->isActive())
+        this->_frameTimer->start();
+
+    return;
+}
+
+void RefreshCoordinator::schedule(const void * const target, const std::function<void()> & update) {
+
+    this->_updates.insert(target, update);
+    this->startFrame();
+
+    return;
+}
+
+void RefreshCoordinator::append(QTextEdit * const log, const QString & line) {
+
+    this->_lines[log].append(line);
+    this->startFrame();
+
+    return;
+}
+
+// [slot]
+void RefreshCoordinator::flush() {
+
+    this->_frameTimer->stop();
+
+    // pending changes are taken over first (an update may cause another change to be scheduled)
+    const QHash<const void *, std::function<void()>> updates = std::move(this->_updates);
+    const QHash<QTextEdit *, QStringList> lines = std::move(this->_lines);
+    this->_updates.clear();
+    this->_lines.clear();
+
+    for (const auto & update: updates)
+        update();
+
+    for (auto it = lines.cbegin(); it != lines.cend(); ++it)
+        for (const auto & line: it.value())
+            it.key()->append(line);
+
+    return;
+}
@@ -0,0 +1,333 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#include <QMap>
+#include <QStringBuilder>
+#include <algorithm>
+#include <cmath>
+#include "match/playoff_rules.h"
+#include "match/playoffs.h"
+#include "match/season_forecast.h"
+#include "settings/matchsettings.h"
+#include "shared/sort.h"
+
+// model's average number of tries is used until team plays its first match
+SeasonForecast::SeasonForecast(const QVector<Team *> & teams, const QVector<Match *> * const fixtures, const uint64_t seed,
+                               const QuickSim::Model & model): _teams(teams), _seed(seed), _model(model) {
+
+    _standings.reserve(teams.size());
+
+    for (auto team: teams) {
+
+        const uint8_t matchesPlayed = team->results().matchesPlayed();
+
+        _groups.push_back(team->group());
+        _rankings.push_back(team->ranking());
+        _standings.push_back(*team);
+        _attack.push_back((matchesPlayed == 0) ? _model.tries
+                                               : static_cast<double>(team->scoredPoints().tries()) / matchesPlayed);
+        _defence.push_back((matchesPlayed == 0) ? _model.tries
+                                                : static_cast<double>(team->scoredPoints().triesConceded()) / matchesPlayed);
+    }
+
+    auto index = [this](Team * const team) -> int16_t { return (team == nullptr) ? -1 : this->_teams.indexOf(team); };
+
+    for (auto match: *fixtures) {
+
+        if (match->type() == MatchType::Type::REGULAR) {
+
+            if (!match->played())
+                _fixtures.push_back({ index(match->team(MatchType::Location::HOSTS)),
+                                      index(match->team(MatchType::Location::VISITORS)) });
+            continue;
+        }
+        if (match->type() != MatchType::Type::PLAYOFFS)
+            continue;
+
+        PlayoffsFixture playoffsMatch;
+        playoffsMatch.code = match->code();
+        playoffsMatch.type = match->playoffsType();
+        playoffsMatch.winner = (match->played()) ? index(match->winner(TeamResults::ResultType::WIN)) : -1;
+        playoffsMatch.loser = (match->played()) ? index(match->winner(TeamResults::ResultType::LOSS)) : -1;
+        playoffsMatch.isFinal = true;
+
+        for (uint8_t i = 0; i < 2; ++i) {
+
+            const MatchType::Location loc = static_cast<MatchType::Location>(i);
+            playoffsMatch.teams[i] = index(match->team(loc));
+
+            if (match->playoffsRule() == nullptr)
+                continue;
+
+            if (playoffsMatch.type == MatchType::ToPlayOff::FROM_REGULAR)
+                playoffsMatch.ranking[i] = reinterpret_cast<RegularToPlayoffsRule *>(match->playoffsRule())->ranking(loc);
+            if (playoffsMatch.type == MatchType::ToPlayOff::FROM_PLAYOFFS)
+                playoffsMatch.fromMatch[i] = reinterpret_cast<PlayoffsToPlayoffsRule *>(match->playoffsRule())->teamFromMatch(loc);
+        }
+        _playoffs.push_back(playoffsMatch);
+    }
+
+    // final = nobody advances from this match and both teams are winners of previous matches (<> match for 3rd place)
+    for (auto & match: _playoffs) {
+
+        for (const auto & nextMatch: _playoffs)
+            if (nextMatch.type == MatchType::ToPlayOff::FROM_PLAYOFFS &&
+                (nextMatch.fromMatch[0].first == match.code || nextMatch.fromMatch[1].first == match.code))
+                match.isFinal = false;
+
+        if (match.type == MatchType::ToPlayOff::FROM_PLAYOFFS && (!match.fromMatch[0].second || !match.fromMatch[1].second))
+            match.isFinal = false;
+    }
+}
+
+uint16_t SeasonForecast::Score::points() const {
+
+    return (this->tries * pointValue.Try + this->conversions * pointValue.Conversion +
+            this->penalties * pointValue.Penalty + this->dropGoals * pointValue.DropGoal);
+}
+
+// blend of current form (tries scored by team and conceded by opponent so far) and of difference in teams' rankings
+double SeasonForecast::expectedTries(const int16_t team, const int16_t opponent, const bool hosts) const {
+
+    const double form = (_attack.at(team) + _defence.at(opponent)) / 2;
+    const double rankingFactor =
+        std::exp(_model.rankingWeight * (static_cast<int16_t>(_rankings.at(opponent)) - static_cast<int16_t>(_rankings.at(team))));
+
+    return std::max(0.1, form * rankingFactor * ((hosts) ? _model.homeAdvantage : 1.0));
+}
+
+SeasonForecast::Score SeasonForecast::score(std::mt19937 & generator, const int16_t team, const int16_t opponent,
+                                            const bool hosts) const {
+
+    std::poisson_distribution<int> triesDistribution(this->expectedTries(team, opponent, hosts));
+    std::poisson_distribution<int> penaltiesDistribution(_model.penaltyGoals);
+    std::poisson_distribution<int> dropGoalsDistribution(_model.dropGoals);
+
+    Score score;
+    score.tries = static_cast<uint8_t>(triesDistribution(generator));
+    std::binomial_distribution<int> conversionsDistribution(score.tries, _model.conversionRate);
+    score.conversions = static_cast<uint8_t>(conversionsDistribution(generator));
+    score.penalties = static_cast<uint8_t>(penaltiesDistribution(generator));
+    score.dropGoals = static_cast<uint8_t>(dropGoalsDistribution(generator));
+
+    return score;
+}
+
+void SeasonForecast::playMatch(std::mt19937 & generator, std::vector<Team> & standings, const Fixture & fixture) const {
+
+    if (fixture.hosts == -1 || fixture.visitors == -1)
+        return;
+
+    const int16_t teams[2] = { fixture.hosts, fixture.visitors };
+    const Score scores[2] = { this->score(generator, fixture.hosts, fixture.visitors, true),
+                              this->score(generator, fixture.visitors, fixture.hosts, false) };
+
+    for (uint8_t i = 0; i < 2; ++i) {
+
+        const Score & score = scores[i];
+        const Score & opponentScore = scores[1-i];
+
+        TeamResults::ResultType result = TeamResults::ResultType::DRAW;
+        if (score.points() > opponentScore.points())
+            result = TeamResults::ResultType::WIN;
+        if (score.points() < opponentScore.points())
+            result = TeamResults::ResultType::LOSS;
+
+        const bool tryBonusPoint = (score.tries >= matchPoints.NoOfTriesForBonusPoint);
+        const bool diffBonusPoint = (result == TeamResults::ResultType::LOSS &&
+                                     opponentScore.points() - score.points() <= matchPoints.NoOfPointsForDiffPoint);
+
+        standings[teams[i]].results().updateResults(result, tryBonusPoint, diffBonusPoint);
+        standings[teams[i]].scoredPoints().addScore(score.tries, score.conversions, score.penalties, score.dropGoals,
+                                                    opponentScore.points(), opponentScore.tries);
+    }
+    return;
+}
+
+// play-offs' match can't end in a draw => if it does, shoot-out is a matter of luck
+bool SeasonForecast::hostsWin(std::mt19937 & generator, const int16_t hosts, const int16_t visitors) const {
+
+    const uint16_t hostsPoints = this->score(generator, hosts, visitors, true).points();
+    const uint16_t visitorsPoints = this->score(generator, visitors, hosts, false).points();
+
+    if (hostsPoints == visitorsPoints)
+        return std::bernoulli_distribution(0.5)(generator);
+
+    return (hostsPoints > visitorsPoints);
+}
+
+// every run has its own generator (seeded by forecast's seed and number of run) and its own copy of standings
+// => result of a run doesn't depend on other runs nor on thread it was played on; both halves of (64-bit) seed are used
+SeasonForecast::Run SeasonForecast::play(const uint32_t run) const {
+
+    std::seed_seq seed{ static_cast<uint32_t>(_seed), static_cast<uint32_t>(_seed >> 32), run };
+    std::mt19937 generator(seed);
+    std::vector<Team> standings = _standings;
+
+    for (const auto & fixture: _fixtures)
+        this->playMatch(generator, standings, fixture);
+
+    Run result;
+    result.positions.fill(0, _teams.size());
+    result.playoffs.fill(false, _teams.size());
+
+    QVector<Team *> copies;
+    for (auto & team: standings)
+        copies.push_back(&team);
+
+    auto index = [&standings](Team * const team) -> int16_t
+        { return (team == nullptr) ? -1 : static_cast<int16_t>(team - standings.data()); };
+
+    // final tables (ordered by the same rule as league table)
+    QMap<QString, QVector<Team *>> tables;
+    for (auto team: copies)
+        tables[team->group()].push_back(team);
+
+    for (auto & table: tables) {
+
+        std::sort(table.begin(), table.end(), sortTable);
+
+        for (uint8_t position = 0; position < table.size(); ++position)
+            result.positions[index(table.at(position))] = position;
+    }
+
+    // play-offs (teams are assigned by the same draw rules as in Playoffs::drawPlayoffs/assignTeamsForPlayoffsMatches)
+    QVector<int16_t> winners(_playoffs.size(), -1);
+    QVector<int16_t> losers(_playoffs.size(), -1);
+
+    for (int i = 0; i < _playoffs.size(); ++i) {
+
+        const PlayoffsFixture & match = _playoffs.at(i);
+        int16_t teams[2] = { match.teams[0], match.teams[1] };
+
+        for (uint8_t j = 0; j < 2; ++j) {
+
+            if (teams[j] != -1)
+                continue;
+
+            if (match.type == MatchType::ToPlayOff::FROM_REGULAR)
+                teams[j] = index(Playoffs::qualifiedTeam(match.ranking[j], copies, tables));
+
+            if (match.type == MatchType::ToPlayOff::FROM_PLAYOFFS) {
+
+                const QPair<uint32_t, TeamResults::ResultType> fromMatch = Playoffs::advancingTeam(match.fromMatch[j]);
+
+                for (int k = 0; k < i; ++k)
+                    if (_playoffs.at(k).code == fromMatch.first)
+                        teams[j] = (fromMatch.second == TeamResults::ResultType::WIN) ? winners.at(k) : losers.at(k);
+            }
+        }
+
+        if (match.type == MatchType::ToPlayOff::FROM_REGULAR)
+            for (uint8_t j = 0; j < 2; ++j)
+                if (teams[j] != -1)
+                    result.playoffs[teams[j]] = true;
+
+        if (match.winner != -1) {
+
+            winners[i] = match.winner;
+            losers[i] = match.loser;
+        }
+        else if (teams[0] != -1 && teams[1] != -1) {
+
+            const bool hostsWon = this->hostsWin(generator, teams[0], teams[1]);
+            winners[i] = teams[static_cast<uint8_t>(!hostsWon)];
+            losers[i] = teams[static_cast<uint8_t>(hostsWon)];
+        }
+
+        if (match.isFinal)
+            result.champion = winners.at(i);
+    }
+
+    // without play-offs competition is won by team on top of the table
+    if (_playoffs.isEmpty() && !copies.isEmpty())
+        result.champion = index(*std::min_element(copies.begin(), copies.end(), sortTable));
+
+    return result;
+}
+
+// reduce function for QtConcurrent::mappedReduced
+void SeasonForecast::add(Summary & summary, const Run & run) {
+
+    if (summary.runs == 0) {
+
+        summary.positions.resize(run.positions.size());
+        summary.playoffs.fill(0, run.positions.size());
+        summary.titles.fill(0, run.positions.size());
+    }
+
+    for (int team = 0; team < run.positions.size(); ++team) {
+
+        const uint8_t position = run.positions.at(team);
+        if (summary.positions[team].size() <= position)
+            summary.positions[team].resize(position + 1);
+
+        ++(summary.positions[team][position]);
+        summary.playoffs[team] += static_cast<uint32_t>(run.playoffs.at(team));
+    }
+    if (run.champion != -1)
+        ++(summary.titles[run.champion]);
+
+    ++(summary.runs);
+    return;
+}
+
+QString SeasonForecast::summaryAsHtml(const Summary & summary, Team * const myTeam) const {
+
+    if (summary.runs == 0)
+        return QString();
+
+    auto percentage = [&summary](const uint32_t count) -> QString
+        { return (count == 0) ? QStringLiteral("-") : QString::number(100.0 * count / summary.runs, 'f', 1); };
+
+    QMap<QString, QVector<uint16_t>> groups;
+    for (uint16_t i = 0; i < _teams.size(); ++i)
+        groups[_groups.at(i)].push_back(i);
+
+    QString html = QStringLiteral("<p>Number of simulated seasons: ") % QString::number(summary.runs) %
+                   QStringLiteral("</p><table cellspacing=\"0\" cellpadding=\"3\">");
+
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+
+        QVector<uint16_t> & group = it.value();
+
+        // teams in order of their average final position
+        auto averagePosition = [&summary](const uint16_t team) -> double {
+
+            double sum = 0;
+            for (int position = 0; position < summary.positions.at(team).size(); ++position)
+                sum += static_cast<double>(position) * summary.positions.at(team).at(position);
+            return (sum / summary.runs);
+        };
+        std::stable_sort(group.begin(), group.end(), [&averagePosition](const uint16_t team1, const uint16_t team2) -> bool
+            { return averagePosition(team1) < averagePosition(team2); });
+
+        const QString groupName = (it.key().isEmpty()) ? QStringLiteral("Team") : it.key();
+        html += QStringLiteral("<tr><th align=\"left\">") % groupName % QStringLiteral("</th>");
+        for (int position = 0; position < group.size(); ++position)
+            html += QStringLiteral("<th>") % QString::number(position + 1) % QStringLiteral(".</th>");
+        if (this->hasPlayoffs())
+            html += QStringLiteral("<th>Play-offs</th>");
+        html += QStringLiteral("<th>Title</th></tr>");
+
+        for (auto team: group) {
+
+            QString name = _teams.at(team)->name();
+            if (_teams.at(team) == myTeam)
+                name = QStringLiteral("<b>") % name % QStringLiteral("</b>");
+
+            html += QStringLiteral("<tr><td>") % name % QStringLiteral("</td>");
+            for (int position = 0; position < group.size(); ++position)
+                html += QStringLiteral("<td align=\"right\">") %
+                        percentage(summary.positions.at(team).value(position, 0)) % QStringLiteral("</td>");
+            if (this->hasPlayoffs())
+                html += QStringLiteral("<td align=\"right\">") % percentage(summary.playoffs.at(team)) % QStringLiteral("</td>");
+            html += QStringLiteral("<td align=\"right\">") % percentage(summary.titles.at(team)) % QStringLiteral("</td></tr>");
+        }
+    }
+    html += QStringLiteral("</table>");
+
+    return html;
+}
@@ -3,14 +3,19 @@
  This program is distributed under the terms of the GNU General Public License.
 *******************************************************************************/
 
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QFile>
 #include <QMessageBox>
 #include <QSqlRecord>
 #include <QSqlRelationalTableModel>
 #include <QStringList>
+#include <QtEndian>
 #include <algorithm>
 #include "db/query.h"
 #include "db/table.h"
+#include "match/gameplay.h"
+#include "match/match_events.h"
 #include "match/playoff_rules.h"
 #include "player/player_attributes.h"
 #include "player/position_types.h"
@@ -28,6 +33,9 @@ Session::Session(QWidget * const parent): _mainWindowHandle(parent), _clipboard(
                  _settings(new Settings()), _dateTime(DateTime()), _db(new Database()), _competition(Competition()) {
 
     RandomValue::seedRandomGenerator();
+
+    std::random_device randomDevice;
+    this->setSeed((static_cast<uint64_t>(randomDevice()) << 32) | randomDevice());
 }
 
 Session::~Session() {
@@ -109,6 +117,10 @@ bool Session::dropCurrentSystemDb() const {
     const QString fileName = DbSettings.SystemDb+DbSettings.FileExtension;
     dBFile systemDbFile(fileName);
 
+    // logs and snapshot of matches played in dropped session are of no use anymore
+    QFile::remove(MatchEventLog::archiveFileName);
+    QFile::remove(GamePlay::snapshotFileName);
+
     return (systemDbFile.removeFile(this->_db));
 }
 
@@ -919,6 +931,9 @@ bool Session::setGameName(QString & gameName, QString & fileName) const {
                 throw NoSuppliedValueException();
             if (!gameDbFile.removeFile(this->_db))
                 throw FileOperationFailedException();
+
+            // new game gets the same id as overwritten one (see bindMatchSnapshotToGame) => its snapshot must go as well
+            QFile::remove(GamePlay::snapshotFileName);
         }
     }
     catch (FileOperationFailedException & e) {
@@ -995,6 +1010,9 @@ bool Session::newGame() {
     // delete old data and free memory
     this->sweepOldDataAndUnusedMemory();
 
+    // snapshot of a match paused in previous game mustn't be resumed in this one
+    this->bindMatchSnapshotToGame(fileName);
+
     // select competition type (league, cup, ...)
     uint8_t competitionType = 0;
     if (!this->selectCompetitionType(competitionType))
@@ -1080,6 +1098,17 @@ bool Session::newGame() {
     return true;
 }
 
+// snapshot of a match in progress belongs to the game it has been taken in: id of the game is derived from its db file name
+// (it's persisted with the game itself) => the same id is set when the game is loaded again after application restart
+void Session::bindMatchSnapshotToGame(const QString & fileName) const {
+
+    const QByteArray hash = QCryptographicHash::hash(fileName.toUtf8(), QCryptographicHash::Sha1);
+    GamePlay::sessionId = qFromLittleEndian<quint64>(hash.constData());
+
+    return;
+}
+
+// note: once the game is loaded, bindMatchSnapshotToGame has to be called with its db file name
 bool Session::loadGame() {
 
     return true;
@@ -21,6 +21,7 @@
 #include "settings/config.h"
 #include "shared/datetime.h"
 #include "shared/random.h"
+#include "shared/random_stream.h"
 #include "match/match.h"
 #include "referee.h"
 #include "team.h"
@@ -37,6 +38,10 @@ class Session {
         inline Settings * settings() const { return _settings; }
         inline DateTime & datetime() { return _dateTime; }
 
+        // master seed from which random streams of all matches are derived (same seed => same results)
+        inline uint64_t seed() const { return RandomStream::masterSeed(); }
+        inline void setSeed(const uint64_t seed) { RandomStream::setMasterSeed(seed); return; }
+
         inline const QVector<Referee *> & referees() const { return (_referees); }
         inline const QVector<Team *> & teams() const { return (_teams); };
         inline QVector<Match *> * fixtures() { return &(_fixtures); }
@@ -61,6 +66,7 @@ class Session {
 
     private:
         void sweepOldDataAndUnusedMemory();
+        void bindMatchSnapshotToGame(const QString &) const;
 
         inline Referee * findRefereeByCode(uint16_t code) const
             { for (auto referee: _referees) if (referee->code() == code) return referee; return nullptr; }
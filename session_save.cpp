@@ -10,6 +10,7 @@
 #include <QProgressDialog>
 #include <QStringList>
 #include "db/builder.h"
+#include "match/match_events.h"
 #include "player/player_utils.h"
 #include "session.h"
 #include "shared/error.h"
@@ -100,6 +101,10 @@ bool Session::saveFixtures(QueryBuilder * const queryBuilder) {
             if (!this->_db->executeCustomQuery(queryString))
                 throw UpdateDatabaseFailedException();
 
+            // event log is stored outside of db (failure doesn't prevent the rest of fixtures from being stored)
+            if (!match->events().isEmpty() && !match->events().appendToArchive(MatchEventLog::archiveFileName, match->code()))
+                qDebug() << "Event log of match" << match->code() << "could not be stored.";
+
             ++matchNo;
             saveProgress->setValue(++noOfMatchesStored);
         }
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <QPair>
+#include <QVector>
+#include <cstdint>
+#include <random>
+
+// discrete distribution (items with arbitrary non-negative weights) sampled in constant time (Walker's alias method,
+// Vose's construction); building the table takes linear time => build it once and sample from it many times
+template<typename T>
+class AliasTable {
+
+    public:
+        AliasTable() {}
+        ~AliasTable() {}
+
+        inline bool isEmpty() const { return _items.isEmpty(); }
+        inline int size() const { return _items.size(); }
+
+        // items with zero weight are left out
+        void build(const QVector<QPair<T, double>> & weightedItems) {
+
+            _items.clear();
+            _probability.clear();
+            _alias.clear();
+
+            double sumOfWeights = 0.0;
+            for (const auto & item: weightedItems)
+                if (item.second > 0.0) {
+
+                    _items.append(item.first);
+                    _probability.append(item.second);
+                    sumOfWeights += item.second;
+                }
+
+            const int n = _items.size();
+            _alias.fill(0, n);
+
+            // scale weights so that average column has probability 1 and split columns into small and large ones
+            QVector<int> small, large;
+            for (int i = 0; i < n; ++i) {
+
+                _probability[i] *= n / sumOfWeights;
+                if (_probability[i] < 1.0)
+                    small.append(i);
+                else
+                    large.append(i);
+            }
+
+            // every small column is topped up by (and aliased to) one large column
+            while (!small.isEmpty() && !large.isEmpty()) {
+
+                const int less = small.takeLast();
+                const int more = large.last();
+
+                _alias[less] = more;
+                _probability[more] -= (1.0 - _probability[less]);
+
+                if (_probability[more] < 1.0)
+                    small.append(large.takeLast());
+            }
+
+            // remaining columns are full (up to rounding errors)
+            for (const int i: small)
+                _probability[i] = 1.0;
+            for (const int i: large)
+                _probability[i] = 1.0;
+
+            return;
+        }
+
+        // table must not be empty
+        template<typename Generator>
+        T sample(Generator & generator) const {
+
+            std::uniform_int_distribution<int> column(0, _items.size()-1);
+            std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+            const int i = column(generator);
+            return ((coin(generator) < _probability.at(i)) ? _items.at(i) : _items.at(_alias.at(i)));
+        }
+
+    private:
+        QVector<T> _items;
+        QVector<double> _probability;
+        QVector<int> _alias;
+};
+
+#endif // ALIAS_TABLE_H
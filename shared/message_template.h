@@ -0,0 +1,42 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef MESSAGE_TEMPLATE_H
+#define MESSAGE_TEMPLATE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <cstdint>
+
+// message (see Messages) parsed into segments: literal texts and positions of inserted texts => formatting is a sequence
+// of appends (no lookup of key, no search for placeholders); every template is parsed once (on its first use) and kept
+// for the rest of the session; templates are used only in the main (GUI) thread
+class MessageTemplate {
+
+    public:
+        static constexpr uint8_t maxInsertedTexts = 9;
+
+        MessageTemplate(): _literalLength(0) {}
+
+        static const MessageTemplate & find(const QString & group, const QString & key);
+
+        void appendTo(QString & buffer, const QStringList & insertedTexts = QStringList()) const;
+        QString format(const QStringList & insertedTexts = QStringList()) const;
+
+    private:
+        struct Segment {
+
+            QString text;           // literal text (if insertedText < 0)
+            int8_t insertedText;    // index into inserted texts
+        };
+
+        MessageTemplate(const QString & group, const QString & key);
+
+        QVector<Segment> _segments;
+        int _literalLength;
+};
+
+#endif // MESSAGE_TEMPLATE_H
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// seedable pseudo-random number generator (xoshiro256**) with the same interface as RandomValue;
+// every match owns its own stream derived from session's master seed and match's code => the same master seed
+// gives the same results (match can be replayed) and matches played in parallel don't share any generator state
+class RandomStream {
+
+    public:
+        typedef uint64_t result_type;
+
+        RandomStream() = delete;
+        explicit RandomStream(const uint64_t seed) { this->seed(seed); }
+        ~RandomStream() {}
+
+        // stream of a given match (or other process step identified by a code)
+        static inline RandomStream forCode(const uint64_t code) { return RandomStream(masterSeed() ^ mix(code)); }
+        // stream used for preparation of a match (draw of referee, selection of squads) => apart from match's own stream
+        static inline RandomStream forPreparationOf(const uint32_t code) { return forCode(preparationCodeOffset | code); }
+
+        static inline uint64_t & masterSeed() { static uint64_t seed = 0; return seed; }
+        static inline void setMasterSeed(const uint64_t seed) { masterSeed() = seed; return; }
+
+        inline void seed(uint64_t seed) {
+
+            for (uint8_t i = 0; i < 4; ++i)
+                _state[i] = splitMix(seed);
+            return;
+        }
+
+        // complete state of generator (stored in snapshot of a match in progress => stream continues exactly where it was)
+        inline std::array<uint64_t, 4> state() const { return { _state[0], _state[1], _state[2], _state[3] }; }
+        inline void setState(const std::array<uint64_t, 4> & state) {
+
+            for (uint8_t i = 0; i < 4; ++i)
+                _state[i] = state[i];
+            return;
+        }
+
+        // UniformRandomBitGenerator => can be used with distributions from <random>
+        static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        inline result_type operator()() {
+
+            const uint64_t result = rotl(_state[1] * 5, 7) * 9;
+            const uint64_t shifted = _state[1] << 17;
+
+            _state[2] ^= _state[0];
+            _state[3] ^= _state[1];
+            _state[1] ^= _state[2];
+            _state[0] ^= _state[3];
+            _state[2] ^= shifted;
+            _state[3] = rotl(_state[3], 45);
+
+            return result;
+        }
+
+        // closed interval <from, to>
+        template<typename T>
+        T generateRandomInt(const T from, const T to) {
+
+            std::uniform_int_distribution<int64_t> distribution(static_cast<int64_t>(from), static_cast<int64_t>(to));
+            return static_cast<T>(distribution(*this));
+        }
+
+        // true with probability of percentage %
+        inline bool generateRandomBool(const uint8_t percentage) { return (this->generateRandomInt<uint8_t>(1, 100) <= percentage); }
+
+        // n numbers from closed interval <1, 100> at once (to be compared with percentages, see generateRandomBool);
+        // upper 32 bits are scaled by multiplication (bias is below 100 / 2^32)
+        inline void generateRandomPercentages(uint8_t * const values, const uint8_t n) {
+
+            for (uint8_t i = 0; i < n; ++i)
+                values[i] = static_cast<uint8_t>((((*this)() >> 32) * 100) >> 32) + 1;
+            return;
+        }
+
+    private:
+        static constexpr uint64_t preparationCodeOffset = static_cast<uint64_t>(1) << 32;
+
+        static inline uint64_t rotl(const uint64_t value, const uint8_t bits) { return ((value << bits) | (value >> (64 - bits))); }
+
+        static inline uint64_t splitMix(uint64_t & value) {
+
+            uint64_t z = (value += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return (z ^ (z >> 31));
+        }
+        static inline uint64_t mix(uint64_t value) { return splitMix(value); }
+
+        uint64_t _state[4];
+};
+
+#endif // RANDOM_STREAM_H
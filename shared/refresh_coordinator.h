@@ -0,0 +1,46 @@
+/*******************************************************************************
+ Copyright 2023 Daniel Neuwirth
+ This program is distributed under the terms of the GNU General Public License.
+*******************************************************************************/
+
+#ifndef REFRESH_COORDINATOR_H
+#define REFRESH_COORDINATOR_H
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QTextEdit>
+#include <QTimer>
+#include <cstdint>
+#include <functional>
+
+// changes of widgets which are updated after (almost) every game action are not applied immediately; they are collected
+// and applied together at most framesPerSecond times per second (only the latest change of each widget is applied,
+// lines added to a log within one frame are appended at once) => widgets aren't painted more often than necessary
+class RefreshCoordinator: public QObject {
+
+    Q_OBJECT
+
+    public:
+        static constexpr uint8_t defaultFramesPerSecond = 30;
+
+        explicit RefreshCoordinator(QObject * const, const uint8_t = defaultFramesPerSecond);
+        ~RefreshCoordinator() {}
+
+        // target = widget (or any other object) which is changed by update (previous pending update of target is dropped)
+        void schedule(const void * const, const std::function<void()> &);
+        void append(QTextEdit * const, const QString &);
+
+    public slots:
+        // applies all pending changes right now (e.g. before a modal dialog is shown)
+        void flush();
+
+    private:
+        void startFrame();
+
+        QTimer * _frameTimer;
+        QHash<const void *, std::function<void()>> _updates;
+        QHash<QTextEdit *, QStringList> _lines;
+};
+
+#endif // REFRESH_COORDINATOR_H
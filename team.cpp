@@ -4,15 +4,24 @@
 *******************************************************************************/
 
 #include <algorithm>
+#include <cmath>
 #include "settings/matchsettings.h"
 #include "team.h"
 
 void TeamPoints::updateFromMatchScore(MatchScore * const score, const uint16_t pointsAgainst, const uint8_t triesAgainst) {
 
-    this->_tries += score->points(PointEvent::TRY);
-    this->_conversions += score->points(PointEvent::CONVERSION);
-    this->_penalties += score->points(PointEvent::PENALTY);
-    this->_dropgoals += score->points(PointEvent::DROPGOAL);
+    this->addScore(score->points(PointEvent::TRY), score->points(PointEvent::CONVERSION), score->points(PointEvent::PENALTY),
+                   score->points(PointEvent::DROPGOAL), pointsAgainst, triesAgainst);
+    return;
+}
+
+void TeamPoints::addScore(const uint8_t tries, const uint8_t conversions, const uint8_t penalties, const uint8_t dropgoals,
+                          const uint16_t pointsAgainst, const uint8_t triesAgainst) {
+
+    this->_tries += tries;
+    this->_conversions += conversions;
+    this->_penalties += penalties;
+    this->_dropgoals += dropgoals;
 
     this->_pointsAgainst += pointsAgainst;
     this->_triesAgainst += triesAgainst;
@@ -63,21 +72,227 @@ uint16_t TeamResults::pointsTotal() const {
 Team::Team(const uint16_t code, const QString & name, const QString & abbr, const QString & nick,
            const QString & country, const QString & city, const QString & venue, const TeamType type,
            const QString & manager, const uint8_t ranking, const QString & group, const QString & colour):
-    _scoredPoints(TeamPoints()), _results(TeamResults()), _inPlayoffs(false), _code(code), _name(name), _abbr(abbr),
+    _scoredPoints(TeamPoints()), _results(TeamResults()), _inPlayoffs(false),
+    _receiversValid(false), _code(code), _name(name), _abbr(abbr),
     _nick(nick), _country(country), _city(city), _venue(venue), _type(type), _manager(manager), _ranking(ranking),
-    _group(group), _colour(colour) {}
+    _group(group), _colour(colour) {
+
+    this->lineupChanged();
+}
+
+void Team::lineupChanged() {
+
+    this->_receiversValid = false;
+
+    const uint8_t noOfPositionTypes = static_cast<uint8_t>(PlayerPosition_index_item::PositionType::FULLBACK) + 1;
+
+    this->_onPitch = OnPitchIndex();
+    this->_onPitch.playersByPositionType.resize(noOfPositionTypes);
+
+    uint8_t playerWeight = 0;
+    for (auto player: this->_squad) {
+
+        if (player->isOnPitch()) {
+
+            this->_onPitch.players.append(player);
+            this->_onPitch.playersByPositionType[static_cast<uint8_t>(player->position()->positionType())].append(player);
+        }
+
+        if (!player->isPackPlayer())
+            continue;
+
+        ++(this->_onPitch.noOfPackPlayers);
+
+        if ((playerWeight = player->attribute(player::Attributes::WEIGHT)) > 0) {
+
+            ++(this->_onPitch.noOfPackPlayersWithWeight);
+            this->_onPitch.packWeight += playerWeight;
+        }
+    }
+
+    return;
+}
+
+// playedInMatch: true if player has already played in current match (and has been replaced since)
+void Team::buildBench(const std::function<bool(Player * const)> & playedInMatch) {
+
+    this->_bench.clear();
+
+    for (auto player: this->_squad) {
+
+        if (player->isOnBench() && player->isHealthy()) {
+
+            BenchIndex & index = this->_bench[Team::benchKey(player)];
+            Team::insertIntoBench((playedInMatch(player)) ? index.replaced : index.fresh, player);
+        }
+    }
+
+    return;
+}
+
+// player is inserted in front of players with equal condition => of these the one inserted first (the first one in
+// squad when index is built) is taken first
+void Team::insertIntoBench(QVector<Player *> & players, Player * const player) {
+
+    const auto position = std::lower_bound(players.begin(), players.end(), player, [](Player * const first, Player * const second) -> bool
+        { return first->condition(player::Conditions::OVERALL) < second->condition(player::Conditions::OVERALL); });
+    players.insert(position, player);
+
+    return;
+}
+
+// player going in leaves the index (in background substitutions he's the best one <=> the last one in his list); player
+// going out enters it if he can still be used (to replace an injured player)
+void Team::benchSubstitution(Player * const playerIn, Player * const playerOut) {
+
+    BenchIndex & index = this->_bench[Team::benchKey(playerIn)];
+
+    if (!index.fresh.isEmpty() && index.fresh.constLast() == playerIn)
+        index.fresh.removeLast();
+    else if (!index.fresh.removeOne(playerIn))
+        index.replaced.removeOne(playerIn);
+
+    if (playerOut->isOnBench() && playerOut->isHealthy())
+        Team::insertIntoBench(this->_bench[Team::benchKey(playerOut)].replaced, playerOut);
+
+    return;
+}
+
+// return value: nullptr if there's no suitable player on bench
+Player * Team::bestSubstitute(const PlayerPosition_index_item::PositionBaseType baseType, const bool injuryReplacement) const {
+
+    const auto it = this->_bench.constFind(static_cast<uint8_t>(baseType));
+    if (it == this->_bench.cend())
+        return nullptr;
+
+    Player * const fresh = (it->fresh.isEmpty()) ? nullptr : it->fresh.constLast();
+    if (!injuryReplacement || it->replaced.isEmpty())
+        return fresh;
+
+    Player * const replaced = it->replaced.constLast();
+    return (fresh == nullptr || replaced->condition(player::Conditions::OVERALL) > fresh->condition(player::Conditions::OVERALL))
+           ? replaced : fresh;
+}
+
+// all suitable players (for manager's selection)
+QVector<Player *> Team::substitutes(const PlayerPosition_index_item::PositionBaseType baseType, const bool injuryReplacement) const {
+
+    const auto it = this->_bench.constFind(static_cast<uint8_t>(baseType));
+    if (it == this->_bench.cend())
+        return QVector<Player *>();
+
+    return (injuryReplacement) ? it->fresh + it->replaced : it->fresh;
+}
+
+bool Team::isSubstitute(Player * const player, const PlayerPosition_index_item::PositionBaseType baseType,
+                        const bool injuryReplacement) const {
+
+    const auto it = this->_bench.constFind(static_cast<uint8_t>(baseType));
+
+    return (it != this->_bench.cend() && (it->fresh.contains(player) || (injuryReplacement && it->replaced.contains(player))));
+}
+
+Team * Team::clone() const {
+
+    Team * const team = new Team(*this);
+
+    for (auto & player: team->_squad)
+        player = player->clone();
+
+    // on-pitch index, tables and bench index refer to original players (on-pitch index is rebuilt by lineupChanged,
+    // bench index is built again when match is restored)
+    team->_bench.clear();
+    team->_receiversByCarrier.clear();
+    team->_receiversByCarrierPositionType.clear();
+    team->lineupChanged();
+
+    return team;
+}
 
 uint8_t Team::availablePlayers(const PlayerPosition_index_item::PositionType positionType,
                                Player * const playerInPossession, QVector<Player *> & availablePlayers) {
 
-    for (auto player: this->squad()) {
+    for (auto player: this->onPitch().playersByPositionType.at(static_cast<uint8_t>(positionType))) {
 
-        if (player->position()->positionType() == positionType && player->isOnPitch() && player != playerInPossession)
+        if (player != playerInPossession)
             availablePlayers.push_back(player);
     }
     return availablePlayers.size();
 }
 
+// every position type has certain probability of taking over the ball
+// note: these probabilities depend on current player's (ball carrier's) position type
+double Team::receiverWeight(const PlayerPosition_index_item::PositionType carrierType,
+                            const PlayerPosition_index_item::PositionType receiverType) {
+
+    return std::max(0, 7 - std::abs(static_cast<int8_t>(receiverType) - static_cast<int8_t>(carrierType)));
+}
+
+// position type is drawn first (by its weight) and then one of its players (uniformly); position types without
+// any player on pitch are skipped => weight of each player = weight of his position type / number of its players
+void Team::buildReceiverTables() {
+
+    const uint8_t noOfPositionTypes = static_cast<uint8_t>(PlayerPosition_index_item::PositionType::FULLBACK) + 1;
+
+    const QVector<Player *> & playersOnPitch = this->onPitch().players;
+
+    auto buildTable = [&playersOnPitch, noOfPositionTypes](AliasTable<Player *> & table,
+                      const PlayerPosition_index_item::PositionType carrierType, Player * const carrier) {
+
+        QVector<uint8_t> playersOfType(noOfPositionTypes, 0);
+        for (auto player: playersOnPitch)
+            if (player != carrier)
+                ++playersOfType[static_cast<uint8_t>(player->position()->positionType())];
+
+        QVector<QPair<Player *, double>> weightedPlayers;
+        for (auto player: playersOnPitch) {
+
+            const PlayerPosition_index_item::PositionType type = player->position()->positionType();
+            if (player != carrier)
+                weightedPlayers.append({ player, Team::receiverWeight(carrierType, type) / playersOfType.at(static_cast<uint8_t>(type)) });
+        }
+
+        table.build(weightedPlayers);
+        return;
+    };
+
+    this->_receiversByCarrier.clear();
+    for (auto player: playersOnPitch)
+        buildTable(this->_receiversByCarrier[player], player->position()->positionType(), player);
+
+    this->_receiversByCarrierPositionType.resize(noOfPositionTypes);
+    for (uint8_t i = 0; i < noOfPositionTypes; ++i)
+        buildTable(this->_receiversByCarrierPositionType[i], static_cast<PlayerPosition_index_item::PositionType>(i), nullptr);
+
+    this->_receiversValid = true;
+    return;
+}
+
+// return value: nullptr if there's nobody on pitch (except for the ball carrier)
+Player * Team::drawReceiver(Player * const carrier, RandomStream & random) {
+
+    if (!this->_receiversValid)
+        this->buildReceiverTables();
+
+    const AliasTable<Player *> & table = (this->_receiversByCarrier.contains(carrier))
+        ? this->_receiversByCarrier[carrier]
+        : this->_receiversByCarrierPositionType.at(static_cast<uint8_t>(carrier->position()->positionType()));
+
+    if (table.isEmpty())
+        return nullptr;
+
+    Player * const receiver = table.sample(random);
+
+    // lineup has changed without being reported => tables are rebuilt and receiver is drawn again
+    if (!receiver->isOnPitch()) {
+
+        this->lineupChanged();
+        return this->drawReceiver(carrier, random);
+    }
+
+    return receiver;
+}
+
 bool Team::areAllPlayersSelected() const {
 
     uint16_t teamSquadCheckSum = 0;
@@ -91,7 +306,13 @@ bool Team::areAllPlayersSelected() const {
     return (teamSquadCheckSum == fullSquadCheckSum());
 }
 
-bool Team::selectPlayersForNextMatch(const ConditionWeights & conditionSettings) {
+// random == nullptr => shared generator (RandomValue) is used; selection running outside of main thread must pass its own stream
+bool Team::selectPlayersForNextMatch(const ConditionWeights & conditionSettings, RandomStream * const random) {
+
+    auto randomBool = [random](const uint8_t percentage) -> bool {
+
+        return (random != nullptr) ? random->generateRandomBool(percentage) : RandomValue::generateRandomBool(percentage);
+    };
 
     // clear previous selection
     for (auto player: _squad) {
@@ -99,6 +320,7 @@ bool Team::selectPlayersForNextMatch(const ConditionWeights & conditionSettings)
         player->assignShirtNo(0);
         player->resetAllPreferences();
     }
+    this->lineupChanged();
 
     // go through all (specific) positions [1-15]
     for (auto position: playerPosition_index.findPlayerPositionsByType(PlayerPosition_index_item::PositionBaseType::UNKNOWN)) {
@@ -183,14 +405,14 @@ bool Team::selectPlayersForNextMatch(const ConditionWeights & conditionSettings)
         // decrease condition(s) if player is "less-suitable" (only when selected for this position for the first time)
         if (bestPlayerMatchType == player::MatchTypes::DIFFERENT_POSITION && position != bestPlayer->position()->playerPosition()) {
 
-            const bool probability = RandomValue::generateRandomBool(25);
+            const bool probability = randomBool(25);
             bestPlayer->condition()->decreaseCondition(player::Conditions::FORM, static_cast<uint8_t>(probability));
         }
         if (bestPlayerMatchType == player::MatchTypes::UNRELATED_POSITION && position != bestPlayer->position()->playerPosition()) {
 
-            bool probability = RandomValue::generateRandomBool(50);
+            bool probability = randomBool(50);
             bestPlayer->condition()->decreaseCondition(player::Conditions::FORM, static_cast<uint8_t>(probability));
-            probability = RandomValue::generateRandomBool(25);
+            probability = randomBool(25);
             bestPlayer->condition()->decreaseCondition(player::Conditions::MORALE, static_cast<uint8_t>(probability));
         }
 
@@ -263,13 +485,14 @@ void Team::cleanPitch() {
 
     for (auto player: _squad)
         player->withdrawPlayer();
+    this->lineupChanged();
 
     return;
 }
 
 uint8_t Team::numberOfPlayersOnPitch() const {
 
-    return std::count_if(this->squad().cbegin(), this->squad().cend(), [](Player * const player) { return player->isOnPitch(); });
+    return this->onPitch().players.size();
 }
 
 uint16_t Team::packWeight(bool * adjusted) const {
@@ -277,25 +500,9 @@ uint16_t Team::packWeight(bool * adjusted) const {
     if (adjusted != nullptr)
         *(adjusted) = false;
 
-    uint16_t packWeight = 0;
-    uint8_t playerWeight = 0;
-
-    uint8_t noOfPlayersWithWeight = 0;
-    uint8_t numberOfPackPlayersOnPitch = 0; // == numberOfPlayers.NoOfForwards if no one is suspended/injured
-
-    for (auto player: this->_squad) {
-
-        if (!player->isPackPlayer())
-            continue;
-
-        ++numberOfPackPlayersOnPitch;
-
-        if ((playerWeight = player->attribute(player::Attributes::WEIGHT)) > 0) {
-
-            ++noOfPlayersWithWeight;
-            packWeight += playerWeight;
-        }
-    }
+    const uint16_t packWeight = this->onPitch().packWeight;
+    const uint8_t noOfPlayersWithWeight = this->onPitch().noOfPackPlayersWithWeight;
+    const uint8_t numberOfPackPlayersOnPitch = this->onPitch().noOfPackPlayers; // == NoOfForwards if no one is suspended/injured
 
     if (/*noOfPlayersWithWeight == numberOfPlayers.NoOfForwards ||*/ noOfPlayersWithWeight == numberOfPackPlayersOnPitch)
         return packWeight;
@@ -6,11 +6,15 @@
 #ifndef TEAM_H
 #define TEAM_H
 
+#include <QHash>
 #include <QString>
 #include <QVector>
 #include <cstdint>
+#include <functional>
 #include "match/matchscore.h"
 #include "player/player.h"
+#include "shared/alias_table.h"
+#include "shared/random_stream.h"
 
 class TeamPoints {
 
@@ -34,6 +38,7 @@ class TeamPoints {
             { return (static_cast<int16_t>(this->tries()) - static_cast<int16_t>(this->_triesAgainst)); }
 
         void updateFromMatchScore(MatchScore * const, const uint16_t, const uint8_t);
+        void addScore(const uint8_t, const uint8_t, const uint8_t, const uint8_t, const uint16_t, const uint8_t);
 
     private:
         uint16_t _pointsAgainst = 0;
@@ -90,14 +95,31 @@ class Team {
              const QString &, const TeamType, const QString &, const uint8_t, const QString &, const QString &);
         ~Team() {}
 
+        // deep copy including players (players aren't owned by team => they must be released by caller)
+        Team * clone() const;
+
         inline TeamPoints & scoredPoints() { return _scoredPoints; }
         inline TeamResults & results() { return _results; }
         inline bool inPlayoffs() const { return _inPlayoffs; }
 
         inline QVector<Player *> squad() const { return _squad; }
         inline QVector<Player *> & squad() { return _squad; }
+        inline const QVector<Player *> & playersOnPitch() const { return onPitch().players; }
         uint8_t availablePlayers(const PlayerPosition_index_item::PositionType, Player * const, QVector<Player *> &);
 
+        // player who takes over the ball from given player (ball carrier) is drawn from precomputed tables;
+        // tables are rebuilt only after on-pitch lineup has changed (which must be reported by lineupChanged)
+        Player * drawReceiver(Player * const, RandomStream &);
+        void lineupChanged();
+
+        // substitutes (healthy players on bench) by position base type; index is built at start of match (or after its
+        // state has been restored) and then kept up to date with every substitution (see BenchIndex)
+        void buildBench(const std::function<bool(Player * const)> &);
+        void benchSubstitution(Player * const, Player * const);
+        Player * bestSubstitute(const PlayerPosition_index_item::PositionBaseType, const bool) const;
+        QVector<Player *> substitutes(const PlayerPosition_index_item::PositionBaseType, const bool) const;
+        bool isSubstitute(Player * const, const PlayerPosition_index_item::PositionBaseType, const bool) const;
+
         QString teamName(Player * const player) const
             { return (this->type() == Team::TeamType::CLUB) ? player->club() : player->country(); }
 
@@ -116,7 +138,7 @@ class Team {
         inline void addPlayer(Player * const player) { _squad.push_back(player); return; }
 
         bool areAllPlayersSelected() const;
-        bool selectPlayersForNextMatch(const ConditionWeights &);
+        bool selectPlayersForNextMatch(const ConditionWeights &, RandomStream * const = nullptr);
         bool selectSubstitutes(const ConditionWeights &);
 
         void cleanPitch();
@@ -125,12 +147,54 @@ class Team {
         uint16_t packWeight(bool * = nullptr) const;
 
     private:
+        // players on pitch (indexed by position type) and aggregated values of the pack; the index is rebuilt right away
+        // by lineupChanged (not on first query) => const queries only read it and don't have to scan the whole squad
+        struct OnPitchIndex {
+
+            QVector<Player *> players;
+            QVector<QVector<Player *>> playersByPositionType; // index = position type
+            uint8_t noOfPackPlayers = 0;
+            uint8_t noOfPackPlayersWithWeight = 0;
+            uint16_t packWeight = 0;                         // sum of known weights
+        };
+
+        inline const OnPitchIndex & onPitch() const { return _onPitch; }
+
         TeamPoints _scoredPoints;
         TeamResults _results;
         bool _inPlayoffs;
 
         QVector<Player *> _squad;
 
+        OnPitchIndex _onPitch;
+
+        // candidates for substitution of one position base type: players who haven't played in current match yet and
+        // players who have been replaced already (these may only replace an injured player); both lists are ordered by
+        // overall condition with the best player as the last one => he's taken (and removed) in constant time
+        struct BenchIndex {
+
+            QVector<Player *> fresh;
+            QVector<Player *> replaced;
+        };
+
+        static void insertIntoBench(QVector<Player *> &, Player * const);
+        static inline uint8_t benchKey(Player * const player) {
+
+            return static_cast<uint8_t>(playerPosition_index.findPositionBaseTypeByType(player->position()->positionType()));
+        }
+
+        QHash<uint8_t, BenchIndex> _bench; // key = position base type
+
+        void buildReceiverTables();
+        static double receiverWeight(const PlayerPosition_index_item::PositionType, const PlayerPosition_index_item::PositionType);
+
+        // receivers' tables are still built lazily (by drawReceiver) => a team and its players must not be shared by
+        // threads: matches played concurrently (matchday, calibration, rollouts) always work with different teams
+        // or with clones of them, and a team is handed over to another thread only after its match has finished
+        QHash<Player *, AliasTable<Player *>> _receiversByCarrier;    // carrier is on pitch (in this team)
+        QVector<AliasTable<Player *>> _receiversByCarrierPositionType; // carrier is not in this team (index = position type)
+        bool _receiversValid;
+
         uint16_t _code;
         QString _name;
         QString _abbr;